@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "../src/infra/codecs/include/bmp.hpp"
+#include "../src/domain/graphics2d/include/image_view.hpp"
+#include "../src/domain/graphics2d/include/pixel.hpp"
+#include "../src/domain/graphics2d/include/pixel_format.hpp"
+
+using namespace kaf;
+
+namespace {
+  namespace fs = std::filesystem;
+  using domain::graphics2d::BGRA8;
+  using domain::graphics2d::Pixel;
+
+  // 読み込み用に書き出した BMP（プロセス終了時に削除する）
+  class SourceFiles {
+  public:
+    ~SourceFiles() {
+      for (const auto& entry : files_) {
+        std::error_code error;
+        fs::remove(entry.second, error);
+      }
+    }
+
+    const fs::path* get(int64_t width, int64_t height, int64_t bpp) {
+      const auto key = std::make_tuple(width, height, bpp);
+      auto found = files_.find(key);
+      if (found != files_.end()) {
+        return &found->second;
+      }
+      infra::codecs::BasicBMP<BGRA8> bmp(static_cast<size_t>(width), static_cast<size_t>(height));
+      domain::graphics2d::forEachPixel(bmp, [](BGRA8& pixel, size_t x, size_t y) {
+        pixel = BGRA8{static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(x ^ y), 0xFF};
+      });
+      const fs::path path = fs::temp_directory_path() /
+        ("kaf_bench_" + std::to_string(width) + "x" + std::to_string(height) + "_" + std::to_string(bpp) + ".bmp");
+      std::error_code error;
+      fs::remove(path, error);
+      if (!bmp.saveImage(path.string(), static_cast<size_t>(bpp))) {
+        return nullptr;
+      }
+      return &files_.emplace(key, path).first->second;
+    }
+
+  private:
+    std::map<std::tuple<int64_t, int64_t, int64_t>, fs::path> files_;
+  };
+
+  SourceFiles& sourceFiles() {
+    static SourceFiles files;
+    return files;
+  }
+
+  void setCodecCounters(benchmark::State& state, int64_t width, int64_t height, uintmax_t fileSize) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileSize));
+    state.counters["MP/s"] = benchmark::Counter(static_cast<double>(width * height) / 1e6,
+      benchmark::Counter::kIsIterationInvariantRate);
+  }
+
+  // range: 幅, 高さ, bpp, スレッド数（1 は逐次、0 はハードウェアスレッド数）
+  template <class P>
+  void BM_LoadBmp(benchmark::State& state) {
+    const int64_t width = state.range(0), height = state.range(1);
+    const fs::path* path = sourceFiles().get(width, height, state.range(2));
+    if (path == nullptr) {
+      state.SkipWithError("failed to write the source bitmap");
+      return;
+    }
+    infra::codecs::CodecOptions options;
+    options.threadCount_ = static_cast<size_t>(state.range(3));
+    for (auto _ : state) {
+      infra::codecs::BasicBMP<P> bmp;
+      if (!bmp.loadImage(path->string(), options)) {
+        state.SkipWithError("loadImage failed");
+        break;
+      }
+      benchmark::DoNotOptimize(bmp.getPixelBuffer());
+    }
+    setCodecCounters(state, width, height, fs::file_size(*path));
+  }
+
+  template <class P>
+  void BM_SaveBmp(benchmark::State& state) {
+    const int64_t width = state.range(0), height = state.range(1);
+    const size_t bpp = static_cast<size_t>(state.range(2));
+    infra::codecs::BasicBMP<P> bmp(static_cast<size_t>(width), static_cast<size_t>(height));
+    const fs::path path = fs::temp_directory_path() / "kaf_bench_save.bmp";
+    infra::codecs::CodecOptions options;
+    options.threadCount_ = static_cast<size_t>(state.range(3));
+    std::error_code error;
+    fs::remove(path, error);
+    uintmax_t fileSize = 0;
+    for (auto _ : state) {
+      if (!bmp.saveImage(path.string(), bpp, options)) {
+        state.SkipWithError("saveImage failed");
+        break;
+      }
+      // saveImage は既存のファイルを上書きしないため、次の計測の前に消しておく
+      state.PauseTiming();
+      fileSize = fs::file_size(path, error);
+      fs::remove(path, error);
+      state.ResumeTiming();
+    }
+    setCodecCounters(state, width, height, fileSize);
+  }
+
+  // サムネイルから 100 MP まで。float の Pixel は 100 MP で 1.6 GB になるため 24 MP までにする
+  void codecSizes(benchmark::internal::Benchmark* bench, bool hundredMegapixels) {
+    bench->ArgNames({"width", "height", "bpp", "threads"});
+    for (int64_t bpp : {24, 32}) {
+      for (int64_t threads : {1, 0}) {
+        bench->Args({160, 120, bpp, threads});
+        bench->Args({1920, 1080, bpp, threads});
+        bench->Args({6000, 4000, bpp, threads});
+        if (hundredMegapixels) {
+          bench->Args({10000, 10000, bpp, threads});
+        }
+      }
+    }
+    bench->Unit(benchmark::kMillisecond)->UseRealTime();
+  }
+
+  void pixelSizes(benchmark::internal::Benchmark* bench) { codecSizes(bench, false); }
+  void byteSizes(benchmark::internal::Benchmark* bench) { codecSizes(bench, true); }
+}
+
+BENCHMARK_TEMPLATE(BM_LoadBmp, Pixel)->Apply(pixelSizes);
+BENCHMARK_TEMPLATE(BM_LoadBmp, BGRA8)->Apply(byteSizes);
+BENCHMARK_TEMPLATE(BM_SaveBmp, Pixel)->Apply(pixelSizes);
+BENCHMARK_TEMPLATE(BM_SaveBmp, BGRA8)->Apply(byteSizes);
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "../src/infra/application/include/event_bus.hpp"
+
+using namespace kaf::infra::application;
+
+namespace {
+  struct Tick {
+    std::int64_t value_;
+  };
+
+  std::atomic<std::int64_t> received{0};
+
+  // 同じバスへ複数スレッドから publish して競合時の性能を測るため、バスはプロセスで 1 つずつ持つ
+  EventBus& syncBus() {
+    static EventBus bus;
+    static const bool subscribed = (bus.subscribe<Tick>([](const Tick& tick) {
+      received.fetch_add(tick.value_, std::memory_order_relaxed);
+    }), true);
+    (void)subscribed;
+    return bus;
+  }
+
+  EventBus& asyncBus() {
+    static EventBus bus(AsyncDispatchOptions{});
+    static const bool subscribed = (bus.subscribe<Tick>([](const Tick& tick) {
+      received.fetch_add(tick.value_, std::memory_order_relaxed);
+    }), true);
+    (void)subscribed;
+    return bus;
+  }
+
+  void BM_EventBusPublishSync(benchmark::State& state) {
+    EventBus& bus = syncBus();
+    for (auto _ : state) {
+      bus.publish(Tick{1});
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // キューが満杯なら publish 側が待つ（Block）ので、配信スレッドの処理量も含めた持続的な値になる
+  void BM_EventBusPublishAsync(benchmark::State& state) {
+    EventBus& bus = asyncBus();
+    for (auto _ : state) {
+      bus.publish(Tick{1});
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+      bus.flush();
+    }
+  }
+
+  void publisherThreads(benchmark::internal::Benchmark* bench) {
+    const int hardware = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    bench->ThreadRange(1, hardware)->UseRealTime();
+  }
+}
+
+BENCHMARK(BM_EventBusPublishSync)->Apply(publisherThreads);
+BENCHMARK(BM_EventBusPublishAsync)->Apply(publisherThreads);
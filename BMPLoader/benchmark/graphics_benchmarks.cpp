@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "../src/domain/common/include/thread_pool.hpp"
+#include "../src/domain/graphics2d/include/composite.hpp"
+#include "../src/domain/graphics2d/include/convolution.hpp"
+#include "../src/domain/graphics2d/include/image.hpp"
+#include "../src/domain/graphics2d/include/image_view.hpp"
+#include "../src/domain/graphics2d/include/parallel.hpp"
+#include "../src/domain/graphics2d/include/pixel.hpp"
+#include "../src/domain/graphics2d/include/resize.hpp"
+
+using namespace kaf;
+
+namespace {
+  using domain::common::ThreadPool;
+  using domain::graphics2d::BlendMode;
+  using domain::graphics2d::Image;
+  using domain::graphics2d::Pixel;
+  using domain::graphics2d::ResizeFilter;
+
+  void setMegapixelRate(benchmark::State& state, int64_t pixels) {
+    state.counters["MP/s"] = benchmark::Counter(static_cast<double>(pixels) / 1e6,
+      benchmark::Counter::kIsIterationInvariantRate);
+  }
+
+  // range(0): 並列度（ワーカー数 + 呼び出し元）。1 からハードウェアスレッド数まで
+  void BM_ThreadPoolScaling(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0) - 1));
+    Image image(2048, 2048, Pixel(0.5f, 0.25f, 0.125f));
+    for (auto _ : state) {
+      domain::graphics2d::parallelForRows(image, [](auto row, size_t) {
+        for (Pixel& pixel : row) {
+          pixel.r_ = std::sqrt(pixel.r_);
+          pixel.g_ = std::sqrt(pixel.g_);
+          pixel.b_ = std::sqrt(pixel.b_);
+        }
+      }, pool);
+      benchmark::ClobberMemory();
+    }
+    setMegapixelRate(state, 2048 * 2048);
+  }
+
+  void concurrencyLevels(benchmark::internal::Benchmark* bench) {
+    const int64_t hardware = std::max<int64_t>(1, std::thread::hardware_concurrency());
+    bench->ArgName("threads")->DenseRange(1, hardware)->Unit(benchmark::kMillisecond)->UseRealTime();
+  }
+
+  // range: 入力の幅, 高さ, 出力の幅, 高さ, ResizeFilter
+  void BM_Resize(benchmark::State& state) {
+    const Image source(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)), Pixel(0.5f, 0.25f, 0.125f));
+    const size_t width = static_cast<size_t>(state.range(2));
+    const size_t height = static_cast<size_t>(state.range(3));
+    const auto filter = static_cast<ResizeFilter>(state.range(4));
+    state.SetLabel(domain::graphics2d::toString(filter));
+    for (auto _ : state) {
+      auto resized = domain::graphics2d::resizeImage(source, width, height, filter);
+      if (resized == nullptr) {
+        state.SkipWithError("resizeImage failed");
+        break;
+      }
+      benchmark::DoNotOptimize(resized->getPixelBuffer());
+    }
+    setMegapixelRate(state, static_cast<int64_t>(width * height));
+  }
+
+  void resizeCases(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"src_w", "src_h", "dst_w", "dst_h", "filter"});
+    for (ResizeFilter filter : {ResizeFilter::Nearest, ResizeFilter::Bilinear, ResizeFilter::Bicubic, ResizeFilter::Lanczos3}) {
+      bench->Args({3840, 2160, 1920, 1080, static_cast<int64_t>(filter)});
+      bench->Args({1920, 1080, 3840, 2160, static_cast<int64_t>(filter)});
+    }
+    bench->Unit(benchmark::kMillisecond)->UseRealTime();
+  }
+
+  // 1920x1080 のボックスぼかし。range(0) は半径。移動和なので MP/s は半径によらずほぼ一定になる
+  void BM_BoxBlur(benchmark::State& state) {
+    Image source(1920, 1080, Pixel(0.f, 0.f, 0.f));
+    domain::graphics2d::forEachPixel(source, [](Pixel& pixel, size_t x, size_t y) {
+      pixel = Pixel(static_cast<float>(x % 256) / 255.f, static_cast<float>(y % 256) / 255.f, 0.5f);
+    });
+    const size_t radius = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+      auto blurred = domain::graphics2d::boxBlur(std::as_const(source), radius);
+      if (blurred == nullptr) {
+        state.SkipWithError("boxBlur failed");
+        break;
+      }
+      benchmark::DoNotOptimize(blurred->getPixelBuffer());
+    }
+    setMegapixelRate(state, 1920 * 1080);
+  }
+
+  void blurRadii(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("radius");
+    for (int64_t radius : {1, 10, 30, 100, 300}) {
+      bench->Arg(radius);
+    }
+    bench->Unit(benchmark::kMillisecond)->UseRealTime();
+  }
+
+  // 1920x1080 への合成。range(0) はスプライトの一辺（0 で全面）、range(1) は BlendMode
+  void BM_Composite(benchmark::State& state) {
+    Image destination(1920, 1080, Pixel(0.2f, 0.4f, 0.6f));
+    const size_t side = static_cast<size_t>(state.range(0));
+    const Image source = side == 0 ? Image(1920, 1080, Pixel(0.9f, 0.1f, 0.1f, 0.5f))
+                                   : Image(side, side, Pixel(0.9f, 0.1f, 0.1f, 0.5f));
+    const auto mode = static_cast<BlendMode>(state.range(1));
+    state.SetLabel(domain::graphics2d::toString(mode));
+    std::ptrdiff_t position = 0;
+    for (auto _ : state) {
+      // スプライトは位置をずらしながら重ねる
+      const std::ptrdiff_t x = side == 0 ? 0 : position % static_cast<std::ptrdiff_t>(1920 - side);
+      const std::ptrdiff_t y = side == 0 ? 0 : position % static_cast<std::ptrdiff_t>(1080 - side);
+      if (!domain::graphics2d::compositeImage(destination, source, x, y, mode)) {
+        state.SkipWithError("compositeImage failed");
+        break;
+      }
+      position += 37;
+    }
+    setMegapixelRate(state, static_cast<int64_t>(source.getWidth() * source.getHeight()));
+  }
+
+  void compositeCases(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"sprite", "mode"});
+    for (int64_t side : {0, 32, 128, 512}) {
+      for (BlendMode mode : {BlendMode::Over, BlendMode::Multiply}) {
+        bench->Args({side, static_cast<int64_t>(mode)});
+      }
+    }
+    bench->UseRealTime();
+  }
+}
+
+BENCHMARK(BM_ThreadPoolScaling)->Apply(concurrencyLevels);
+BENCHMARK(BM_Resize)->Apply(resizeCases);
+BENCHMARK(BM_Composite)->Apply(compositeCases);
+BENCHMARK(BM_BoxBlur)->Apply(blurRadii);
@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "../src/domain/graphics2d/include/image.hpp"
+#include "../src/domain/graphics2d/include/image_view.hpp"
+#include "../src/domain/graphics2d/include/pixel.hpp"
+#include "../src/domain/graphics2d/include/pixel_buffer.hpp"
+#include "../src/domain/graphics2d/include/pixel_buffer_pool.hpp"
+
+using namespace kaf;
+
+namespace {
+  using domain::graphics2d::Image;
+  using domain::graphics2d::Pixel;
+  using domain::graphics2d::PixelBuffer;
+
+  // range: 一辺[px]（正方形の画像）
+  void imageSides(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("side")->Arg(64)->Arg(512)->Arg(2048)->Arg(4096);
+  }
+
+  void setPixelCounters(benchmark::State& state, int64_t pixels) {
+    state.SetItemsProcessed(state.iterations() * pixels);
+    state.SetBytesProcessed(state.iterations() * pixels * static_cast<int64_t>(sizeof(Pixel)));
+  }
+
+  void BM_PixelBufferFill(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0) * state.range(0));
+    const Pixel white(1.f, 1.f, 1.f);
+    for (auto _ : state) {
+      PixelBuffer buffer(size, white);
+      benchmark::DoNotOptimize(buffer.pixels_.get());
+    }
+    setPixelCounters(state, static_cast<int64_t>(size));
+  }
+
+  void BM_PixelBufferUninitialized(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0) * state.range(0));
+    for (auto _ : state) {
+      PixelBuffer buffer(size, domain::graphics2d::UNINITIALIZED);
+      benchmark::DoNotOptimize(buffer.pixels_.get());
+    }
+    setPixelCounters(state, static_cast<int64_t>(size));
+  }
+
+  void BM_PixelBufferPooled(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0) * state.range(0));
+    domain::graphics2d::PixelBufferPool pool;
+    for (auto _ : state) {
+      PixelBuffer buffer(size, domain::graphics2d::UNINITIALIZED, &pool);
+      benchmark::DoNotOptimize(buffer.pixels_.get());
+    }
+    setPixelCounters(state, static_cast<int64_t>(size));
+  }
+
+  // コピーはピクセルバッファを共有するだけで、書き込み時に初めて複製される
+  void BM_ImageCopyShared(benchmark::State& state) {
+    const size_t side = static_cast<size_t>(state.range(0));
+    const Image source(side, side);
+    for (auto _ : state) {
+      Image copy(source);
+      benchmark::DoNotOptimize(copy.isShared());
+    }
+  }
+
+  void BM_ImageCopyDetached(benchmark::State& state) {
+    const size_t side = static_cast<size_t>(state.range(0));
+    const Image source(side, side);
+    for (auto _ : state) {
+      Image copy(source);
+      benchmark::DoNotOptimize(copy.getPixelBuffer());
+    }
+    setPixelCounters(state, static_cast<int64_t>(side * side));
+  }
+
+  void BM_ImageMove(benchmark::State& state) {
+    const size_t side = static_cast<size_t>(state.range(0));
+    Image image(side, side);
+    for (auto _ : state) {
+      Image moved(std::move(image));
+      image = std::move(moved);
+      benchmark::DoNotOptimize(image.getWidth());
+    }
+  }
+
+  // 全ピクセルの赤成分の合計を、走査方法ごとに比べる
+  void BM_TraverseGetPixel(benchmark::State& state) {
+    const size_t side = static_cast<size_t>(state.range(0));
+    const Image image(side, side, Pixel(0.5f, 0.25f, 0.125f));
+    for (auto _ : state) {
+      float sum = 0.f;
+      for (size_t y = 0; y < side; ++y) {
+        for (size_t x = 0; x < side; ++x) {
+          sum += image.getPixel(x, y)->r_;
+        }
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    setPixelCounters(state, static_cast<int64_t>(side * side));
+  }
+
+  void BM_TraverseRows(benchmark::State& state) {
+    const size_t side = static_cast<size_t>(state.range(0));
+    const Image image(side, side, Pixel(0.5f, 0.25f, 0.125f));
+    for (auto _ : state) {
+      float sum = 0.f;
+      for (const auto row : domain::graphics2d::rows(image)) {
+        for (const Pixel& pixel : row) {
+          sum += pixel.r_;
+        }
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    setPixelCounters(state, static_cast<int64_t>(side * side));
+  }
+
+  void BM_TraverseForEachPixel(benchmark::State& state) {
+    const size_t side = static_cast<size_t>(state.range(0));
+    const Image image(side, side, Pixel(0.5f, 0.25f, 0.125f));
+    for (auto _ : state) {
+      float sum = 0.f;
+      domain::graphics2d::forEachPixel(image, [&sum](const Pixel& pixel) { sum += pixel.r_; });
+      benchmark::DoNotOptimize(sum);
+    }
+    setPixelCounters(state, static_cast<int64_t>(side * side));
+  }
+}
+
+BENCHMARK(BM_PixelBufferFill)->Apply(imageSides);
+BENCHMARK(BM_PixelBufferUninitialized)->Apply(imageSides);
+BENCHMARK(BM_PixelBufferPooled)->Apply(imageSides);
+BENCHMARK(BM_ImageCopyShared)->Apply(imageSides);
+BENCHMARK(BM_ImageCopyDetached)->Apply(imageSides);
+BENCHMARK(BM_ImageMove)->Apply(imageSides);
+BENCHMARK(BM_TraverseGetPixel)->Apply(imageSides);
+BENCHMARK(BM_TraverseRows)->Apply(imageSides);
+BENCHMARK(BM_TraverseForEachPixel)->Apply(imageSides);
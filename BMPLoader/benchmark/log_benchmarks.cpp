@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "../src/domain/common/include/log.hpp"
+
+using namespace kaf::domain::common;
+
+namespace {
+  // 行ループを模した内側のループ。KAF_LOG_TRACE の呼び出し箇所の有無だけが異なる
+  std::vector<std::uint32_t> values(4096);
+
+  void setItemRate(benchmark::State& state) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * values.size()));
+#ifdef KAF_ENABLE_TRACE
+    state.SetLabel("trace compiled in");
+#else
+    state.SetLabel("trace compiled out");
+#endif
+  }
+
+  void BM_HotLoop(benchmark::State& state) {
+    std::iota(values.begin(), values.end(), 0u);
+    setLogLevel(LogLevel::Warning);
+    for (auto _ : state) {
+      std::uint32_t sum = 0;
+      for (size_t idx = 0; idx < values.size(); ++idx) {
+        sum = sum * 31u + values[idx];
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    setItemRate(state);
+  }
+
+  // 実行時のログレベルで無効にした KAF_LOG_TRACE（KAF_ENABLE_TRACE 未定義ならコード自体が生成されない）
+  void BM_HotLoopWithTrace(benchmark::State& state) {
+    std::iota(values.begin(), values.end(), 0u);
+    setLogLevel(LogLevel::Warning);
+    for (auto _ : state) {
+      std::uint32_t sum = 0;
+      for (size_t idx = 0; idx < values.size(); ++idx) {
+        sum = sum * 31u + values[idx];
+        KAF_LOG_TRACE("value %zu: %u", idx, sum);
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    setItemRate(state);
+  }
+
+  // 比較用: 常に実行時のレベル判定が残る KAF_LOG_DEBUG
+  void BM_HotLoopWithDebug(benchmark::State& state) {
+    std::iota(values.begin(), values.end(), 0u);
+    setLogLevel(LogLevel::Warning);
+    for (auto _ : state) {
+      std::uint32_t sum = 0;
+      for (size_t idx = 0; idx < values.size(); ++idx) {
+        sum = sum * 31u + values[idx];
+        KAF_LOG_DEBUG("value %zu: %u", idx, sum);
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    setItemRate(state);
+  }
+}
+
+BENCHMARK(BM_HotLoop);
+BENCHMARK(BM_HotLoopWithTrace);
+BENCHMARK(BM_HotLoopWithDebug);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "../src/domain/graphics2d/include/pixel.hpp"
+#include "../src/domain/graphics2d/include/pixel_convert.hpp"
+
+using namespace kaf;
+
+namespace {
+  using domain::graphics2d::Pixel;
+  using domain::graphics2d::PixelConvertKernels;
+  using domain::graphics2d::SimdLevel;
+
+  constexpr size_t CONVERT_PIXELS = 1u << 20;
+
+  // range(0): SimdLevel。未対応の命令セットはスキップする
+  const PixelConvertKernels* kernelsFor(benchmark::State& state) {
+    const auto level = static_cast<SimdLevel>(state.range(0));
+    if (!domain::graphics2d::isSimdLevelSupported(level)) {
+      state.SkipWithError("SIMD level not supported on this host");
+      return nullptr;
+    }
+    state.SetLabel(domain::graphics2d::toString(level));
+    return &domain::graphics2d::getPixelConvertKernels(level);
+  }
+
+  // 8bit → float。BytesPerPixel はソースの 1 ピクセルのバイト数
+  template <size_t BytesPerPixel>
+  void runDecode(benchmark::State& state, void (*kernel)(const std::uint8_t*, Pixel*, size_t)) {
+    std::vector<std::uint8_t> source(CONVERT_PIXELS * BytesPerPixel);
+    for (size_t i = 0; i < source.size(); ++i) {
+      source[i] = static_cast<std::uint8_t>(i * 31);
+    }
+    std::vector<Pixel> destination(CONVERT_PIXELS);
+    for (auto _ : state) {
+      kernel(source.data(), destination.data(), CONVERT_PIXELS);
+      benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * CONVERT_PIXELS * (BytesPerPixel + sizeof(Pixel))));
+  }
+
+  template <size_t BytesPerPixel>
+  void runEncode(benchmark::State& state, void (*kernel)(const Pixel*, std::uint8_t*, size_t)) {
+    std::vector<Pixel> source(CONVERT_PIXELS, Pixel(0.25f, 0.5f, 0.75f, 1.f));
+    std::vector<std::uint8_t> destination(CONVERT_PIXELS * BytesPerPixel);
+    for (auto _ : state) {
+      kernel(source.data(), destination.data(), CONVERT_PIXELS);
+      benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * CONVERT_PIXELS * (BytesPerPixel + sizeof(Pixel))));
+  }
+
+  void BM_ConvertBgr8ToPixel(benchmark::State& state) {
+    if (const PixelConvertKernels* kernels = kernelsFor(state)) {
+      runDecode<3>(state, kernels->bgr8ToPixel_);
+    }
+  }
+
+  void BM_ConvertBgrx8ToPixel(benchmark::State& state) {
+    if (const PixelConvertKernels* kernels = kernelsFor(state)) {
+      runDecode<4>(state, kernels->bgrx8ToPixel_);
+    }
+  }
+
+  void BM_ConvertBgra8ToPixel(benchmark::State& state) {
+    if (const PixelConvertKernels* kernels = kernelsFor(state)) {
+      runDecode<4>(state, kernels->bgra8ToPixel_);
+    }
+  }
+
+  void BM_ConvertPixelToBgr8(benchmark::State& state) {
+    if (const PixelConvertKernels* kernels = kernelsFor(state)) {
+      runEncode<3>(state, kernels->pixelToBgr8_);
+    }
+  }
+
+  void BM_ConvertPixelToBgra8(benchmark::State& state) {
+    if (const PixelConvertKernels* kernels = kernelsFor(state)) {
+      runEncode<4>(state, kernels->pixelToBgra8_);
+    }
+  }
+
+  void simdLevels(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("simd");
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+      bench->Arg(static_cast<int64_t>(level));
+    }
+  }
+}
+
+BENCHMARK(BM_ConvertBgr8ToPixel)->Apply(simdLevels);
+BENCHMARK(BM_ConvertBgrx8ToPixel)->Apply(simdLevels);
+BENCHMARK(BM_ConvertBgra8ToPixel)->Apply(simdLevels);
+BENCHMARK(BM_ConvertPixelToBgr8)->Apply(simdLevels);
+BENCHMARK(BM_ConvertPixelToBgra8)->Apply(simdLevels);
@@ -0,0 +1,35 @@
+/**
+ * @file cancellation.hpp
+ * @brief 長い処理を外部から中断するためのキャンセルトークン。
+ */
+#ifndef __CANCELLATION_H__
+#define __CANCELLATION_H__
+
+#include <atomic>
+
+namespace kaf::domain::common{
+    /**
+     * @class CancellationToken
+     * @brief 中断要求のフラグ。cancel() はどのスレッドからでも呼び出せます。
+     * @details 処理側は区切りごとに isCancelled() を確認し、true なら処理を打ち切ります。
+     *          フラグの読み取りだけで済むため、頻繁に確認しても負荷はほとんどありません。
+     */
+    class CancellationToken{
+    public:
+        CancellationToken() = default;
+        CancellationToken(const CancellationToken& other) = delete;
+        CancellationToken& operator=(const CancellationToken& other) = delete;
+
+        /** @brief 中断を要求します。 */
+        void cancel() noexcept { cancelled_.store(true, std::memory_order_relaxed); }
+        /** @brief 中断が要求されたか。 */
+        bool isCancelled() const noexcept { return cancelled_.load(std::memory_order_relaxed); }
+        /** @brief 中断要求を取り消し、トークンを再利用できるようにします。 */
+        void reset() noexcept { cancelled_.store(false, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<bool> cancelled_{false};
+    };
+}
+
+#endif
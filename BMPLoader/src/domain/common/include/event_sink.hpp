@@ -5,9 +5,29 @@
 #ifndef __EVENTSINK_H__
 #define __EVENTSINK_H__
 
-#include <typeinfo>
+#include <cstdint>
 
 namespace kaf::domain::common{
+    /** @brief イベント型の識別子（0 から順に振られる密な番号）。 */
+    using EventTypeId = std::uint32_t;
+
+    namespace detail{
+        /** @brief 次のイベント型識別子を払い出します（スレッドセーフ）。 */
+        EventTypeId nextEventTypeId() noexcept;
+    }
+
+    /**
+     * @brief イベント型 E の識別子を返します。
+     * @details 型ごとに初回呼び出しで 1 度だけ払い出すため、識別子は小さな連番になり、
+     *          配信側は typeid のハッシュ表ではなく配列の添字で購読者を引けます。
+     * @tparam E イベント型（cv 修飾なし）
+     */
+    template<class E>
+    EventTypeId eventTypeId() noexcept {
+        static const EventTypeId id = detail::nextEventTypeId();
+        return id;
+    }
+
     /**
      * @interface IEventSink
      * @brief 型消去された publish 実装に委譲する、テンプレート publish を提供します。
@@ -17,10 +37,10 @@ namespace kaf::domain::common{
     private:
         /**
          * @brief 型消去されたイベントを配信します（実装側で実体化）。
-         * @param typeInfo 実際の型情報
+         * @param typeId イベント型の識別子（eventTypeId<E>()）
          * @param pointer  イベント実体へのポインタ
          */
-        virtual void publish_erased(const std::type_info&, const void*) noexcept = 0;
+        virtual void publish_erased(const EventTypeId typeId, const void* pointer) noexcept = 0;
     public:
         /**
          * @brief 型安全にイベントを配信します。
@@ -28,7 +48,7 @@ namespace kaf::domain::common{
          * @param event 送信するイベント
          */
         template<class E>
-        void publish(const E& event)noexcept;
+        void publish(const E& event) noexcept { publish_erased(eventTypeId<E>(), &event); }
     };
 }
 
@@ -0,0 +1,77 @@
+/**
+ * @file log.hpp
+ * @brief ログ出力とトレースレベルの制御。
+ * @details KAF_LOG_TRACE は KAF_ENABLE_TRACE 定義時のみ展開され、未定義時はコードを生成しません。
+ *          その他のレベルは実行時のログレベルで出力を制御します。
+ */
+#ifndef __LOG_H__
+#define __LOG_H__
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KAF_PRINTF_FORMAT(formatIndex, argumentIndex) __attribute__((format(printf, formatIndex, argumentIndex)))
+#else
+#define KAF_PRINTF_FORMAT(formatIndex, argumentIndex)
+#endif
+
+namespace kaf::domain::common{
+    /**
+     * @enum LogLevel
+     * @brief ログレベル（値が大きいほど重要）。
+     */
+    enum class LogLevel : int {
+        /** 行・ピクセル単位の詳細（KAF_ENABLE_TRACE 時のみ有効） */
+        Trace = 0,
+        /** ヘッダ内容などの調査用情報 */
+        Debug,
+        /** 処理完了などの通知 */
+        Info,
+        /** 継続可能な異常 */
+        Warning,
+        /** 処理の失敗 */
+        Error,
+        /** 出力しない */
+        Off,
+    };
+
+    /**
+     * @brief 出力するログレベルの下限を設定します（既定: Warning）。
+     * @param level この値以上のログを出力
+     */
+    void setLogLevel(LogLevel level);
+
+    /** @brief 現在のログレベルの下限を返します。 */
+    LogLevel getLogLevel();
+
+    /**
+     * @brief 指定レベルのログが出力対象かを返します。
+     * @param level 判定するレベル
+     */
+    bool isLogEnabled(LogLevel level);
+
+    /**
+     * @brief printf 形式でログを 1 行出力します（標準エラー出力）。
+     * @param level ログレベル
+     * @param format 書式文字列（改行不要）
+     */
+    void writeLog(LogLevel level, const char* format, ...) KAF_PRINTF_FORMAT(2, 3);
+}
+
+#define KAF_LOG(level, ...) \
+    do { \
+        if(::kaf::domain::common::isLogEnabled(level)) { \
+            ::kaf::domain::common::writeLog(level, __VA_ARGS__); \
+        } \
+    } while(false)
+
+#define KAF_LOG_DEBUG(...) KAF_LOG(::kaf::domain::common::LogLevel::Debug, __VA_ARGS__)
+#define KAF_LOG_INFO(...) KAF_LOG(::kaf::domain::common::LogLevel::Info, __VA_ARGS__)
+#define KAF_LOG_WARNING(...) KAF_LOG(::kaf::domain::common::LogLevel::Warning, __VA_ARGS__)
+#define KAF_LOG_ERROR(...) KAF_LOG(::kaf::domain::common::LogLevel::Error, __VA_ARGS__)
+
+#ifdef KAF_ENABLE_TRACE
+#define KAF_LOG_TRACE(...) KAF_LOG(::kaf::domain::common::LogLevel::Trace, __VA_ARGS__)
+#else
+#define KAF_LOG_TRACE(...) static_cast<void>(0)
+#endif
+
+#endif
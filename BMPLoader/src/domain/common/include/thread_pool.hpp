@@ -0,0 +1,83 @@
+/**
+ * @file thread_pool.hpp
+ * @brief ワークスティーリング方式のスレッドプールと並列 for。
+ */
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kaf::domain::common{
+    /**
+     * @class ThreadPool
+     * @brief ワーカーごとのタスクキューを持ち、空いたワーカーが他のキューからタスクを盗むスレッドプール。
+     * @details parallelFor の呼び出し元も処理に参加し、完了を待つ間は他のタスクを実行します。
+     *          そのため複数のスレッドからの同時呼び出しや、タスク内からの入れ子の呼び出しでも
+     *          デッドロックせず、スレッド数がワーカー数を超えて増えることはありません。
+     */
+    class ThreadPool{
+    public:
+        /**
+         * @brief ワーカーを起動します。
+         * @param workerCount ワーカー数（呼び出し元を含まない。0 で処理はすべて呼び出し元で行います）
+         */
+        explicit ThreadPool(const size_t workerCount);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool& other) = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+
+        /** @brief ワーカー数。 */
+        size_t getWorkerCount() const { return workers_.size(); }
+        /** @brief 並列度（ワーカー数 + 呼び出し元）。 */
+        size_t getConcurrency() const { return workers_.size() + 1; }
+
+        /**
+         * @brief [begin, end) を grain 件ずつの区間に分け、function(chunkBegin, chunkEnd) を並列に呼び出します。
+         * @details 区間は空いているスレッドが順に取得するため、処理時間に偏りがあっても負荷が均されます。
+         *          function が例外を送出した場合は残りの区間を打ち切り、最初の例外を呼び出し元で再送出します。
+         * @param begin 範囲の先頭
+         * @param end 範囲の末尾（含まない）
+         * @param grain 1 回の呼び出しで処理する件数（0 は 1 とみなします）
+         * @param function 区間ごとの処理
+         */
+        void parallelFor(const size_t begin, const size_t end, const size_t grain, const std::function<void(size_t, size_t)>& function);
+
+        /**
+         * @brief プロセス共通のプールを返します（ワーカー数はハードウェアスレッド数 - 1）。
+         * @details 複数の処理が同じプールを共有することで、同時に実行してもコア数以上のスレッドを使いません。
+         */
+        static ThreadPool& shared();
+
+    private:
+        struct Queue{
+            std::mutex mutex_;
+            std::deque<std::function<void()>> tasks_;
+        };
+
+        void push(std::function<void()>&& task);
+        bool tryRunOne(const size_t preferred);
+        void workerLoop(const size_t index);
+
+        /** ワーカーごとのタスクキュー */
+        std::vector<std::unique_ptr<Queue>> queues_;
+        /** ワーカー */
+        std::vector<std::thread> workers_;
+        /** キューに積まれている未実行タスク数 */
+        std::atomic<size_t> queued_{0};
+        /** 外部スレッドからの投入先（ラウンドロビン） */
+        std::atomic<size_t> nextQueue_{0};
+        std::mutex sleepMutex_;
+        std::condition_variable wake_;
+        bool stopping_ = false;
+    };
+}
+
+#endif
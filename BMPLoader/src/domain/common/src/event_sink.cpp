@@ -1,10 +1,16 @@
 /**
  * @file event_sink.cpp
- * @brief IEventSink::publish テンプレートの実装。
+ * @brief イベント型識別子の払い出し。
  */
 #include "../include/event_sink.hpp"
 
+#include <atomic>
+
 namespace kaf::domain::common{
-    template<class E>
-    void IEventSink::publish(const E& event)noexcept { publish_erased(typeid(E), &event); }
+    namespace detail{
+        EventTypeId nextEventTypeId() noexcept {
+            static std::atomic<EventTypeId> next{0};
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
 }
@@ -0,0 +1,48 @@
+/**
+ * @file log.cpp
+ * @brief ログ出力の実装。
+ */
+#include "../include/log.hpp"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+namespace kaf::domain::common{
+    namespace {
+        std::atomic<int> currentLevel{static_cast<int>(LogLevel::Warning)};
+
+        const char* levelName(const LogLevel level){
+            switch(level){
+                case LogLevel::Trace: return "TRACE";
+                case LogLevel::Debug: return "DEBUG";
+                case LogLevel::Info: return "INFO";
+                case LogLevel::Warning: return "WARN";
+                case LogLevel::Error: return "ERROR";
+                default: return "";
+            }
+        }
+    }
+
+    void setLogLevel(const LogLevel level){
+        currentLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    LogLevel getLogLevel(){
+        return static_cast<LogLevel>(currentLevel.load(std::memory_order_relaxed));
+    }
+
+    bool isLogEnabled(const LogLevel level){
+        return level != LogLevel::Off && static_cast<int>(level) >= currentLevel.load(std::memory_order_relaxed);
+    }
+
+    void writeLog(const LogLevel level, const char* format, ...){
+        char message[512];
+        va_list arguments;
+        va_start(arguments, format);
+        std::vsnprintf(message, sizeof(message), format, arguments);
+        va_end(arguments);
+        // 1 回の書き込みにまとめ、複数スレッドからの出力が行の途中で混ざらないようにします
+        std::fprintf(stderr, "[%s] %s\n", levelName(level), message);
+    }
+}
@@ -0,0 +1,194 @@
+/**
+ * @file thread_pool.cpp
+ * @brief ThreadPool の実装。
+ */
+#include "../include/thread_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+
+namespace kaf::domain::common{
+    namespace {
+        /** @brief 実行中のスレッドが属するプール（ワーカー以外は nullptr）。 */
+        thread_local const ThreadPool* currentPool = nullptr;
+        /** @brief 実行中のワーカーのキュー番号。 */
+        thread_local size_t currentQueue = 0;
+
+        /** @brief parallelFor 1 回分の共有状態。 */
+        struct ParallelJob{
+            ParallelJob(const size_t begin, const size_t end, const size_t grain, const size_t chunkCount, const std::function<void(size_t, size_t)>& function)
+                : begin_(begin), end_(end), grain_(grain), chunkCount_(chunkCount), function_(function){}
+
+            size_t begin_;
+            size_t end_;
+            size_t grain_;
+            size_t chunkCount_;
+            const std::function<void(size_t, size_t)>& function_;
+            std::atomic<size_t> nextChunk_{0};
+            std::atomic<size_t> pendingRunners_{0};
+            std::atomic<bool> failed_{false};
+            std::mutex errorMutex_;
+            std::exception_ptr error_;
+
+            /** @brief 区間がなくなるまで取得して処理します。 */
+            void run(){
+                while(!failed_.load(std::memory_order_relaxed)){
+                    const size_t chunk = nextChunk_.fetch_add(1, std::memory_order_relaxed);
+                    if(chunk >= chunkCount_){
+                        return;
+                    }
+                    const size_t chunkBegin = begin_ + chunk * grain_;
+                    const size_t chunkEnd = std::min(chunkBegin + grain_, end_);
+                    try{
+                        function_(chunkBegin, chunkEnd);
+                    }
+                    catch(...){
+                        std::lock_guard<std::mutex> lock(errorMutex_);
+                        if(!error_){
+                            error_ = std::current_exception();
+                        }
+                        failed_.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+        };
+    }
+
+    ThreadPool::ThreadPool(const size_t workerCount){
+        queues_.reserve(std::max<size_t>(1, workerCount));
+        for(size_t idx = 0; idx < std::max<size_t>(1, workerCount); ++idx){
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        workers_.reserve(workerCount);
+        for(size_t idx = 0; idx < workerCount; ++idx){
+            try{
+                workers_.emplace_back(&ThreadPool::workerLoop, this, idx);
+            }
+            catch(const std::system_error&){
+                // 起動できた分のワーカーで動作します（0 の場合は呼び出し元のみ）
+                break;
+            }
+        }
+    }
+
+    ThreadPool::~ThreadPool(){
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for(auto& worker : workers_){
+            worker.join();
+        }
+    }
+
+    ThreadPool& ThreadPool::shared(){
+        static ThreadPool pool(std::max<size_t>(1, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    void ThreadPool::push(std::function<void()>&& task){
+        const size_t index = currentPool == this ? currentQueue
+            : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex_);
+            queues_[index]->tasks_.push_back(std::move(task));
+        }
+        {
+            // 待機判定との競合で起床を取りこぼさないよう、ロック下で件数を更新します
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            queued_.fetch_add(1, std::memory_order_release);
+        }
+        wake_.notify_one();
+    }
+
+    bool ThreadPool::tryRunOne(const size_t preferred){
+        if(queued_.load(std::memory_order_acquire) == 0){
+            return false;
+        }
+        std::function<void()> task;
+        for(size_t offset = 0; offset < queues_.size() && !task; ++offset){
+            Queue& queue = *queues_[(preferred + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex_);
+            if(queue.tasks_.empty()){
+                continue;
+            }
+            if(offset == 0){
+                // 自分のキューは後ろから（直前に積んだ、キャッシュに残っているタスク）
+                task = std::move(queue.tasks_.back());
+                queue.tasks_.pop_back();
+            }
+            else{
+                // 他のキューからは前から盗む
+                task = std::move(queue.tasks_.front());
+                queue.tasks_.pop_front();
+            }
+        }
+        if(!task){
+            return false;
+        }
+        queued_.fetch_sub(1, std::memory_order_acq_rel);
+        task();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(const size_t index){
+        currentPool = this;
+        currentQueue = index;
+        while(true){
+            if(tryRunOne(index)){
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wake_.wait(lock, [this]{ return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+            if(stopping_ && queued_.load(std::memory_order_acquire) == 0){
+                return;
+            }
+        }
+    }
+
+    void ThreadPool::parallelFor(const size_t begin, const size_t end, const size_t grain, const std::function<void(size_t, size_t)>& function){
+        if(end <= begin){
+            return;
+        }
+        const size_t chunkSize = std::max<size_t>(1, grain);
+        const size_t chunkCount = (end - begin + chunkSize - 1) / chunkSize;
+        const size_t runnerCount = std::min(chunkCount, getConcurrency());
+        if(runnerCount <= 1){
+            function(begin, end);
+            return;
+        }
+
+        ParallelJob job(begin, end, chunkSize, chunkCount, function);
+        job.pendingRunners_.store(runnerCount - 1, std::memory_order_relaxed);
+        for(size_t idx = 0; idx + 1 < runnerCount; ++idx){
+            push([this, &job]{
+                job.run();
+                if(job.pendingRunners_.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                    // 待機判定との競合で起床を取りこぼさないよう、ロックを取ってから通知します
+                    // （以降 job は破棄されている可能性があるため参照しません）
+                    std::lock_guard<std::mutex> lock(sleepMutex_);
+                    wake_.notify_all();
+                }
+            });
+        }
+        job.run();
+
+        // 残りの区間を処理中のスレッドを待つ間、キューに残るタスク（他の呼び出し分を含む）を手伝います。
+        // キューが空なら未完了の区間はすべて他のスレッドが実行中なので、完了か新しいタスクの投入まで眠ります
+        const size_t preferred = currentPool == this ? currentQueue : 0;
+        while(job.pendingRunners_.load(std::memory_order_acquire) > 0){
+            if(tryRunOne(preferred)){
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wake_.wait(lock, [this, &job]{
+                return job.pendingRunners_.load(std::memory_order_acquire) == 0 || queued_.load(std::memory_order_acquire) > 0;
+            });
+        }
+        if(job.error_){
+            std::rethrow_exception(job.error_);
+        }
+    }
+}
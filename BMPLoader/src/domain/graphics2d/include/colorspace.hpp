@@ -0,0 +1,117 @@
+/**
+ * @file colorspace.hpp
+ * @brief 色空間の変換（sRGB ⇔ リニア、グレースケール、プレーナ YCbCr 4:4:4 / 4:2:0）。
+ */
+#ifndef __COLORSPACE_H__
+#define __COLORSPACE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../../common/include/thread_pool.hpp"
+#include "image.hpp"
+#include "pixel.hpp"
+#include "pixel_format.hpp"
+
+namespace kaf::domain::graphics2d{
+    /**
+     * @brief sRGB の値をリニアに変換します（std::pow を使わない多項式近似、誤差 1e-5 程度）。
+     * @param value sRGB の値（[0, 1] にクランプします）
+     */
+    float srgbToLinear(const float value);
+
+    /**
+     * @brief リニアの値を sRGB に変換します（std::pow を使わない多項式近似、誤差 1e-5 程度）。
+     * @param value リニアの値（[0, 1] にクランプします）
+     */
+    float linearToSrgb(const float value);
+
+    /** @brief 8bit の sRGB の値をリニアに変換します（256 要素の表を引きます）。 */
+    float srgbByteToLinear(const std::uint8_t value);
+
+    /**
+     * @brief sRGB のピクセル列をリニアの Pixel 列へ変換します（アルファはそのまま）。
+     * @details 8bit 形式は表引き、Pixel は多項式近似（SSE2 では 1 ピクセルずつまとめて）で変換します。
+     */
+    template<class P>
+    void srgbToLinearRow(const P* source, Pixel* destination, const size_t width);
+
+    /** @brief リニアの Pixel 列を sRGB のピクセル列へ変換します（アルファはそのまま）。 */
+    template<class P>
+    void linearToSrgbRow(const Pixel* source, P* destination, const size_t width);
+
+    /**
+     * @brief sRGB の画像をリニアの float RGBA 画像に変換します（行単位で並列に処理します）。
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<Image> toLinear(const BasicImage<P>& source, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief リニアの float RGBA 画像を sRGB の画像に変換します（例: toSrgb<BGRA8>(linear)）。
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> toSrgb(const Image& linear, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 輝度（BT.601、Gray8 への変換と同じ係数）のグレースケール画像を生成します。
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<Gray8>> toGrayscale(const BasicImage<P>& source, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /** @brief 色差成分の間引き方。 */
+    enum class ChromaSubsampling{
+        /** 間引かない（4:4:4） */
+        YCbCr444,
+        /** 縦横 1/2（4:2:0） */
+        YCbCr420,
+    };
+
+    /**
+     * @struct PlanarYCbCr
+     * @brief 8bit フルレンジ YCbCr（BT.601、JFIF）のプレーナ形式。
+     */
+    struct PlanarYCbCr{
+        /** 輝度の幅・高さ[px] */
+        size_t width_{};
+        size_t height_{};
+        /** 色差の幅・高さ[px]（4:2:0 では切り上げで半分） */
+        size_t chromaWidth_{};
+        size_t chromaHeight_{};
+        ChromaSubsampling subsampling_ = ChromaSubsampling::YCbCr444;
+        /** 輝度（width_ * height_） */
+        std::vector<std::uint8_t> y_;
+        /** 色差（chromaWidth_ * chromaHeight_） */
+        std::vector<std::uint8_t> cb_;
+        std::vector<std::uint8_t> cr_;
+
+        /** @brief サイズと各プレーンの要素数が整合しているか。 */
+        bool isValid() const {
+            return width_ > 0 && height_ > 0 && y_.size() == width_ * height_ &&
+                cb_.size() == chromaWidth_ * chromaHeight_ && cr_.size() == cb_.size() && !cb_.empty();
+        }
+    };
+
+    /**
+     * @brief 画像をプレーナ YCbCr に変換します。
+     * @details 4:2:0 では 2×2 ピクセルの色差を平均します（右端・下端の半端は端のピクセルを繰り返します）。
+     *          アルファは捨てます。
+     * @return 変換結果（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<PlanarYCbCr> toYCbCr(const BasicImage<P>& source, const ChromaSubsampling subsampling = ChromaSubsampling::YCbCr444,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief プレーナ YCbCr を画像に変換します（4:2:0 の色差は最近傍で拡大します、例: fromYCbCr<BGR8>(planes)）。
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> fromYCbCr(const PlanarYCbCr& planes, common::ThreadPool& pool = common::ThreadPool::shared());
+}
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file composite.hpp
+ * @brief 画像の合成（over, multiply, screen, add）。
+ */
+#ifndef __COMPOSITE_H__
+#define __COMPOSITE_H__
+
+#include <cstddef>
+
+#include "../../common/include/thread_pool.hpp"
+#include "image.hpp"
+#include "image_view.hpp"
+
+namespace kaf::domain::graphics2d{
+    /**
+     * @brief 合成方法（W3C Compositing and Blending の定義に従います）。
+     * @details 式はアルファ乗算済みの値 s（上の画像）、d（下の画像）と、それぞれのアルファ sa, da で表します。
+     */
+    enum class BlendMode{
+        /** s + d(1 - sa)（通常の重ね合わせ） */
+        Over,
+        /** sd + s(1 - da) + d(1 - sa)（乗算） */
+        Multiply,
+        /** s + d - sd（スクリーン） */
+        Screen,
+        /** min(s + d, 1)（加算） */
+        Add,
+    };
+
+    /** @brief 合成方法の名前（"over" 等）。 */
+    const char* toString(const BlendMode mode);
+
+    /**
+     * @brief destination の (x, y) を左上として source を合成します。
+     * @details source のうち destination の外に出る部分は切り捨てます（負の位置も指定できます）。
+     *          合成はアルファ乗算済みの float RGBA で行い、行単位で pool 上で並列に処理します。
+     * @param destination 合成先（書き換えられます）
+     * @param source 重ねる画像（destination と重ならないこと）
+     * @param x 合成先での左端
+     * @param y 合成先での上端
+     * @param mode 合成方法
+     * @param opacity source の不透明度（0.0〜1.0）
+     * @param pool 実行するプール
+     * @retval true 成功（重なる部分がない場合を含む）
+     * @retval false 失敗（無効なビュー）
+     */
+    template<class P>
+    bool compositeView(const BasicImageView<P>& destination, const BasicImageView<const P>& source,
+        const std::ptrdiff_t x, const std::ptrdiff_t y, const BlendMode mode = BlendMode::Over, const float opacity = 1.0f,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief destination の (x, y) を左上として source を合成します（destination が共有中なら複製します）。
+     * @details source と destination に同じ画像を指定できます。その場合は合成前の内容を重ねます
+     *          （コピーオンライトで合成前のバッファを入力として残すため、画像 1 枚分を複製します）。
+     * @retval true 成功（重なる部分がない場合を含む）
+     * @retval false 失敗（無効な画像）
+     */
+    template<class P>
+    bool compositeImage(BasicImage<P>& destination, const BasicImage<P>& source,
+        const std::ptrdiff_t x = 0, const std::ptrdiff_t y = 0, const BlendMode mode = BlendMode::Over, const float opacity = 1.0f,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+}
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @file convolution.hpp
+ * @brief 画像の畳み込み（任意カーネル、分離可能カーネル）とぼかし・シャープ化。
+ */
+#ifndef __CONVOLUTION_H__
+#define __CONVOLUTION_H__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "../../common/include/thread_pool.hpp"
+#include "image.hpp"
+#include "image_view.hpp"
+
+namespace kaf::domain::graphics2d{
+    /** @brief 画像の外側を参照したときの扱い。 */
+    enum class EdgeMode{
+        /** 端のピクセルを繰り返す（aaa|abcd|ddd） */
+        Clamp,
+        /** 端で折り返す（cba|abcd|dcb） */
+        Mirror,
+        /** 反対側から続ける（bcd|abcd|abc） */
+        Wrap,
+    };
+
+    /** @brief 端の扱いの名前（"clamp" 等）。 */
+    const char* toString(const EdgeMode edge);
+
+    /**
+     * @struct ConvolutionKernel
+     * @brief 2 次元の畳み込みカーネル（中心が原点、行優先）。
+     */
+    struct ConvolutionKernel{
+        /** 幅（奇数） */
+        size_t width_{};
+        /** 高さ（奇数） */
+        size_t height_{};
+        /** 重み（width_ * height_ 要素、行優先） */
+        std::vector<float> weights_;
+
+        /** @brief 幅・高さが奇数で、重みの数が一致しているか。 */
+        bool isValid() const {
+            return width_ % 2 == 1 && height_ % 2 == 1 && weights_.size() == width_ * height_;
+        }
+    };
+
+    /**
+     * @brief 正規化済みのガウスカーネル（1 次元）を返します。
+     * @param sigma 標準偏差[px]
+     * @return 2 * ceil(3 * sigma) + 1 要素の重み（sigma <= 0 の場合は {1}）
+     */
+    std::vector<float> gaussianKernel(const float sigma);
+
+    /**
+     * @brief 任意の 2 次元カーネルで畳み込みます（カーネルは反転しない相関として適用します）。
+     * @details 処理はアルファ乗算済みの float RGBA で行い、出力時に [0, 1] へクランプします。
+     *          画像は L2 キャッシュに収まる大きさのタイルに分け、pool 上で並列に処理します。
+     * @param source 入力ビュー
+     * @param destination 出力ビュー（入力と同じサイズで、重ならないこと）
+     * @param kernel カーネル
+     * @param edge 端の扱い
+     * @param pool 実行するプール
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー・カーネル、サイズ不一致）
+     */
+    template<class P>
+    bool convolveView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const ConvolutionKernel& kernel,
+        const EdgeMode edge = EdgeMode::Clamp, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 分離可能なカーネル（水平方向 × 垂直方向）で畳み込みます。
+     * @details タイルごとに水平方向の結果を保持し、続けて垂直方向に畳み込みます。
+     *          1 ピクセル当たりの計算量は 2 次元カーネルの幅×高さに対して幅＋高さです。
+     * @param source 入力ビュー
+     * @param destination 出力ビュー（入力と同じサイズで、重ならないこと）
+     * @param horizontal 水平方向の重み（奇数個）
+     * @param vertical 垂直方向の重み（奇数個）
+     * @param edge 端の扱い
+     * @param pool 実行するプール
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー・カーネル、サイズ不一致）
+     */
+    template<class P>
+    bool convolveSeparableView(const BasicImageView<const P>& source, const BasicImageView<P>& destination,
+        const std::vector<float>& horizontal, const std::vector<float>& vertical,
+        const EdgeMode edge = EdgeMode::Clamp, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief ボックスぼかし（(2 * radius + 1) 四方の平均）をかけます。
+     * @details 水平・垂直とも移動和で求めるため、1 ピクセル当たりの計算量は半径によりません。
+     *          タイルには分けず、行の帯（並列度と同じ数）ごとに全幅の行を処理します。
+     *          作業領域は帯ごとに 4 行分（float RGBA）です。
+     * @param source 入力ビュー
+     * @param destination 出力ビュー（入力と同じサイズで、重ならないこと）
+     * @param radius 半径[px]
+     * @param edge 端の扱い
+     * @param pool 実行するプール
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー、サイズ不一致）
+     */
+    template<class P>
+    bool boxBlurView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const size_t radius,
+        const EdgeMode edge = EdgeMode::Clamp, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 任意の 2 次元カーネルで畳み込んだ画像を生成します。
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> convolveImage(const BasicImage<P>& source, const ConvolutionKernel& kernel,
+        const EdgeMode edge = EdgeMode::Clamp, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief ガウスぼかしをかけた画像を生成します（分離可能カーネルで処理します）。
+     * @param source 入力画像
+     * @param sigma 標準偏差[px]
+     * @param edge 端の扱い
+     * @param pool 実行するプール
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> gaussianBlur(const BasicImage<P>& source, const float sigma,
+        const EdgeMode edge = EdgeMode::Clamp, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief ボックスぼかしをかけた画像を生成します。
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> boxBlur(const BasicImage<P>& source, const size_t radius,
+        const EdgeMode edge = EdgeMode::Clamp, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief アンシャープマスクをかけた画像を生成します。
+     * @details 出力 = 入力 + amount × (入力 − ガウスぼかし)。差の絶対値が threshold 未満の成分は変更しません。
+     *          アルファ成分は変更しません。
+     * @param source 入力画像
+     * @param sigma ぼかしの標準偏差[px]
+     * @param amount 強さ（1.0 で差を等倍で加算）
+     * @param threshold しきい値（0.0〜1.0）
+     * @param edge 端の扱い
+     * @param pool 実行するプール
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> unsharpMask(const BasicImage<P>& source, const float sigma, const float amount, const float threshold = 0.0f,
+        const EdgeMode edge = EdgeMode::Clamp, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 3×3 のラプラシアンによるシャープ化をかけた画像を生成します。
+     * @param source 入力画像
+     * @param amount 強さ（0.0 で変化なし）
+     * @param edge 端の扱い
+     * @param pool 実行するプール
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> sharpen(const BasicImage<P>& source, const float amount = 1.0f,
+        const EdgeMode edge = EdgeMode::Clamp, common::ThreadPool& pool = common::ThreadPool::shared());
+}
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file geometry.hpp
+ * @brief 画像の回転（90°単位）・転置・反転。
+ */
+#ifndef __GEOMETRY_H__
+#define __GEOMETRY_H__
+
+#include <memory>
+
+#include "../../common/include/thread_pool.hpp"
+#include "image.hpp"
+#include "image_view.hpp"
+
+namespace kaf::domain::graphics2d{
+    /** @brief 回転角（時計回り）。 */
+    enum class Rotation{
+        Rotate90,
+        Rotate180,
+        Rotate270,
+    };
+
+    /** @brief 反転の向き。 */
+    enum class FlipAxis{
+        /** 左右反転 */
+        Horizontal,
+        /** 上下反転 */
+        Vertical,
+    };
+
+    /**
+     * @brief 転置します（出力の (x, y) = 入力の (y, x)）。
+     * @details キャッシュに収まる正方ブロック単位で読み書きし、列方向の走査によるキャッシュミスを避けます。
+     *          ブロックの行帯は pool 上で並列に処理します。
+     * @param source 入力ビュー
+     * @param destination 出力ビュー（幅・高さが入力の高さ・幅で、入力と重ならないこと）
+     * @param pool 実行するプール
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー、サイズ不一致）
+     */
+    template<class P>
+    bool transposeView(const BasicImageView<const P>& source, const BasicImageView<P>& destination,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 時計回りに回転します（90°・270°は転置と同じブロック処理、180°は行の反転）。
+     * @param source 入力ビュー
+     * @param destination 出力ビュー（90°・270°では幅・高さが入れ替わったサイズ。入力と重ならないこと）
+     * @param rotation 回転角
+     * @param pool 実行するプール
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー、サイズ不一致）
+     */
+    template<class P>
+    bool rotateView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const Rotation rotation,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 反転します（左右反転は行単位の逆順コピー、上下反転は行単位のコピー）。
+     * @param source 入力ビュー
+     * @param destination 出力ビュー（入力と同じサイズで、重ならないこと）
+     * @param axis 反転の向き
+     * @param pool 実行するプール
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー、サイズ不一致）
+     */
+    template<class P>
+    bool flipView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const FlipAxis axis,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /** @brief 転置した画像を生成します（失敗時 nullptr）。 */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> transposeImage(const BasicImage<P>& source, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /** @brief 時計回りに回転した画像を生成します（失敗時 nullptr）。 */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> rotateImage(const BasicImage<P>& source, const Rotation rotation,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /** @brief 反転した画像を生成します（失敗時 nullptr）。 */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> flipImage(const BasicImage<P>& source, const FlipAxis axis,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 180°回転を 2 つ目のバッファなしで行います（上下の行を反転しながら入れ替えます）。
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー）
+     */
+    template<class P>
+    bool rotate180InPlace(const BasicImageView<P>& view, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 反転を 2 つ目のバッファなしで行います。
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー）
+     */
+    template<class P>
+    bool flipInPlace(const BasicImageView<P>& view, const FlipAxis axis, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /** @brief 画像を 180°回転します（共有中なら複製してから書き換えます）。 */
+    template<class P>
+    bool rotate180InPlace(BasicImage<P>& image, common::ThreadPool& pool = common::ThreadPool::shared()){
+        return rotate180InPlace(makeView(image), pool);
+    }
+
+    /** @brief 画像を反転します（共有中なら複製してから書き換えます）。 */
+    template<class P>
+    bool flipInPlace(BasicImage<P>& image, const FlipAxis axis, common::ThreadPool& pool = common::ThreadPool::shared()){
+        return flipInPlace(makeView(image), axis, pool);
+    }
+}
+
+#endif
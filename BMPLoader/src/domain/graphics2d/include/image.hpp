@@ -13,32 +13,52 @@
 
 #include "pixel.hpp"
 #include "pixel_buffer.hpp"
+#include "pixel_format.hpp"
+#include "pixel_span.hpp"
 
 
 namespace kaf::domain::graphics2d{
     /**
-     * @class Image
+     * @class BasicImage
      * @brief ピクセルバッファを所有する 2D 画像。
+     * @details ピクセルバッファはコピー間で共有され（参照カウント）、コピーは O(1) です。
+     *          非 const の getPixelBuffer / getPixel / setPixel で書き込む際、共有中であれば
+     *          その時点で複製します（コピーオンライト）。const のアクセスは複製しません。
+     *
+     *          1 つの BasicImage オブジェクトは 1 つのスレッドが所有する前提です。バッファを共有するコピーどうしは
+     *          別々のスレッドで使えますが、同じオブジェクトを複数のスレッドから同時に使う場合は、書き込みがあれば
+     *          呼び出し側で排他してください（並列処理では先に makeView で複製を済ませ、ビューを分けて渡します）。
+     *
+     *          書き込み用に取得したポインタ・行・ビューは、その後に画像をコピーすると無効になります。
+     *          コピーと共有したバッファを指したままになり、次の書き込みで画像側だけが新しいバッファへ移るため、
+     *          古いポインタからの書き込みはコピーに見え、画像には反映されません。コピーした後は取得し直してください。
+     * @tparam P ピクセル形式（Pixel, RGBA8, BGRA8, BGR8, Gray8）
      */
-    class Image{
+    template<class P>
+    class BasicImage{
     public:
+        /** @brief ピクセル形式。 */
+        using PixelType = P;
+        /** @brief ピクセルバッファの型。 */
+        using BufferType = BasicPixelBuffer<P>;
+
         /** @brief 既定コンストラクタ。 */
-        Image();
+        BasicImage();
         /**
          * @brief 画像を生成します。
          * @param buffer ピクセル配列（所有権を移動）
          * @param width 幅[px]
          * @param height 高さ[px]
          */
-        Image(std::unique_ptr<PixelBuffer>&& buffer, size_t width, size_t height);
+        BasicImage(std::unique_ptr<BufferType>&& buffer, size_t width, size_t height);
 
-        Image(const size_t width, const size_t height, const Pixel& pixel = Pixel(1.0f, 1.0f, 1.0f));
+        BasicImage(const size_t width, const size_t height, const P& pixel = PixelFormat<P>::white());
 
-        ~Image();
-        Image(const Image& other);
-        Image& operator=(const Image& other);
-        Image(Image&& other);
-        Image& operator=(Image&& other);
+        ~BasicImage();
+        BasicImage(const BasicImage& other);
+        BasicImage& operator=(const BasicImage& other);
+        BasicImage(BasicImage&& other);
+        BasicImage& operator=(BasicImage&& other);
 
         /** @brief 画像・バッファが妥当かを検証します。 */
         bool isValid() const;
@@ -47,22 +67,47 @@ namespace kaf::domain::graphics2d{
         void setWidth(size_t width) { width_ = width; }
         size_t getHeight() const { return height_; }
         void setHeight(size_t height) { height_ = height; }
-        PixelBuffer* getPixelBuffer() const { return pixelBuffer_.get(); }
-        std::unique_ptr<PixelBuffer> passPixelBuffer() { return std::move(pixelBuffer_); }
-        void setPixelBuffer(std::unique_ptr<PixelBuffer>&& buffer) { pixelBuffer_ =  std::move(buffer); }
+        /** @brief 読み取り用のピクセルバッファ（共有中でも複製しません）。 */
+        const BufferType* getPixelBuffer() const { return pixelBuffer_.get(); }
+        /** @brief 書き込み用のピクセルバッファ（共有中なら複製してから返します）。 */
+        BufferType* getPixelBuffer() { detach(); return pixelBuffer_.get(); }
+        /** @brief ピクセルバッファの所有権を取り出します（共有中なら複製を返します）。 */
+        std::unique_ptr<BufferType> passPixelBuffer();
+        void setPixelBuffer(std::unique_ptr<BufferType>&& buffer) { pixelBuffer_ =  std::move(buffer); }
+        /** @brief ピクセルバッファを他の画像と共有しているか（他のスレッドのコピーが破棄されると変わります）。 */
+        bool isShared() const { return pixelBuffer_ != nullptr && pixelBuffer_.use_count() > 1; }
 
-        Pixel* getPixel(const size_t width, const size_t height)const;
-        bool setPixel(const size_t width, const size_t height, const Pixel& pixel);
+        const P* getPixel(const size_t width, const size_t height)const;
+        P* getPixel(const size_t width, const size_t height);
+        bool setPixel(const size_t width, const size_t height, const P& pixel);
+
+        /**
+         * @brief 読み取り用の 1 行を返します。
+         * @details 検証を行わないため、isValid() な画像に対して height < getHeight() で呼び出してください。
+         *          画素ごとに getPixel を呼ぶ代わりに、行単位で走査するためのものです。
+         *          書き込み用の行は makeView(image).row(height) または rows(image) で取得します
+         *          （共有の確認と複製をビューの取得時に 1 回だけ行い、各行では確認しません）。
+         * @param height Y 座標（0 が最上行）
+         */
+        PixelSpan<const P> row(const size_t height) const {
+            return PixelSpan<const P>(pixelBuffer_->pixels_.get() + height * width_, width_);
+        }
 
     private:
+        /** @brief 共有中のピクセルバッファを複製し、この画像専用にします。 */
+        void detach();
+
         /** 幅[px] */
         size_t width_{};
         /** 高さ[px] */
         size_t height_{};
-        /** ピクセルバッファ */
-        std::unique_ptr<PixelBuffer> pixelBuffer_ = nullptr;
+        /** ピクセルバッファ（コピー間で共有） */
+        std::shared_ptr<BufferType> pixelBuffer_ = nullptr;
     };
 
+    /** @brief float RGBA の画像。 */
+    using Image = BasicImage<Pixel>;
+
     /**
      * @brief 幅×高さの積を安全に計算します。
      * @return 正常なら積、オーバーフロー時は std::nullopt、ゼロ含みなら 0。
@@ -82,7 +127,8 @@ namespace kaf::domain::graphics2d{
      * @retval true 成功
      * @retval false 失敗（範囲外 等）
      */
-    bool getPixel(const Image& image, Pixel& pixel, unsigned int width, unsigned int height);
+    template<class P>
+    bool getPixel(const BasicImage<P>& image, P& pixel, unsigned int width, unsigned int height);
     /**
      * @brief 指定位置のピクセルを書き込みます。
      * @param image 入力画像
@@ -92,7 +138,8 @@ namespace kaf::domain::graphics2d{
      * @retval true 成功
      * @retval false 失敗（範囲外 等）
      */
-    bool setPixel(Image& image, const Pixel& pixel, unsigned int width, unsigned int height);
+    template<class P>
+    bool setPixel(BasicImage<P>& image, const P& pixel, unsigned int width, unsigned int height);
     /**
      * @brief ピクセルバッファから画像を生成します。
      * @param buffer ピクセル配列（所有権を移動）
@@ -100,7 +147,8 @@ namespace kaf::domain::graphics2d{
      * @param height 高さ[px]
      * @return 生成された画像（失敗時 nullptr）
      */
-    std::unique_ptr<Image> createImage(std::unique_ptr<PixelBuffer>&& buffer, size_t width, size_t height);
+    template<class P>
+    std::unique_ptr<BasicImage<P>> createImage(std::unique_ptr<BasicPixelBuffer<P>>&& buffer, size_t width, size_t height);
     /**
      * @brief ピクセルバッファをコピーして画像を生成します。
      * @param buffer 読み取り専用のピクセル配列
@@ -108,7 +156,8 @@ namespace kaf::domain::graphics2d{
      * @param height 高さ[px]
      * @return 生成された画像（失敗時 nullptr）
      */
-    std::unique_ptr<Image> copyImage(const PixelBuffer& buffer, size_t width, size_t height);
+    template<class P>
+    std::unique_ptr<BasicImage<P>> copyImage(const BasicPixelBuffer<P>& buffer, size_t width, size_t height);
 
     /**
      * @brief ピクセルバッファから画像を生成します。
@@ -117,7 +166,17 @@ namespace kaf::domain::graphics2d{
      * @param height 高さ[px]
      * @return 生成された画像（失敗時 nullptr）
      */
-    std::unique_ptr<Image> createImage(const std::vector<Pixel>& pixels, size_t width, size_t height);
+    template<class P>
+    std::unique_ptr<BasicImage<P>> createImage(const std::vector<P>& pixels, size_t width, size_t height);
+
+    /**
+     * @brief 画像のピクセル形式を変換します（例: BGR8 で読み込んだ画像を float で処理する）。
+     * @tparam To 変換先の形式
+     * @param image 入力画像
+     * @return 変換された画像（失敗時 nullptr）
+     */
+    template<class To, class From>
+    std::unique_ptr<BasicImage<To>> convertImage(const BasicImage<From>& image);
 
     bool createNewImage(const size_t width, const size_t height, const kaf::domain::graphics2d::Pixel& color);
 }
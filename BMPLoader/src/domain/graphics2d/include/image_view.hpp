@@ -0,0 +1,300 @@
+/**
+ * @file image_view.hpp
+ * @brief 既存のピクセル配列を参照する所有権なしの 2D ビュー（切り抜き、タイル分割）。
+ */
+#ifndef __IMAGE_VIEW_H__
+#define __IMAGE_VIEW_H__
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "image.hpp"
+#include "pixel.hpp"
+#include "pixel_buffer.hpp"
+#include "pixel_format.hpp"
+#include "pixel_span.hpp"
+
+namespace kaf::domain::graphics2d{
+    /**
+     * @class RowRange
+     * @brief ビューの各行を上から順に PixelSpan として返す範囲（範囲 for 用）。
+     * @tparam P ピクセル形式（読み取り専用は const P）
+     */
+    template<class P>
+    class RowRange{
+        using Byte = std::conditional_t<std::is_const_v<P>, const unsigned char, unsigned char>;
+    public:
+        class Iterator{
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = PixelSpan<P>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = PixelSpan<P>;
+
+            Iterator() = default;
+            Iterator(Byte* row, const std::ptrdiff_t rowStride, const size_t width)
+                : row_(row), rowStride_(rowStride), width_(width){}
+
+            PixelSpan<P> operator*() const { return PixelSpan<P>(reinterpret_cast<P*>(row_), width_); }
+            Iterator& operator++() { row_ += rowStride_; return *this; }
+            Iterator operator++(int) { Iterator previous = *this; ++*this; return previous; }
+            bool operator==(const Iterator& other) const { return row_ == other.row_; }
+            bool operator!=(const Iterator& other) const { return row_ != other.row_; }
+
+        private:
+            Byte* row_ = nullptr;
+            std::ptrdiff_t rowStride_{};
+            size_t width_{};
+        };
+
+        RowRange() = default;
+        RowRange(P* origin, const size_t width, const size_t height, const std::ptrdiff_t rowStride)
+            : first_(reinterpret_cast<Byte*>(origin), rowStride, width),
+              last_(reinterpret_cast<Byte*>(origin) + static_cast<std::ptrdiff_t>(height) * rowStride, rowStride, width){}
+
+        Iterator begin() const { return first_; }
+        Iterator end() const { return last_; }
+
+    private:
+        Iterator first_{};
+        Iterator last_{};
+    };
+
+    /**
+     * @class BasicImageView
+     * @brief 原点・幅・高さ・行ストライドで表す、ピクセル配列の部分領域への参照。
+     * @details ピクセルを所有せず、コピーは O(1) です。参照先の配列はビューより長く生存させてください。
+     *          行ストライドはバイト単位で、パディング付きの行（24bpp BMP 等）や負のストライド
+     *          （ボトムアップの行並び）も表せます。row / at は範囲を検証しません。
+     * @tparam P ピクセル形式。読み取り専用のビューは const P を指定します。
+     */
+    template<class P>
+    class BasicImageView{
+    public:
+        /** @brief ピクセル形式（const 修飾を含む）。 */
+        using PixelType = P;
+        /** @brief const 修飾を除いたピクセル形式。 */
+        using ValueType = std::remove_const_t<P>;
+
+        /** @brief 既定コンストラクタ。空のビューで初期化します。 */
+        BasicImageView() = default;
+
+        /**
+         * @brief ビューを生成します。
+         * @param origin 左上ピクセル
+         * @param width 幅[px]
+         * @param height 高さ[px]
+         * @param rowStride 次の行までのバイト数（負の値で上方向）
+         */
+        BasicImageView(P* origin, const size_t width, const size_t height, const std::ptrdiff_t rowStride)
+            : origin_(origin), width_(width), height_(height), rowStride_(rowStride){}
+
+        /** @brief 書き込み可能なビューから読み取り専用のビューへ変換します。 */
+        template<class Q, class = std::enable_if_t<std::is_same_v<const Q, P> && !std::is_same_v<Q, P>>>
+        BasicImageView(const BasicImageView<Q>& other)
+            : origin_(other.rowData(0)), width_(other.getWidth()), height_(other.getHeight()), rowStride_(other.getRowStride()){}
+
+        /** @brief ビューが有効か（原点あり、かつ幅・高さ>0）。 */
+        bool isValid() const { return origin_ != nullptr && width_ > 0 && height_ > 0; }
+
+        size_t getWidth() const { return width_; }
+        size_t getHeight() const { return height_; }
+        /** @brief 次の行までのバイト数。 */
+        std::ptrdiff_t getRowStride() const { return rowStride_; }
+        /** @brief 行が隙間なく上から順に並んでいるか（ビュー全体を 1 つの配列として扱えるか）。 */
+        bool isContiguous() const { return rowStride_ == static_cast<std::ptrdiff_t>(width_ * sizeof(P)); }
+
+        /**
+         * @brief 行を返します（範囲は検証しません）。
+         * @param height Y 座標（0 が最上行）
+         * @return width 個のピクセルが連続する行
+         */
+        PixelSpan<P> row(const size_t height) const { return PixelSpan<P>(rowData(height), width_); }
+
+        /** @brief 行の先頭ピクセル（範囲は検証しません）。 */
+        P* rowData(const size_t height) const {
+            using Byte = std::conditional_t<std::is_const_v<P>, const unsigned char, unsigned char>;
+            return reinterpret_cast<P*>(reinterpret_cast<Byte*>(origin_) + static_cast<std::ptrdiff_t>(height) * rowStride_);
+        }
+
+        /** @brief 全行を上から順に走査する範囲。 */
+        RowRange<P> rows() const { return isValid() ? RowRange<P>(origin_, width_, height_, rowStride_) : RowRange<P>(); }
+
+        /** @brief 指定位置のピクセル（範囲は検証しません）。 */
+        P& at(const size_t width, const size_t height) const { return rowData(height)[width]; }
+
+        /**
+         * @brief 指定位置のピクセルを返します。
+         * @return ピクセル（範囲外・無効時 nullptr）
+         */
+        P* getPixel(const size_t width, const size_t height) const {
+            if(!isValid() || width >= width_ || height >= height_){
+                return nullptr;
+            }
+            return &at(width, height);
+        }
+
+        /**
+         * @brief 部分領域のビューを返します（コピーしません）。
+         * @param x 左端
+         * @param y 上端
+         * @param width 幅[px]
+         * @param height 高さ[px]
+         * @return 部分領域のビュー（範囲外を含む場合は空のビュー）
+         */
+        BasicImageView subView(const size_t x, const size_t y, const size_t width, const size_t height) const {
+            if(!isValid() || x > width_ || y > height_ || width > width_ - x || height > height_ - y ||
+                width == 0 || height == 0){
+                return BasicImageView();
+            }
+            return BasicImageView(rowData(y) + x, width, height, rowStride_);
+        }
+
+    private:
+        /** 左上ピクセル */
+        P* origin_ = nullptr;
+        /** 幅[px] */
+        size_t width_{};
+        /** 高さ[px] */
+        size_t height_{};
+        /** 行ストライド[バイト] */
+        std::ptrdiff_t rowStride_{};
+    };
+
+    /** @brief float RGBA の書き込み可能なビュー。 */
+    using ImageView = BasicImageView<Pixel>;
+    /** @brief float RGBA の読み取り専用ビュー。 */
+    using ConstImageView = BasicImageView<const Pixel>;
+
+    /**
+     * @brief 画像全体の書き込み可能なビューを返します。
+     * @details ピクセルバッファが共有中であれば、この時点で複製されます（コピーオンライト）。
+     *          ビューの row / rowData は共有を確認しないため、書き込む行ループはこのビューを通して走査します。
+     * @return ビュー（画像が無効な場合は空のビュー）
+     */
+    template<class P>
+    BasicImageView<P> makeView(BasicImage<P>& image){
+        if(!image.isValid()){
+            return BasicImageView<P>();
+        }
+        return BasicImageView<P>(image.getPixelBuffer()->pixels_.get(), image.getWidth(), image.getHeight(),
+            static_cast<std::ptrdiff_t>(image.getWidth() * sizeof(P)));
+    }
+
+    /**
+     * @brief 画像全体の読み取り専用ビューを返します（共有中でも複製しません）。
+     * @return ビュー（画像が無効な場合は空のビュー）
+     */
+    template<class P>
+    BasicImageView<const P> makeView(const BasicImage<P>& image){
+        if(!image.isValid()){
+            return BasicImageView<const P>();
+        }
+        return BasicImageView<const P>(image.getPixelBuffer()->pixels_.get(), image.getWidth(), image.getHeight(),
+            static_cast<std::ptrdiff_t>(image.getWidth() * sizeof(P)));
+    }
+
+    /**
+     * @brief ピクセルバッファを幅×高さの画像として参照するビューを返します。
+     * @return ビュー（バッファが不足する場合は空のビュー）
+     */
+    template<class P>
+    BasicImageView<P> makeView(BasicPixelBuffer<P>& buffer, const size_t width, const size_t height){
+        const auto size = mul_size(width, height);
+        if(!buffer.isValid() || !size.has_value() || size.value() == 0 || size.value() > buffer.size_){
+            return BasicImageView<P>();
+        }
+        return BasicImageView<P>(buffer.pixels_.get(), width, height, static_cast<std::ptrdiff_t>(width * sizeof(P)));
+    }
+
+    /**
+     * @brief 画像の全行を上から順に走査する範囲を返します（書き込み用、共有中なら複製します）。
+     * @details 検証と複製はここで 1 回だけ行われ、各行へのアクセスは検証しません。
+     */
+    template<class P>
+    RowRange<P> rows(BasicImage<P>& image){
+        return makeView(image).rows();
+    }
+
+    /** @brief 画像の全行を上から順に走査する範囲を返します（読み取り用）。 */
+    template<class P>
+    RowRange<const P> rows(const BasicImage<P>& image){
+        return makeView(image).rows();
+    }
+
+    /**
+     * @brief ビューの全ピクセルに関数を適用します。
+     * @details fn は fn(pixel) または fn(pixel, x, y) の形で呼び出せるものを指定します。
+     *          検証はビュー単位で 1 回だけ行い、内側のループは行の単純な走査です。
+     * @param view 対象ビュー
+     * @param fn 各ピクセルに適用する関数
+     */
+    template<class P, class Fn>
+    void forEachPixel(const BasicImageView<P>& view, Fn&& fn){
+        if(!view.isValid()){
+            return;
+        }
+        const size_t width = view.getWidth();
+        for(size_t y = 0; y < view.getHeight(); ++y){
+            P* line = view.rowData(y);
+            if constexpr(std::is_invocable_v<Fn&, P&, size_t, size_t>){
+                for(size_t x = 0; x < width; ++x){
+                    fn(line[x], x, y);
+                }
+            }
+            else{
+                for(size_t x = 0; x < width; ++x){
+                    fn(line[x]);
+                }
+            }
+        }
+    }
+
+    /** @brief 画像の全ピクセルに関数を適用します（書き込み用、共有中なら複製します）。 */
+    template<class P, class Fn>
+    void forEachPixel(BasicImage<P>& image, Fn&& fn){
+        forEachPixel(makeView(image), std::forward<Fn>(fn));
+    }
+
+    /** @brief 画像の全ピクセルに関数を適用します（読み取り用）。 */
+    template<class P, class Fn>
+    void forEachPixel(const BasicImage<P>& image, Fn&& fn){
+        forEachPixel(makeView(image), std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief ビューを格子状のタイルに分割します（各タイルはコピーしないビュー）。
+     * @details 右端・下端のタイルは残りの幅・高さになります。タイルは行優先で並びます。
+     * @param view 分割するビュー
+     * @param tileWidth タイルの幅[px]
+     * @param tileHeight タイルの高さ[px]
+     * @return タイルの一覧（引数が無効な場合は空）
+     */
+    template<class P>
+    std::vector<BasicImageView<P>> splitTiles(const BasicImageView<P>& view, const size_t tileWidth, const size_t tileHeight);
+
+    /**
+     * @brief ビューの内容を同じサイズのビューへコピーします（行単位）。
+     * @param source 入力ビュー
+     * @param destination 出力ビュー
+     * @retval true 成功
+     * @retval false 失敗（サイズ不一致、無効なビュー）
+     */
+    template<class P>
+    bool copyPixels(const BasicImageView<const typename BasicImageView<P>::ValueType>& source, const BasicImageView<P>& destination);
+
+    /**
+     * @brief ビューの内容をコピーして画像を生成します（切り抜きの確定 等）。
+     * @param view 入力ビュー
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> createImage(const BasicImageView<const P>& view);
+}
+
+#endif
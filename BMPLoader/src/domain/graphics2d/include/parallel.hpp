@@ -0,0 +1,117 @@
+/**
+ * @file parallel.hpp
+ * @brief 画像の行・タイル単位の並列処理（ThreadPool 上で実行）。
+ */
+#ifndef __PARALLEL_H__
+#define __PARALLEL_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../common/include/thread_pool.hpp"
+#include "image.hpp"
+#include "image_view.hpp"
+#include "pixel_span.hpp"
+
+namespace kaf::domain::graphics2d{
+    /** @brief 1 タスクで処理する最小ピクセル数（これ未満の画像は分割せず呼び出し元で処理します）。 */
+    constexpr size_t PARALLEL_MIN_PIXELS_PER_TASK = 16 * 1024;
+    /** @brief parallelForTiles の既定のタイル一辺[px]。 */
+    constexpr size_t DEFAULT_TILE_SIZE = 256;
+
+    /**
+     * @brief 行単位の並列処理で 1 タスクが受け持つ行数を求めます。
+     * @details 1 タスクが PARALLEL_MIN_PIXELS_PER_TASK 以上を処理し、かつ並列度の 4 倍程度の
+     *          タスク数になるようにします（小さい画像は分割の手間を、大きい画像は偏りを抑えます）。
+     * @param width 幅[px]
+     * @param height 高さ[px]
+     * @param concurrency 並列度
+     * @return 1 タスク当たりの行数（1 以上）
+     */
+    inline size_t parallelRowGrain(const size_t width, const size_t height, const size_t concurrency){
+        const size_t minRows = (PARALLEL_MIN_PIXELS_PER_TASK + std::max<size_t>(1, width) - 1) / std::max<size_t>(1, width);
+        const size_t balancedRows = height / (std::max<size_t>(1, concurrency) * 4);
+        return std::max<size_t>(1, std::max(minRows, balancedRows));
+    }
+
+    /**
+     * @brief ビューの各行に関数を並列に適用します。
+     * @details fn は fn(PixelSpan<P> row, size_t y) の形で呼び出せるものを指定します。
+     *          各行は 1 回だけ、いずれかのスレッドで処理されます。行をまたいで書き込まないでください。
+     *          fn が送出した例外は呼び出し元へ再送出されます。
+     * @param view 対象ビュー
+     * @param fn 各行に適用する関数
+     * @param pool 実行するプール
+     */
+    template<class P, class Fn>
+    void parallelForRows(const BasicImageView<P>& view, Fn&& fn, common::ThreadPool& pool = common::ThreadPool::shared()){
+        if(!view.isValid()){
+            return;
+        }
+        const size_t grain = parallelRowGrain(view.getWidth(), view.getHeight(), pool.getConcurrency());
+        pool.parallelFor(0, view.getHeight(), grain, [&view, &fn](const size_t begin, const size_t end){
+            for(size_t y = begin; y < end; ++y){
+                fn(view.row(y), y);
+            }
+        });
+    }
+
+    /** @brief 画像の各行に関数を並列に適用します（書き込み用、共有中なら複製します）。 */
+    template<class P, class Fn>
+    void parallelForRows(BasicImage<P>& image, Fn&& fn, common::ThreadPool& pool = common::ThreadPool::shared()){
+        parallelForRows(makeView(image), std::forward<Fn>(fn), pool);
+    }
+
+    /** @brief 画像の各行に関数を並列に適用します（読み取り用）。 */
+    template<class P, class Fn>
+    void parallelForRows(const BasicImage<P>& image, Fn&& fn, common::ThreadPool& pool = common::ThreadPool::shared()){
+        parallelForRows(makeView(image), std::forward<Fn>(fn), pool);
+    }
+
+    /**
+     * @brief ビューをタイルに分割し、各タイルに関数を並列に適用します。
+     * @details fn は fn(const BasicImageView<P>& tile) の形で呼び出せるものを指定します。
+     *          タイル一辺を 0 にすると、幅・高さとも DEFAULT_TILE_SIZE とします。
+     *          PARALLEL_MIN_PIXELS_PER_TASK 未満の画像はタイルに分けたまま呼び出し元で処理します。
+     * @param view 対象ビュー
+     * @param fn 各タイルに適用する関数
+     * @param tileSize タイル一辺[px]
+     * @param pool 実行するプール
+     */
+    template<class P, class Fn>
+    void parallelForTiles(const BasicImageView<P>& view, Fn&& fn, const size_t tileSize = 0, common::ThreadPool& pool = common::ThreadPool::shared()){
+        const size_t size = tileSize == 0 ? DEFAULT_TILE_SIZE : tileSize;
+        const std::vector<BasicImageView<P>> tiles = splitTiles(view, size, size);
+        if(tiles.empty()){
+            return;
+        }
+        if(view.getWidth() * view.getHeight() < PARALLEL_MIN_PIXELS_PER_TASK){
+            for(const auto& tile : tiles){
+                fn(tile);
+            }
+            return;
+        }
+        pool.parallelFor(0, tiles.size(), 1, [&tiles, &fn](const size_t begin, const size_t end){
+            for(size_t idx = begin; idx < end; ++idx){
+                fn(tiles[idx]);
+            }
+        });
+    }
+
+    /** @brief 画像をタイルに分割し、各タイルに関数を並列に適用します（書き込み用、共有中なら複製します）。 */
+    template<class P, class Fn>
+    void parallelForTiles(BasicImage<P>& image, Fn&& fn, const size_t tileSize = 0, common::ThreadPool& pool = common::ThreadPool::shared()){
+        parallelForTiles(makeView(image), std::forward<Fn>(fn), tileSize, pool);
+    }
+
+    /** @brief 画像をタイルに分割し、各タイルに関数を並列に適用します（読み取り用）。 */
+    template<class P, class Fn>
+    void parallelForTiles(const BasicImage<P>& image, Fn&& fn, const size_t tileSize = 0, common::ThreadPool& pool = common::ThreadPool::shared()){
+        parallelForTiles(makeView(image), std::forward<Fn>(fn), tileSize, pool);
+    }
+}
+
+#endif
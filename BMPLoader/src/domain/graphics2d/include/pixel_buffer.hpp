@@ -6,30 +6,65 @@
 #define __PIXEL_BUFFER_H__
 
 #include <memory>
+#include <type_traits>
 #include <vector>
 #include "../include/pixel.hpp"
+#include "../include/pixel_format.hpp"
+#include "../include/pixel_buffer_pool.hpp"
 
 namespace kaf::domain::graphics2d{
     /**
-     * @struct PixelBuffer
+     * @struct UninitializedTag
+     * @brief 確保したピクセル配列を初期化しないことを示すタグ（全要素を直後に上書きする場合に使用）。
+     */
+    struct UninitializedTag{};
+    /** @brief 初期化を省略する確保の指定。 */
+    inline constexpr UninitializedTag UNINITIALIZED{};
+
+    /**
+     * @brief ピクセル配列の所有ポインタ。
+     * @details 先頭は PIXEL_BUFFER_ALIGNMENT に揃い、プールから確保した場合は破棄時にプールへ返却されます。
+     */
+    template<class P>
+    using PixelArray = std::unique_ptr<P[], PixelStorageDeleter>;
+
+    /**
+     * @struct BasicPixelBuffer
      * @brief 1 次元のピクセル配列を所有するバッファ。
      * @details 通常は画像の幅×高さの要素数を保持します。
+     *          配列の先頭は PIXEL_BUFFER_ALIGNMENT バイトに揃います。
+     * @tparam P ピクセル形式（Pixel, RGBA8, BGRA8, BGR8, Gray8）
      */
-    struct PixelBuffer{
+    template<class P>
+    struct BasicPixelBuffer{
+        static_assert(std::is_trivially_copyable_v<P> && std::is_trivially_destructible_v<P>,
+            "pixel formats must be trivially copyable");
+
         /**
          * @brief 指定サイズでバッファを確保し、指定色で初期化します。
          * @param size ピクセル数（幅×高さ）
          * @param pixel 既定色（既定: 白）
          */
-        PixelBuffer(const size_t size, const Pixel& pixel = Pixel(1.0f, 1.0f, 1.0f));
+        BasicPixelBuffer(const size_t size, const P& pixel = PixelFormat<P>::white());
+        /**
+         * @brief 指定サイズでバッファを確保します。要素は初期化しません。
+         * @details 呼び出し側が全要素を上書きする場合に、初期化の書き込みを省きます。
+         * @param size ピクセル数（幅×高さ）
+         * @param tag UNINITIALIZED
+         * @param pool 確保元プール（nullptr の場合はヒープから直接確保）
+         */
+        BasicPixelBuffer(const size_t size, UninitializedTag tag, PixelBufferPool* pool = nullptr);
         /** @brief バッファが有効か（サイズ>0 かつ配列あり）。 */
         bool isValid() const { return size_ > 0 && pixels_ != nullptr; }
         /** @brief 要素数（ピクセル数）。 */
         size_t size_{};
         /** @brief ピクセル配列。 */
-        std::unique_ptr<Pixel[]> pixels_{};
+        PixelArray<P> pixels_{};
     };
 
+    /** @brief float RGBA のピクセルバッファ。 */
+    using PixelBuffer = BasicPixelBuffer<Pixel>;
+
     /**
      * @brief 連続したピクセルをコピー（配列→バッファ）。
      * @param target 対象バッファ
@@ -39,7 +74,20 @@ namespace kaf::domain::graphics2d{
      * @retval true 成功
      * @retval false 失敗（範囲外 等）
      */
-    bool setPixels(PixelBuffer& target, const std::unique_ptr<Pixel[]>& pixelArray, const size_t size, const size_t startPos = 0);
+    template<class P>
+    bool setPixels(BasicPixelBuffer<P>& target, const std::unique_ptr<P[]>& pixelArray, const size_t size, const size_t startPos = 0);
+
+    /**
+     * @brief 連続したピクセルをコピー（バッファの配列→バッファ）。
+     * @param target 対象バッファ
+     * @param pixelArray 入力配列
+     * @param size コピーする要素数
+     * @param startPos 書き込み開始位置（既定 0）
+     * @retval true 成功
+     * @retval false 失敗（範囲外 等）
+     */
+    template<class P>
+    bool setPixels(BasicPixelBuffer<P>& target, const PixelArray<P>& pixelArray, const size_t size, const size_t startPos = 0);
 
     /**
      * @brief 連続したピクセルをコピー（vector→バッファ）。
@@ -49,7 +97,8 @@ namespace kaf::domain::graphics2d{
      * @retval true 成功
      * @retval false 失敗（範囲外 等）
      */
-    bool setPixels(PixelBuffer& target, const std::vector<Pixel>& pixelList, const size_t startPos = 0);
+    template<class P>
+    bool setPixels(BasicPixelBuffer<P>& target, const std::vector<P>& pixelList, const size_t startPos = 0);
 
     /**
      * @brief 1 要素を書き込み。
@@ -59,7 +108,8 @@ namespace kaf::domain::graphics2d{
      * @retval true 成功
      * @retval false 失敗（範囲外 等）
      */
-    bool setPixel(PixelBuffer& target, const Pixel& pixel, const size_t pos);
+    template<class P>
+    bool setPixel(BasicPixelBuffer<P>& target, const P& pixel, const size_t pos);
 
     /**
      * @brief 1 要素を読み出し。
@@ -69,7 +119,8 @@ namespace kaf::domain::graphics2d{
      * @retval true 成功
      * @retval false 失敗（範囲外 等）
      */
-    bool getPixel(const PixelBuffer& buffer, Pixel& pixel, const size_t pos);
+    template<class P>
+    bool getPixel(const BasicPixelBuffer<P>& buffer, P& pixel, const size_t pos);
 }
 
 #endif
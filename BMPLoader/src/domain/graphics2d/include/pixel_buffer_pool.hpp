@@ -0,0 +1,85 @@
+/**
+ * @file pixel_buffer_pool.hpp
+ * @brief ピクセル配列用のアライメント付きメモリ確保と、サイズ別の再利用プール。
+ */
+#ifndef __PIXEL_BUFFER_POOL_H__
+#define __PIXEL_BUFFER_POOL_H__
+
+#include <cstddef>
+#include <memory>
+
+namespace kaf::domain::graphics2d{
+    /** @brief ピクセル配列の先頭アライメント[バイト]（キャッシュライン、AVX-512 幅）。 */
+    constexpr size_t PIXEL_BUFFER_ALIGNMENT = 64;
+
+    /**
+     * @class PixelBufferPool
+     * @brief 解放されたピクセル配列をバイト数ごとに保持し、同サイズの確保で再利用するプール。
+     * @details 同じサイズの画像を連続して読み込む場合に、malloc とページフォールトのコストを省きます。
+     *          コピーしたハンドルは同じプールを共有し、プールから確保した配列が残っている間は
+     *          ハンドルを破棄してもプール本体は解放されません。スレッドセーフです。
+     */
+    class PixelBufferPool{
+    public:
+        struct State;
+
+        /**
+         * @brief プールを生成します。
+         * @param maxRetainedBytes 再利用のために保持する合計バイト数の上限（超過分は即時解放）
+         */
+        explicit PixelBufferPool(const size_t maxRetainedBytes = 256u * 1024u * 1024u);
+
+        /**
+         * @brief 指定バイト数の配列を確保します（保持中の同サイズ配列があれば再利用）。
+         * @param bytes バイト数（0 の場合は nullptr）
+         * @return PIXEL_BUFFER_ALIGNMENT に揃った未初期化の領域
+         */
+        void* acquire(const size_t bytes);
+
+        /**
+         * @brief 配列をプールへ返却します。上限を超える場合は解放します。
+         * @param storage acquire で確保した領域
+         * @param bytes 確保時のバイト数
+         */
+        void release(void* storage, const size_t bytes) noexcept;
+
+        /** @brief 保持している配列をすべて解放します。 */
+        void clear();
+
+        /** @brief 保持している配列の合計バイト数。 */
+        size_t getRetainedBytes() const;
+
+        /** @brief acquire が保持中の配列を再利用した回数。 */
+        size_t getReuseCount() const;
+
+        /** @brief 内部状態（配列の解放時にプールを参照するため共有します）。 */
+        const std::shared_ptr<State>& getState() const { return state_; }
+
+    private:
+        std::shared_ptr<State> state_;
+    };
+
+    /**
+     * @struct PixelStorageDeleter
+     * @brief allocatePixelStorage で確保した領域の解放処理（プール由来ならプールへ返却）。
+     */
+    struct PixelStorageDeleter{
+        /** @brief 確保したバイト数。 */
+        size_t bytes_{};
+        /** @brief 確保元プール（プール外の場合は nullptr）。 */
+        std::shared_ptr<PixelBufferPool::State> pool_{};
+
+        void operator()(void* storage) const noexcept;
+    };
+
+    /**
+     * @brief PIXEL_BUFFER_ALIGNMENT に揃った未初期化の領域を確保します。
+     * @param bytes バイト数
+     * @param pool 確保元プール（nullptr の場合はヒープから直接確保）
+     * @param deleter 確保した領域に対応する解放処理(出力)
+     * @return 確保した領域（bytes が 0 の場合は nullptr）
+     */
+    void* allocatePixelStorage(const size_t bytes, PixelBufferPool* pool, PixelStorageDeleter& deleter);
+}
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file pixel_convert.hpp
+ * @brief 8bit BGR(A) 行と Pixel（float RGBA）行の一括変換カーネル。
+ * @details SSE2/AVX2/NEON の実装とスカラー実装を持ち、実行時に CPU 機能を判定して選択します。
+ *          いずれの実装も結果はスカラー実装とビット単位で一致します。
+ */
+#ifndef __PIXEL_CONVERT_H__
+#define __PIXEL_CONVERT_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pixel.hpp"
+
+namespace kaf::domain::graphics2d{
+    /**
+     * @enum SimdLevel
+     * @brief 変換カーネルの命令セット。
+     */
+    enum class SimdLevel{
+        Scalar,
+        SSE2,
+        AVX2,
+        NEON,
+    };
+
+    /**
+     * @struct PixelConvertKernels
+     * @brief 変換カーネルの関数テーブル。
+     * @details 8bit → float は value / 255、float → 8bit は [0, 1] にクランプ後 255 倍して四捨五入します
+     *          （NaN は 0）。count はピクセル数です。
+     */
+    struct PixelConvertKernels{
+        /** @brief 使用している命令セット。 */
+        SimdLevel level_;
+        /** @brief BGR8（3 バイト）→ Pixel。アルファは 1.0。 */
+        void (*bgr8ToPixel_)(const std::uint8_t* source, Pixel* destination, size_t count);
+        /** @brief BGRX8（4 バイト）→ Pixel。4 バイト目は無視し、アルファは 1.0。 */
+        void (*bgrx8ToPixel_)(const std::uint8_t* source, Pixel* destination, size_t count);
+        /** @brief BGRA8（4 バイト）→ Pixel。 */
+        void (*bgra8ToPixel_)(const std::uint8_t* source, Pixel* destination, size_t count);
+        /** @brief Pixel → BGR8（3 バイト）。アルファは書き出しません。 */
+        void (*pixelToBgr8_)(const Pixel* source, std::uint8_t* destination, size_t count);
+        /** @brief Pixel → BGRA8（4 バイト）。 */
+        void (*pixelToBgra8_)(const Pixel* source, std::uint8_t* destination, size_t count);
+    };
+
+    /**
+     * @brief 実行中の CPU で使用できる最上位の命令セットを返します。
+     */
+    SimdLevel detectSimdLevel();
+
+    /**
+     * @brief 命令セットが実行中の CPU とビルドで使用できるかを返します。
+     */
+    bool isSimdLevelSupported(const SimdLevel level);
+
+    /**
+     * @brief 指定した命令セットのカーネルを返します。
+     * @details 使用できない命令セットを指定した場合はスカラー実装を返します。
+     */
+    const PixelConvertKernels& getPixelConvertKernels(const SimdLevel level);
+
+    /**
+     * @brief detectSimdLevel() で選ばれたカーネルを返します（初回呼び出し時に判定）。
+     */
+    const PixelConvertKernels& getPixelConvertKernels();
+
+    /** @brief 命令セット名（"scalar", "sse2", "avx2", "neon"）を返します。 */
+    const char* toString(const SimdLevel level);
+
+    inline void convertBgr8ToPixel(const std::uint8_t* source, Pixel* destination, size_t count){
+        getPixelConvertKernels().bgr8ToPixel_(source, destination, count);
+    }
+    inline void convertBgrx8ToPixel(const std::uint8_t* source, Pixel* destination, size_t count){
+        getPixelConvertKernels().bgrx8ToPixel_(source, destination, count);
+    }
+    inline void convertBgra8ToPixel(const std::uint8_t* source, Pixel* destination, size_t count){
+        getPixelConvertKernels().bgra8ToPixel_(source, destination, count);
+    }
+    inline void convertPixelToBgr8(const Pixel* source, std::uint8_t* destination, size_t count){
+        getPixelConvertKernels().pixelToBgr8_(source, destination, count);
+    }
+    inline void convertPixelToBgra8(const Pixel* source, std::uint8_t* destination, size_t count){
+        getPixelConvertKernels().pixelToBgra8_(source, destination, count);
+    }
+}
+
+#endif
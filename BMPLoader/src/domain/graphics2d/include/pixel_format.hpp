@@ -0,0 +1,122 @@
+/**
+ * @file pixel_format.hpp
+ * @brief コンパクトなピクセル形式（8bit 整数）と形式間の変換。
+ */
+#ifndef __PIXEL_FORMAT_H__
+#define __PIXEL_FORMAT_H__
+
+#include <algorithm>
+#include <cstdint>
+
+#include "pixel.hpp"
+
+namespace kaf::domain::graphics2d{
+    /** @brief 正規化 float RGBA（既存の Pixel、16 バイト）。 */
+    using RGBAf32 = Pixel;
+
+    /**
+     * @struct RGBA8
+     * @brief 8bit RGBA ピクセル（4 バイト）。
+     */
+    struct RGBA8{
+        std::uint8_t r_, g_, b_, a_;
+    };
+
+    /**
+     * @struct BGRA8
+     * @brief 8bit BGRA ピクセル（4 バイト、32bpp BMP と同じ並び）。
+     */
+    struct BGRA8{
+        std::uint8_t b_, g_, r_, a_;
+    };
+
+    /**
+     * @struct BGR8
+     * @brief 8bit BGR ピクセル（3 バイト、24bpp BMP と同じ並び）。
+     */
+    struct BGR8{
+        std::uint8_t b_, g_, r_;
+    };
+
+    /**
+     * @struct Gray8
+     * @brief 8bit グレースケールピクセル（1 バイト）。
+     */
+    struct Gray8{
+        std::uint8_t v_;
+    };
+
+    static_assert(sizeof(RGBA8) == 4 && sizeof(BGRA8) == 4 && sizeof(BGR8) == 3 && sizeof(Gray8) == 1,
+        "8bit pixel formats must be tightly packed");
+
+    /** @brief 0.0〜1.0 の値を 0〜255 に丸めて変換します（範囲外はクランプ、NaN は 0）。 */
+    inline std::uint8_t unitToByte(const float value){
+        const float clamped = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+        return static_cast<std::uint8_t>(clamped * 255.0f + 0.5f);
+    }
+
+    /** @brief 0〜255 の値を 0.0〜1.0 に変換します。 */
+    inline float byteToUnit(const std::uint8_t value){
+        return static_cast<float>(value) / 255.0f;
+    }
+
+    /** @brief RGB から輝度（BT.601、8bit 固定小数点）を求めます。 */
+    inline std::uint8_t lumaOf(const std::uint8_t r, const std::uint8_t g, const std::uint8_t b){
+        return static_cast<std::uint8_t>((77u * r + 150u * g + 29u * b + 128u) >> 8);
+    }
+
+    /**
+     * @struct PixelFormat
+     * @brief ピクセル形式ごとの既定色と Pixel（float RGBA）との相互変換。
+     * @tparam P ピクセル形式
+     */
+    template<class P>
+    struct PixelFormat;
+
+    template<>
+    struct PixelFormat<Pixel>{
+        static Pixel white() { return Pixel(1.0f, 1.0f, 1.0f); }
+        static Pixel toPixel(const Pixel& pixel) { return pixel; }
+        static Pixel fromPixel(const Pixel& pixel) { return pixel; }
+    };
+
+    template<>
+    struct PixelFormat<RGBA8>{
+        static RGBA8 white() { return RGBA8{255, 255, 255, 255}; }
+        static Pixel toPixel(const RGBA8& pixel) { return Pixel(byteToUnit(pixel.r_), byteToUnit(pixel.g_), byteToUnit(pixel.b_), byteToUnit(pixel.a_)); }
+        static RGBA8 fromPixel(const Pixel& pixel) { return RGBA8{unitToByte(pixel.r_), unitToByte(pixel.g_), unitToByte(pixel.b_), unitToByte(pixel.a_)}; }
+    };
+
+    template<>
+    struct PixelFormat<BGRA8>{
+        static BGRA8 white() { return BGRA8{255, 255, 255, 255}; }
+        static Pixel toPixel(const BGRA8& pixel) { return Pixel(byteToUnit(pixel.r_), byteToUnit(pixel.g_), byteToUnit(pixel.b_), byteToUnit(pixel.a_)); }
+        static BGRA8 fromPixel(const Pixel& pixel) { return BGRA8{unitToByte(pixel.b_), unitToByte(pixel.g_), unitToByte(pixel.r_), unitToByte(pixel.a_)}; }
+    };
+
+    template<>
+    struct PixelFormat<BGR8>{
+        static BGR8 white() { return BGR8{255, 255, 255}; }
+        static Pixel toPixel(const BGR8& pixel) { return Pixel(byteToUnit(pixel.r_), byteToUnit(pixel.g_), byteToUnit(pixel.b_)); }
+        static BGR8 fromPixel(const Pixel& pixel) { return BGR8{unitToByte(pixel.b_), unitToByte(pixel.g_), unitToByte(pixel.r_)}; }
+    };
+
+    template<>
+    struct PixelFormat<Gray8>{
+        static Gray8 white() { return Gray8{255}; }
+        static Pixel toPixel(const Gray8& pixel) { const float value = byteToUnit(pixel.v_); return Pixel(value, value, value); }
+        static Gray8 fromPixel(const Pixel& pixel) { return Gray8{lumaOf(unitToByte(pixel.r_), unitToByte(pixel.g_), unitToByte(pixel.b_))}; }
+    };
+
+    /**
+     * @brief ピクセル形式を変換します（Pixel を経由）。
+     * @tparam To 変換先の形式
+     * @tparam From 変換元の形式
+     */
+    template<class To, class From>
+    To convertPixel(const From& pixel){
+        return PixelFormat<To>::fromPixel(PixelFormat<From>::toPixel(pixel));
+    }
+}
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file pixel_span.hpp
+ * @brief 連続したピクセル列（1 行分 等）への所有権なしの参照。
+ */
+#ifndef __PIXEL_SPAN_H__
+#define __PIXEL_SPAN_H__
+
+#include <cstddef>
+
+namespace kaf::domain::graphics2d{
+    /**
+     * @class PixelSpan
+     * @brief 先頭ポインタと要素数で表すピクセル列（std::span の代替）。
+     * @details 範囲は検証しません。内側のループを単純なポインタ走査にし、自動ベクトル化を妨げないためのものです。
+     * @tparam P ピクセル形式（読み取り専用は const P）
+     */
+    template<class P>
+    class PixelSpan{
+    public:
+        PixelSpan() = default;
+        PixelSpan(P* data, const size_t size): data_(data), size_(size){}
+
+        P* data() const { return data_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        P* begin() const { return data_; }
+        P* end() const { return data_ + size_; }
+        P& operator[](const size_t index) const { return data_[index]; }
+
+    private:
+        /** 先頭要素 */
+        P* data_ = nullptr;
+        /** 要素数 */
+        size_t size_{};
+    };
+}
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file pixel_vec4.hpp
+ * @brief Pixel 1 個（float×4）を 1 本の SIMD レジスタとして扱う演算（SSE2 / NEON / スカラー）。
+ * @details フィルタ処理の内側のループ用です。x86-64 と AArch64 では基本命令セットだけを使うため、
+ *          実行時の判定は不要です。
+ */
+#ifndef __PIXEL_VEC4_H__
+#define __PIXEL_VEC4_H__
+
+#include "pixel.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define KAF_PIXEL_VEC4_SSE 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define KAF_PIXEL_VEC4_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace kaf::domain::graphics2d::simd{
+    static_assert(sizeof(Pixel) == 4 * sizeof(float), "Pixel must be four packed floats");
+
+#if defined(KAF_PIXEL_VEC4_SSE)
+    using Vec4 = __m128;
+    inline Vec4 zero4(){ return _mm_setzero_ps(); }
+    inline Vec4 load4(const Pixel& pixel){ return _mm_loadu_ps(&pixel.r_); }
+    inline void store4(Pixel& pixel, const Vec4 value){ _mm_storeu_ps(&pixel.r_, value); }
+    inline Vec4 add4(const Vec4 left, const Vec4 right){ return _mm_add_ps(left, right); }
+    inline Vec4 sub4(const Vec4 left, const Vec4 right){ return _mm_sub_ps(left, right); }
+    inline Vec4 mul4(const Vec4 value, const float scale){ return _mm_mul_ps(value, _mm_set1_ps(scale)); }
+    inline Vec4 set4(const float value){ return _mm_set1_ps(value); }
+    /** @brief 成分ごとの積 */
+    inline Vec4 mulv4(const Vec4 left, const Vec4 right){ return _mm_mul_ps(left, right); }
+    inline Vec4 min4(const Vec4 left, const Vec4 right){ return _mm_min_ps(left, right); }
+    /** @brief アルファ成分を全成分へ複製します。 */
+    inline Vec4 alpha4(const Vec4 value){ return _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3)); }
+    /** @brief sum + value * weight */
+    inline Vec4 madd4(const Vec4 sum, const Vec4 value, const float weight){ return _mm_add_ps(sum, _mm_mul_ps(value, _mm_set1_ps(weight))); }
+#elif defined(KAF_PIXEL_VEC4_NEON)
+    using Vec4 = float32x4_t;
+    inline Vec4 zero4(){ return vdupq_n_f32(0.0f); }
+    inline Vec4 load4(const Pixel& pixel){ return vld1q_f32(&pixel.r_); }
+    inline void store4(Pixel& pixel, const Vec4 value){ vst1q_f32(&pixel.r_, value); }
+    inline Vec4 add4(const Vec4 left, const Vec4 right){ return vaddq_f32(left, right); }
+    inline Vec4 sub4(const Vec4 left, const Vec4 right){ return vsubq_f32(left, right); }
+    inline Vec4 mul4(const Vec4 value, const float scale){ return vmulq_n_f32(value, scale); }
+    inline Vec4 set4(const float value){ return vdupq_n_f32(value); }
+    /** @brief 成分ごとの積 */
+    inline Vec4 mulv4(const Vec4 left, const Vec4 right){ return vmulq_f32(left, right); }
+    inline Vec4 min4(const Vec4 left, const Vec4 right){ return vminq_f32(left, right); }
+    /** @brief アルファ成分を全成分へ複製します。 */
+    inline Vec4 alpha4(const Vec4 value){ return vdupq_laneq_f32(value, 3); }
+    /** @brief sum + value * weight */
+    inline Vec4 madd4(const Vec4 sum, const Vec4 value, const float weight){ return vmlaq_n_f32(sum, value, weight); }
+#else
+    struct Vec4{ float v_[4]; };
+    inline Vec4 zero4(){ return Vec4{{0.0f, 0.0f, 0.0f, 0.0f}}; }
+    inline Vec4 load4(const Pixel& pixel){ return Vec4{{pixel.r_, pixel.g_, pixel.b_, pixel.a_}}; }
+    inline void store4(Pixel& pixel, const Vec4 value){ pixel.r_ = value.v_[0]; pixel.g_ = value.v_[1]; pixel.b_ = value.v_[2]; pixel.a_ = value.v_[3]; }
+    inline Vec4 add4(Vec4 left, const Vec4 right){
+        for(int idx = 0; idx < 4; ++idx){
+            left.v_[idx] += right.v_[idx];
+        }
+        return left;
+    }
+    inline Vec4 sub4(Vec4 left, const Vec4 right){
+        for(int idx = 0; idx < 4; ++idx){
+            left.v_[idx] -= right.v_[idx];
+        }
+        return left;
+    }
+    inline Vec4 mul4(Vec4 value, const float scale){
+        for(int idx = 0; idx < 4; ++idx){
+            value.v_[idx] *= scale;
+        }
+        return value;
+    }
+    inline Vec4 set4(const float value){ return Vec4{{value, value, value, value}}; }
+    /** @brief 成分ごとの積 */
+    inline Vec4 mulv4(Vec4 left, const Vec4 right){
+        for(int idx = 0; idx < 4; ++idx){
+            left.v_[idx] *= right.v_[idx];
+        }
+        return left;
+    }
+    inline Vec4 min4(Vec4 left, const Vec4 right){
+        for(int idx = 0; idx < 4; ++idx){
+            left.v_[idx] = right.v_[idx] < left.v_[idx] ? right.v_[idx] : left.v_[idx];
+        }
+        return left;
+    }
+    /** @brief アルファ成分を全成分へ複製します。 */
+    inline Vec4 alpha4(const Vec4 value){ return set4(value.v_[3]); }
+    /** @brief sum + value * weight */
+    inline Vec4 madd4(Vec4 sum, const Vec4 value, const float weight){
+        for(int idx = 0; idx < 4; ++idx){
+            sum.v_[idx] += value.v_[idx] * weight;
+        }
+        return sum;
+    }
+#endif
+}
+
+#endif
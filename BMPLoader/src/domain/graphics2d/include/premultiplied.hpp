@@ -0,0 +1,60 @@
+/**
+ * @file premultiplied.hpp
+ * @brief アルファ乗算済み（premultiplied）の float RGBA との相互変換。
+ * @details 補間・畳み込み・合成は乗算済みの値で行うことで、透明部分の色がにじみ出ません。
+ */
+#ifndef __PREMULTIPLIED_H__
+#define __PREMULTIPLIED_H__
+
+#include <cstddef>
+
+#include "pixel.hpp"
+#include "pixel_format.hpp"
+
+namespace kaf::domain::graphics2d{
+    /** @brief 値を [0, 1] にクランプします（NaN は 0）。 */
+    inline float clampUnit(const float value){
+        return value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+    }
+
+    /** @brief RGB にアルファを乗算します。 */
+    inline Pixel premultiply(Pixel pixel){
+        pixel.r_ *= pixel.a_;
+        pixel.g_ *= pixel.a_;
+        pixel.b_ *= pixel.a_;
+        return pixel;
+    }
+
+    /** @brief 乗算済みの RGB をアルファで割り戻し、各成分を [0, 1] にクランプします（アルファ 0 は黒）。 */
+    inline Pixel unpremultiply(Pixel pixel){
+        const float alpha = clampUnit(pixel.a_);
+        const float scale = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+        pixel.r_ = clampUnit(pixel.r_ * scale);
+        pixel.g_ = clampUnit(pixel.g_ * scale);
+        pixel.b_ = clampUnit(pixel.b_ * scale);
+        pixel.a_ = alpha;
+        return pixel;
+    }
+
+    /**
+     * @brief ピクセル列を乗算済みの Pixel 列へ変換します。
+     * @tparam P ピクセル形式（Pixel, RGBA8, BGRA8, BGR8, Gray8）
+     * @param source 入力（width 要素）
+     * @param destination 出力（width 要素）
+     * @param width 要素数
+     */
+    template<class P>
+    void loadPremultipliedRow(const P* source, Pixel* destination, const size_t width);
+
+    /**
+     * @brief 乗算済みの Pixel 列を割り戻し、クランプして出力形式へ変換します。
+     * @tparam P ピクセル形式（Pixel, RGBA8, BGRA8, BGR8, Gray8）
+     * @param source 入力（width 要素）
+     * @param destination 出力（width 要素）
+     * @param width 要素数
+     */
+    template<class P>
+    void storeUnpremultipliedRow(const Pixel* source, P* destination, const size_t width);
+}
+
+#endif
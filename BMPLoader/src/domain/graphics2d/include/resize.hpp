@@ -0,0 +1,62 @@
+/**
+ * @file resize.hpp
+ * @brief 分離可能フィルタによる画像の拡大・縮小（最近傍、バイリニア、バイキュービック、Lanczos3）。
+ */
+#ifndef __RESIZE_H__
+#define __RESIZE_H__
+
+#include <cstddef>
+#include <memory>
+
+#include "../../common/include/thread_pool.hpp"
+#include "image.hpp"
+#include "image_view.hpp"
+
+namespace kaf::domain::graphics2d{
+    /** @brief リサイズに用いる補間フィルタ。 */
+    enum class ResizeFilter{
+        /** 最近傍（ピクセルをそのままコピー） */
+        Nearest,
+        /** バイリニア（三角フィルタ、半径 1） */
+        Bilinear,
+        /** バイキュービック（a = -0.5、半径 2） */
+        Bicubic,
+        /** Lanczos（半径 3） */
+        Lanczos3,
+    };
+
+    /** @brief フィルタ名（"nearest" 等）。 */
+    const char* toString(const ResizeFilter filter);
+
+    /**
+     * @brief ビューの内容を出力ビューのサイズへリサイズします。
+     * @details 最近傍以外は、出力ピクセルごとの重みを事前に計算し、水平方向→垂直方向の 2 パスで
+     *          畳み込みます。縮小時はフィルタ半径を縮小率に合わせて広げます（エイリアシング防止）。
+     *          補間はアルファで乗算済みの float RGBA で行い、出力時に [0, 1] へクランプします。
+     *          各パスは行の帯単位で pool 上で並列に処理します。
+     * @param source 入力ビュー
+     * @param destination 出力ビュー（入力と重ならないこと）
+     * @param filter 補間フィルタ
+     * @param pool 実行するプール
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー）
+     */
+    template<class P>
+    bool resizeView(const BasicImageView<const P>& source, const BasicImageView<P>& destination,
+        const ResizeFilter filter = ResizeFilter::Bilinear, common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 画像をリサイズした新しい画像を生成します。
+     * @param source 入力画像
+     * @param width 出力の幅[px]
+     * @param height 出力の高さ[px]
+     * @param filter 補間フィルタ
+     * @param pool 実行するプール
+     * @return 生成された画像（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<BasicImage<P>> resizeImage(const BasicImage<P>& source, const size_t width, const size_t height,
+        const ResizeFilter filter = ResizeFilter::Bilinear, common::ThreadPool& pool = common::ThreadPool::shared());
+}
+
+#endif
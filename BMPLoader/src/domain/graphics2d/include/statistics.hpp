@@ -0,0 +1,123 @@
+/**
+ * @file statistics.hpp
+ * @brief 画像の統計（チャンネルごとのヒストグラム・最小・最大・平均・標準偏差・パーセンタイル）と自動レベル補正。
+ */
+#ifndef __STATISTICS_H__
+#define __STATISTICS_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "../../common/include/thread_pool.hpp"
+#include "image.hpp"
+#include "image_view.hpp"
+
+namespace kaf::domain::graphics2d{
+    /** @brief 統計のチャンネル（ChannelStatistics の添字）。 */
+    enum class StatisticsChannel{
+        Red,
+        Green,
+        Blue,
+        Alpha,
+    };
+
+    /** @brief ヒストグラムのビン数（8bit の値ごと）。 */
+    constexpr size_t HISTOGRAM_BINS = 256;
+
+    /**
+     * @struct ChannelStatistics
+     * @brief 1 チャンネルの統計。値は 0.0〜1.0 に正規化しています（8bit 形式では 値 / 255）。
+     */
+    struct ChannelStatistics{
+        float min_{};
+        float max_{};
+        float mean_{};
+        /** 標準偏差（母標準偏差） */
+        float stddev_{};
+        /** 値を 8bit に丸めたヒストグラム */
+        std::array<std::uint64_t, HISTOGRAM_BINS> histogram_{};
+
+        /**
+         * @brief パーセンタイルをヒストグラムから求めます（最近接順位法、精度は 1/255）。
+         * @param fraction 0.0〜1.0 の割合（0.5 で中央値）
+         * @return 値（標本が無い場合は 0）
+         */
+        float percentile(const double fraction) const;
+    };
+
+    /**
+     * @struct ImageStatistics
+     * @brief 画像全体（または間引いた標本）の統計。
+     */
+    struct ImageStatistics{
+        /** 標本にしたピクセル数 */
+        size_t sampleCount_{};
+        /** R, G, B, A の順（StatisticsChannel で引きます） */
+        std::array<ChannelStatistics, 4> channels_{};
+
+        const ChannelStatistics& channel(const StatisticsChannel channel) const {
+            return channels_[static_cast<size_t>(channel)];
+        }
+    };
+
+    /**
+     * @brief 統計を 1 回の並列走査で求めます。
+     * @details 行帯ごとにタスクローカルのヒストグラムへ集計し、最後にまとめます。
+     *          8bit 形式では最小・最大・平均・標準偏差もヒストグラムから求め、内側のループはビンの加算だけです。
+     *          sampleStep > 1 では縦横 sampleStep ピクセルおきの格子だけを標本にした近似値になります。
+     * @param source 入力ビュー
+     * @param sampleStep 標本の間隔[px]（1 で全ピクセル）
+     * @param pool 実行するプール
+     * @return 統計（失敗時 nullptr）
+     */
+    template<class P>
+    std::unique_ptr<ImageStatistics> computeStatistics(const BasicImageView<const P>& source, const size_t sampleStep = 1,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /** @brief 画像の統計を求めます（失敗時 nullptr）。 */
+    template<class P>
+    std::unique_ptr<ImageStatistics> computeStatistics(const BasicImage<P>& source, const size_t sampleStep = 1,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 自動レベル補正。R, G, B をチャンネルごとに、下位・上位 clip の割合を除いた範囲が 0〜1 になるよう伸長します。
+     * @details 8bit 形式では 256 要素の変換表を引いて書き換えます。アルファはそのままです。
+     *          範囲が潰れているチャンネル（単色など）は変更しません。
+     * @param view 対象のビュー
+     * @param clip 両端で切り捨てる割合（0.0〜0.5 未満）
+     * @param sampleStep 統計の標本の間隔[px]
+     * @param pool 実行するプール
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー、不正な clip）
+     */
+    template<class P>
+    bool autoLevels(const BasicImageView<P>& view, const float clip = 0.005f, const size_t sampleStep = 1,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /**
+     * @brief 自動コントラスト。R, G, B をまとめたヒストグラムから 1 つの範囲を求め、全チャンネルを同じ変換で伸長します（色相を保ちます）。
+     * @retval true 成功
+     * @retval false 失敗（無効なビュー、不正な clip）
+     */
+    template<class P>
+    bool autoContrast(const BasicImageView<P>& view, const float clip = 0.005f, const size_t sampleStep = 1,
+        common::ThreadPool& pool = common::ThreadPool::shared());
+
+    /** @brief 画像を自動レベル補正します（共有中なら複製してから書き換えます）。 */
+    template<class P>
+    bool autoLevels(BasicImage<P>& image, const float clip = 0.005f, const size_t sampleStep = 1,
+        common::ThreadPool& pool = common::ThreadPool::shared()){
+        return autoLevels(makeView(image), clip, sampleStep, pool);
+    }
+
+    /** @brief 画像を自動コントラスト補正します（共有中なら複製してから書き換えます）。 */
+    template<class P>
+    bool autoContrast(BasicImage<P>& image, const float clip = 0.005f, const size_t sampleStep = 1,
+        common::ThreadPool& pool = common::ThreadPool::shared()){
+        return autoContrast(makeView(image), clip, sampleStep, pool);
+    }
+}
+
+#endif
@@ -0,0 +1,424 @@
+/**
+ * @file colorspace.cpp
+ * @brief 色空間の変換の実装。
+ * @details べき乗は x^p = 2^(p * log2(x)) とし、log2 は仮数を [√½, √2) に寄せた atanh 級数、
+ *          2^f は |f| <= 0.5 の Taylor 展開で求めます（いずれも分岐なしで SIMD 化できます）。
+ *          YCbCr は 16bit 固定小数点の整数演算です。
+ */
+#include "../include/colorspace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "../include/image_view.hpp"
+#include "../include/parallel.hpp"
+#include "../include/pixel_buffer.hpp"
+#include "../include/premultiplied.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define KAF_COLORSPACE_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace kaf::domain::graphics2d{
+    namespace {
+        constexpr float SQRT2 = 1.41421356237f;
+        // log2(m) = 2 / ln2 * atanh(t)、t = (m - 1) / (m + 1)
+        constexpr float LOG2_C1 = 2.88539008178f;
+        constexpr float LOG2_C3 = 0.961796693926f;
+        constexpr float LOG2_C5 = 0.577078016356f;
+        constexpr float LOG2_C7 = 0.412198583111f;
+        // 2^f = Σ (f ln2)^n / n!
+        constexpr float EXP2_C1 = 0.693147180560f;
+        constexpr float EXP2_C2 = 0.240226506959f;
+        constexpr float EXP2_C3 = 0.0555041086648f;
+        constexpr float EXP2_C4 = 0.00961812910763f;
+        constexpr float EXP2_C5 = 0.00133335581464f;
+        constexpr float EXP2_C6 = 0.000154035303934f;
+
+        constexpr float SRGB_DECODE_KNEE = 0.04045f;
+        constexpr float SRGB_ENCODE_KNEE = 0.0031308f;
+
+        // ---- スカラー ----
+        inline float fastLog2(const float value){
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            float exponent = static_cast<float>(static_cast<int>((bits >> 23) & 0xffu) - 127);
+            bits = (bits & 0x007fffffu) | 0x3f800000u;
+            float mantissa;
+            std::memcpy(&mantissa, &bits, sizeof(mantissa));
+            if(mantissa > SQRT2){
+                mantissa *= 0.5f;
+                exponent += 1.0f;
+            }
+            const float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+            const float t2 = t * t;
+            return exponent + t * (LOG2_C1 + t2 * (LOG2_C3 + t2 * (LOG2_C5 + t2 * LOG2_C7)));
+        }
+
+        inline float fastExp2(float value){
+            value = value < -126.0f ? -126.0f : (value > 126.0f ? 126.0f : value);
+            const float whole = std::nearbyint(value);
+            const float f = value - whole;
+            const float poly = 1.0f + f * (EXP2_C1 + f * (EXP2_C2 + f * (EXP2_C3 + f * (EXP2_C4 + f * (EXP2_C5 + f * EXP2_C6)))));
+            const std::uint32_t bits = static_cast<std::uint32_t>(static_cast<int>(whole) + 127) << 23;
+            float scale;
+            std::memcpy(&scale, &bits, sizeof(scale));
+            return poly * scale;
+        }
+
+        inline float fastPow(const float base, const float exponent){
+            return fastExp2(exponent * fastLog2(base));
+        }
+
+        inline float decodeSrgb(const float value){
+            const float x = clampUnit(value);
+            return x <= SRGB_DECODE_KNEE ? x * (1.0f / 12.92f) : fastPow((x + 0.055f) * (1.0f / 1.055f), 2.4f);
+        }
+
+        inline float encodeSrgb(const float value){
+            const float x = clampUnit(value);
+            return x <= SRGB_ENCODE_KNEE ? x * 12.92f : 1.055f * fastPow(x, 1.0f / 2.4f) - 0.055f;
+        }
+
+#if defined(KAF_COLORSPACE_SSE)
+        // ---- SSE2（Pixel 1 個分、アルファ成分も計算してから元に戻します） ----
+        inline __m128 select(const __m128 mask, const __m128 whenTrue, const __m128 whenFalse){
+            return _mm_or_ps(_mm_and_ps(mask, whenTrue), _mm_andnot_ps(mask, whenFalse));
+        }
+
+        inline __m128 clampUnit4(const __m128 value){
+            // max(NaN, 0) は 0 になる
+            return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        }
+
+        inline __m128 fastLog2x4(const __m128 value){
+            const __m128i bits = _mm_castps_si128(value);
+            const __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+            __m128 mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+            const __m128 large = _mm_cmpgt_ps(mantissa, _mm_set1_ps(SQRT2));
+            mantissa = select(large, _mm_mul_ps(mantissa, _mm_set1_ps(0.5f)), mantissa);
+            const __m128 whole = _mm_add_ps(_mm_cvtepi32_ps(exponent), _mm_and_ps(large, _mm_set1_ps(1.0f)));
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 t = _mm_div_ps(_mm_sub_ps(mantissa, one), _mm_add_ps(mantissa, one));
+            const __m128 t2 = _mm_mul_ps(t, t);
+            __m128 poly = _mm_add_ps(_mm_set1_ps(LOG2_C5), _mm_mul_ps(t2, _mm_set1_ps(LOG2_C7)));
+            poly = _mm_add_ps(_mm_set1_ps(LOG2_C3), _mm_mul_ps(t2, poly));
+            poly = _mm_add_ps(_mm_set1_ps(LOG2_C1), _mm_mul_ps(t2, poly));
+            return _mm_add_ps(whole, _mm_mul_ps(t, poly));
+        }
+
+        inline __m128 fastExp2x4(__m128 value){
+            value = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-126.0f)), _mm_set1_ps(126.0f));
+            const __m128i whole = _mm_cvtps_epi32(value);
+            const __m128 f = _mm_sub_ps(value, _mm_cvtepi32_ps(whole));
+            __m128 poly = _mm_add_ps(_mm_set1_ps(EXP2_C5), _mm_mul_ps(f, _mm_set1_ps(EXP2_C6)));
+            poly = _mm_add_ps(_mm_set1_ps(EXP2_C4), _mm_mul_ps(f, poly));
+            poly = _mm_add_ps(_mm_set1_ps(EXP2_C3), _mm_mul_ps(f, poly));
+            poly = _mm_add_ps(_mm_set1_ps(EXP2_C2), _mm_mul_ps(f, poly));
+            poly = _mm_add_ps(_mm_set1_ps(EXP2_C1), _mm_mul_ps(f, poly));
+            poly = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(f, poly));
+            const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(whole, _mm_set1_epi32(127)), 23));
+            return _mm_mul_ps(poly, scale);
+        }
+
+        inline __m128 alphaMask(){
+            return _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+        }
+
+        inline void decodeSrgbPixel(const Pixel& source, Pixel& destination){
+            const __m128 original = _mm_loadu_ps(&source.r_);
+            const __m128 x = clampUnit4(original);
+            const __m128 linear = _mm_mul_ps(x, _mm_set1_ps(1.0f / 12.92f));
+            const __m128 base = _mm_mul_ps(_mm_add_ps(x, _mm_set1_ps(0.055f)), _mm_set1_ps(1.0f / 1.055f));
+            const __m128 curve = fastExp2x4(_mm_mul_ps(_mm_set1_ps(2.4f), fastLog2x4(base)));
+            const __m128 result = select(_mm_cmple_ps(x, _mm_set1_ps(SRGB_DECODE_KNEE)), linear, curve);
+            _mm_storeu_ps(&destination.r_, select(alphaMask(), original, result));
+        }
+
+        inline void encodeSrgbPixel(const Pixel& source, Pixel& destination){
+            const __m128 original = _mm_loadu_ps(&source.r_);
+            // 0 の log2 を避けるため、曲線側は折れ点以上の値で計算します（折れ点以下では直線側を選びます）
+            const __m128 x = clampUnit4(original);
+            const __m128 linear = _mm_mul_ps(x, _mm_set1_ps(12.92f));
+            const __m128 safe = _mm_max_ps(x, _mm_set1_ps(SRGB_ENCODE_KNEE));
+            const __m128 curve = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.055f),
+                fastExp2x4(_mm_mul_ps(_mm_set1_ps(1.0f / 2.4f), fastLog2x4(safe)))), _mm_set1_ps(0.055f));
+            const __m128 result = select(_mm_cmple_ps(x, _mm_set1_ps(SRGB_ENCODE_KNEE)), linear, curve);
+            _mm_storeu_ps(&destination.r_, select(alphaMask(), original, result));
+        }
+#else
+        inline void decodeSrgbPixel(const Pixel& source, Pixel& destination){
+            const float alpha = source.a_;
+            destination.r_ = decodeSrgb(source.r_);
+            destination.g_ = decodeSrgb(source.g_);
+            destination.b_ = decodeSrgb(source.b_);
+            destination.a_ = alpha;
+        }
+
+        inline void encodeSrgbPixel(const Pixel& source, Pixel& destination){
+            const float alpha = source.a_;
+            destination.r_ = encodeSrgb(source.r_);
+            destination.g_ = encodeSrgb(source.g_);
+            destination.b_ = encodeSrgb(source.b_);
+            destination.a_ = alpha;
+        }
+#endif
+
+        /** @brief 8bit sRGB → リニアの表（初回に std::pow で作成）。 */
+        const std::array<float, 256>& srgbDecodeTable(){
+            static const std::array<float, 256> table = []{
+                std::array<float, 256> values{};
+                for(size_t idx = 0; idx < values.size(); ++idx){
+                    const double x = static_cast<double>(idx) / 255.0;
+                    values[idx] = static_cast<float>(x <= 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4));
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        // ---- 形式ごとの RGB 8bit の読み書き ----
+        struct Rgb{ std::uint8_t r_, g_, b_; };
+
+        inline Rgb rgbOf(const Pixel& pixel){ return Rgb{unitToByte(pixel.r_), unitToByte(pixel.g_), unitToByte(pixel.b_)}; }
+        inline Rgb rgbOf(const RGBA8& pixel){ return Rgb{pixel.r_, pixel.g_, pixel.b_}; }
+        inline Rgb rgbOf(const BGRA8& pixel){ return Rgb{pixel.r_, pixel.g_, pixel.b_}; }
+        inline Rgb rgbOf(const BGR8& pixel){ return Rgb{pixel.r_, pixel.g_, pixel.b_}; }
+        inline Rgb rgbOf(const Gray8& pixel){ return Rgb{pixel.v_, pixel.v_, pixel.v_}; }
+
+        inline float alphaOf(const Pixel& pixel){ return pixel.a_; }
+        inline float alphaOf(const RGBA8& pixel){ return byteToUnit(pixel.a_); }
+        inline float alphaOf(const BGRA8& pixel){ return byteToUnit(pixel.a_); }
+        inline float alphaOf(const BGR8&){ return 1.0f; }
+        inline float alphaOf(const Gray8&){ return 1.0f; }
+
+        inline void assignRgb(Pixel& pixel, const Rgb rgb){
+            pixel.r_ = byteToUnit(rgb.r_);
+            pixel.g_ = byteToUnit(rgb.g_);
+            pixel.b_ = byteToUnit(rgb.b_);
+            pixel.a_ = 1.0f;
+        }
+        inline void assignRgb(RGBA8& pixel, const Rgb rgb){ pixel = RGBA8{rgb.r_, rgb.g_, rgb.b_, 255}; }
+        inline void assignRgb(BGRA8& pixel, const Rgb rgb){ pixel = BGRA8{rgb.b_, rgb.g_, rgb.r_, 255}; }
+        inline void assignRgb(BGR8& pixel, const Rgb rgb){ pixel = BGR8{rgb.b_, rgb.g_, rgb.r_}; }
+        inline void assignRgb(Gray8& pixel, const Rgb rgb){ pixel = Gray8{lumaOf(rgb.r_, rgb.g_, rgb.b_)}; }
+
+        // ---- YCbCr（JFIF、16bit 固定小数点） ----
+        constexpr int FIXED_HALF = 1 << 15;
+        constexpr int CHROMA_OFFSET = 128 << 16;
+
+        inline std::uint8_t lumaOfRgb(const Rgb rgb){
+            return static_cast<std::uint8_t>((19595 * rgb.r_ + 38470 * rgb.g_ + 7471 * rgb.b_ + FIXED_HALF) >> 16);
+        }
+        /** @brief Cb, Cr の 65536 倍（オフセットなし） */
+        inline int blueDifferenceOf(const Rgb rgb){ return -11059 * rgb.r_ - 21709 * rgb.g_ + 32768 * rgb.b_; }
+        inline int redDifferenceOf(const Rgb rgb){ return 32768 * rgb.r_ - 27439 * rgb.g_ - 5329 * rgb.b_; }
+
+        inline std::uint8_t clampByte(const int value){
+            return static_cast<std::uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+        }
+
+        inline Rgb rgbOfYCbCr(const int luma, const int cb, const int cr){
+            const int blue = cb - 128;
+            const int red = cr - 128;
+            const int scaled = luma << 16;
+            return Rgb{
+                clampByte((scaled + 91881 * red + FIXED_HALF) >> 16),
+                clampByte((scaled - 22554 * blue - 46802 * red + FIXED_HALF) >> 16),
+                clampByte((scaled + 116130 * blue + FIXED_HALF) >> 16)};
+        }
+
+        /** @brief 入力と同じサイズの Q 形式の画像を確保し、行ごとに convert(入力行, 出力行) で生成します。 */
+        template<class Q, class P, class Convert>
+        std::unique_ptr<BasicImage<Q>> convertRows(const BasicImage<P>& source, common::ThreadPool& pool, const Convert& convert){
+            if(!source.isValid()){
+                return nullptr;
+            }
+            const size_t width = source.getWidth();
+            const size_t height = source.getHeight();
+            auto buffer = std::make_unique<BasicPixelBuffer<Q>>(width * height, UNINITIALIZED);
+            if(!buffer->isValid()){
+                return nullptr;
+            }
+            const auto input = makeView(source);
+            parallelForRows(makeView(*buffer, width, height), [&](PixelSpan<Q> row, const size_t y){
+                convert(input.rowData(y), row.data(), width);
+            }, pool);
+            return std::make_unique<BasicImage<Q>>(std::move(buffer), width, height);
+        }
+    }
+
+    float srgbToLinear(const float value){
+        return decodeSrgb(value);
+    }
+
+    float linearToSrgb(const float value){
+        return encodeSrgb(value);
+    }
+
+    float srgbByteToLinear(const std::uint8_t value){
+        return srgbDecodeTable()[value];
+    }
+
+    template<class P>
+    void srgbToLinearRow(const P* source, Pixel* destination, const size_t width){
+        if constexpr(std::is_same_v<P, Pixel>){
+            for(size_t x = 0; x < width; ++x){
+                decodeSrgbPixel(source[x], destination[x]);
+            }
+        }
+        else{
+            const float* table = srgbDecodeTable().data();
+            for(size_t x = 0; x < width; ++x){
+                const Rgb rgb = rgbOf(source[x]);
+                Pixel& pixel = destination[x];
+                pixel.r_ = table[rgb.r_];
+                pixel.g_ = table[rgb.g_];
+                pixel.b_ = table[rgb.b_];
+                pixel.a_ = alphaOf(source[x]);
+            }
+        }
+    }
+
+    template<class P>
+    void linearToSrgbRow(const Pixel* source, P* destination, const size_t width){
+        if constexpr(std::is_same_v<P, Pixel>){
+            for(size_t x = 0; x < width; ++x){
+                encodeSrgbPixel(source[x], destination[x]);
+            }
+        }
+        else{
+            for(size_t x = 0; x < width; ++x){
+                Pixel encoded = source[x];
+                encodeSrgbPixel(source[x], encoded);
+                destination[x] = PixelFormat<P>::fromPixel(encoded);
+            }
+        }
+    }
+
+    template<class P>
+    std::unique_ptr<Image> toLinear(const BasicImage<P>& source, common::ThreadPool& pool){
+        return convertRows<Pixel>(source, pool, [](const P* input, Pixel* output, const size_t width){
+            srgbToLinearRow(input, output, width);
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> toSrgb(const Image& linear, common::ThreadPool& pool){
+        return convertRows<P>(linear, pool, [](const Pixel* input, P* output, const size_t width){
+            linearToSrgbRow(input, output, width);
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<Gray8>> toGrayscale(const BasicImage<P>& source, common::ThreadPool& pool){
+        return convertRows<Gray8>(source, pool, [](const P* input, Gray8* output, const size_t width){
+            for(size_t x = 0; x < width; ++x){
+                const Rgb rgb = rgbOf(input[x]);
+                output[x] = Gray8{lumaOf(rgb.r_, rgb.g_, rgb.b_)};
+            }
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<PlanarYCbCr> toYCbCr(const BasicImage<P>& source, const ChromaSubsampling subsampling, common::ThreadPool& pool){
+        if(!source.isValid()){
+            return nullptr;
+        }
+        const size_t factor = subsampling == ChromaSubsampling::YCbCr420 ? 2 : 1;
+        auto planes = std::make_unique<PlanarYCbCr>();
+        planes->width_ = source.getWidth();
+        planes->height_ = source.getHeight();
+        planes->chromaWidth_ = (planes->width_ + factor - 1) / factor;
+        planes->chromaHeight_ = (planes->height_ + factor - 1) / factor;
+        planes->subsampling_ = subsampling;
+        planes->y_.resize(planes->width_ * planes->height_);
+        planes->cb_.resize(planes->chromaWidth_ * planes->chromaHeight_);
+        planes->cr_.resize(planes->cb_.size());
+
+        const auto input = makeView(source);
+        PlanarYCbCr& output = *planes;
+        const size_t samples = factor * factor;
+        const int offset = CHROMA_OFFSET * static_cast<int>(samples) + FIXED_HALF * static_cast<int>(samples);
+        const int shift = 16 + (factor == 2 ? 2 : 0);
+        pool.parallelFor(0, output.chromaHeight_, parallelRowGrain(output.width_ * factor, output.chromaHeight_, pool.getConcurrency()),
+            [&](const size_t begin, const size_t end){
+                for(size_t chromaY = begin; chromaY < end; ++chromaY){
+                    // 色差 1 行分に対応する輝度の行（4:2:0 の下端の半端は同じ行を 2 回使います）
+                    const size_t top = chromaY * factor;
+                    const P* rows[2] = {input.rowData(top), input.rowData(std::min(top + factor - 1, output.height_ - 1))};
+                    for(size_t idx = 0; idx < factor && top + idx < output.height_; ++idx){
+                        std::uint8_t* luma = &output.y_[(top + idx) * output.width_];
+                        for(size_t x = 0; x < output.width_; ++x){
+                            luma[x] = lumaOfRgb(rgbOf(rows[idx][x]));
+                        }
+                    }
+                    std::uint8_t* cb = &output.cb_[chromaY * output.chromaWidth_];
+                    std::uint8_t* cr = &output.cr_[chromaY * output.chromaWidth_];
+                    for(size_t chromaX = 0; chromaX < output.chromaWidth_; ++chromaX){
+                        const size_t left = chromaX * factor;
+                        const size_t right = std::min(left + factor - 1, output.width_ - 1);
+                        int blue = 0;
+                        int red = 0;
+                        for(size_t row = 0; row < factor; ++row){
+                            for(const size_t x : {left, right}){
+                                const Rgb rgb = rgbOf(rows[row][x]);
+                                blue += blueDifferenceOf(rgb);
+                                red += redDifferenceOf(rgb);
+                                if(factor == 1){
+                                    break;
+                                }
+                            }
+                        }
+                        cb[chromaX] = clampByte((blue + offset) >> shift);
+                        cr[chromaX] = clampByte((red + offset) >> shift);
+                    }
+                }
+            });
+        return planes;
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> fromYCbCr(const PlanarYCbCr& planes, common::ThreadPool& pool){
+        if(!planes.isValid()){
+            return nullptr;
+        }
+        const size_t factor = planes.subsampling_ == ChromaSubsampling::YCbCr420 ? 2 : 1;
+        if(planes.chromaWidth_ != (planes.width_ + factor - 1) / factor || planes.chromaHeight_ != (planes.height_ + factor - 1) / factor){
+            return nullptr;
+        }
+        auto buffer = std::make_unique<BasicPixelBuffer<P>>(planes.width_ * planes.height_, UNINITIALIZED);
+        if(!buffer->isValid()){
+            return nullptr;
+        }
+        parallelForRows(makeView(*buffer, planes.width_, planes.height_), [&](PixelSpan<P> row, const size_t y){
+            const std::uint8_t* luma = &planes.y_[y * planes.width_];
+            const std::uint8_t* cb = &planes.cb_[(y / factor) * planes.chromaWidth_];
+            const std::uint8_t* cr = &planes.cr_[(y / factor) * planes.chromaWidth_];
+            for(size_t x = 0; x < row.size(); ++x){
+                assignRgb(row[x], rgbOfYCbCr(luma[x], cb[x / factor], cr[x / factor]));
+            }
+        }, pool);
+        return std::make_unique<BasicImage<P>>(std::move(buffer), planes.width_, planes.height_);
+    }
+
+#define KAF_INSTANTIATE_COLORSPACE(P) \
+    template void srgbToLinearRow<P>(const P*, Pixel*, const size_t); \
+    template void linearToSrgbRow<P>(const Pixel*, P*, const size_t); \
+    template std::unique_ptr<Image> toLinear<P>(const BasicImage<P>&, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> toSrgb<P>(const Image&, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<Gray8>> toGrayscale<P>(const BasicImage<P>&, common::ThreadPool&); \
+    template std::unique_ptr<PlanarYCbCr> toYCbCr<P>(const BasicImage<P>&, const ChromaSubsampling, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> fromYCbCr<P>(const PlanarYCbCr&, common::ThreadPool&);
+
+    KAF_INSTANTIATE_COLORSPACE(Pixel)
+    KAF_INSTANTIATE_COLORSPACE(RGBA8)
+    KAF_INSTANTIATE_COLORSPACE(BGRA8)
+    KAF_INSTANTIATE_COLORSPACE(BGR8)
+    KAF_INSTANTIATE_COLORSPACE(Gray8)
+#undef KAF_INSTANTIATE_COLORSPACE
+}
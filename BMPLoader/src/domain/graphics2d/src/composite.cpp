@@ -0,0 +1,142 @@
+/**
+ * @file composite.cpp
+ * @brief 画像の合成の実装。
+ * @details 4 つの合成方法はいずれも、乗算済みの値ではアルファ成分にも RGB と同じ式が成り立つため、
+ *          Pixel 1 個を 1 本の SIMD レジスタとして分岐なしで計算します。
+ */
+#include "../include/composite.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "../include/parallel.hpp"
+#include "../include/pixel_buffer.hpp"
+#include "../include/pixel_vec4.hpp"
+#include "../include/premultiplied.hpp"
+
+namespace kaf::domain::graphics2d{
+    namespace {
+        using namespace simd;
+
+        template<BlendMode Mode>
+        inline Vec4 blend(const Vec4 source, const Vec4 destination, const Vec4 one){
+            const Vec4 sourceKeep = sub4(one, alpha4(source));
+            if constexpr(Mode == BlendMode::Over){
+                return add4(source, mulv4(destination, sourceKeep));
+            }
+            else if constexpr(Mode == BlendMode::Multiply){
+                const Vec4 destinationKeep = sub4(one, alpha4(destination));
+                return add4(mulv4(source, add4(destination, destinationKeep)), mulv4(destination, sourceKeep));
+            }
+            else if constexpr(Mode == BlendMode::Screen){
+                return sub4(add4(source, destination), mulv4(source, destination));
+            }
+            else{
+                return min4(add4(source, destination), one);
+            }
+        }
+
+        /** @brief 乗算済みの行 destination に、不透明度を掛けた source を合成します。 */
+        template<BlendMode Mode>
+        void blendRow(Pixel* destination, const Pixel* source, const size_t width, const float opacity){
+            const Vec4 one = set4(1.0f);
+            for(size_t x = 0; x < width; ++x){
+                store4(destination[x], blend<Mode>(mul4(load4(source[x]), opacity), load4(destination[x]), one));
+            }
+        }
+
+        void blendRow(const BlendMode mode, Pixel* destination, const Pixel* source, const size_t width, const float opacity){
+            switch(mode){
+                case BlendMode::Multiply: blendRow<BlendMode::Multiply>(destination, source, width, opacity); break;
+                case BlendMode::Screen: blendRow<BlendMode::Screen>(destination, source, width, opacity); break;
+                case BlendMode::Add: blendRow<BlendMode::Add>(destination, source, width, opacity); break;
+                default: blendRow<BlendMode::Over>(destination, source, width, opacity); break;
+            }
+        }
+
+        /** @brief [offset, offset + size) と [0, limit) の共通部分（overlap 無しの場合は false）。 */
+        bool overlapRange(const std::ptrdiff_t offset, const size_t size, const size_t limit, size_t& sourceBegin, size_t& destinationBegin, size_t& length){
+            const std::ptrdiff_t begin = std::max<std::ptrdiff_t>(offset, 0);
+            const std::ptrdiff_t end = std::min<std::ptrdiff_t>(offset + static_cast<std::ptrdiff_t>(size), static_cast<std::ptrdiff_t>(limit));
+            if(end <= begin){
+                return false;
+            }
+            destinationBegin = static_cast<size_t>(begin);
+            sourceBegin = static_cast<size_t>(begin - offset);
+            length = static_cast<size_t>(end - begin);
+            return true;
+        }
+    }
+
+    const char* toString(const BlendMode mode){
+        switch(mode){
+            case BlendMode::Over: return "over";
+            case BlendMode::Multiply: return "multiply";
+            case BlendMode::Screen: return "screen";
+            case BlendMode::Add: return "add";
+        }
+        return "unknown";
+    }
+
+    template<class P>
+    bool compositeView(const BasicImageView<P>& destination, const BasicImageView<const P>& source,
+        const std::ptrdiff_t x, const std::ptrdiff_t y, const BlendMode mode, const float opacity, common::ThreadPool& pool){
+        if(!destination.isValid() || !source.isValid()){
+            return false;
+        }
+        size_t sourceX{}, sourceY{}, destinationX{}, destinationY{}, width{}, height{};
+        if(!overlapRange(x, source.getWidth(), destination.getWidth(), sourceX, destinationX, width) ||
+            !overlapRange(y, source.getHeight(), destination.getHeight(), sourceY, destinationY, height)){
+            return true;
+        }
+        const float alpha = clampUnit(opacity);
+        if(alpha == 0.0f){
+            return true;
+        }
+        const BasicImageView<P> target = destination.subView(destinationX, destinationY, width, height);
+        const BasicImageView<const P> overlay = source.subView(sourceX, sourceY, width, height);
+
+        std::atomic<bool> allocated{true};
+        pool.parallelFor(0, height, parallelRowGrain(width, height, pool.getConcurrency()), [&](const size_t begin, const size_t end){
+            BasicPixelBuffer<Pixel> lines(width * 2, UNINITIALIZED);
+            if(!lines.isValid()){
+                allocated = false;
+                return;
+            }
+            Pixel* below = lines.pixels_.get();
+            Pixel* above = below + width;
+            for(size_t row = begin; row < end; ++row){
+                loadPremultipliedRow(target.rowData(row), below, width);
+                loadPremultipliedRow(overlay.rowData(row), above, width);
+                blendRow(mode, below, above, width, alpha);
+                storeUnpremultipliedRow(below, target.rowData(row), width);
+            }
+        });
+        return allocated;
+    }
+
+    template<class P>
+    bool compositeImage(BasicImage<P>& destination, const BasicImage<P>& source,
+        const std::ptrdiff_t x, const std::ptrdiff_t y, const BlendMode mode, const float opacity, common::ThreadPool& pool){
+        if(!destination.isValid() || !source.isValid()){
+            return false;
+        }
+        if(&destination == &source){
+            // 合成前のバッファを共有するコピーを残すと、makeView で合成先だけが新しいバッファへ移る
+            const BasicImage<P> original(source);
+            return compositeView(makeView(destination), makeView(original), x, y, mode, opacity, pool);
+        }
+        return compositeView(makeView(destination), makeView(source), x, y, mode, opacity, pool);
+    }
+
+#define KAF_INSTANTIATE_COMPOSITE(P) \
+    template bool compositeView<P>(const BasicImageView<P>&, const BasicImageView<const P>&, const std::ptrdiff_t, const std::ptrdiff_t, const BlendMode, const float, common::ThreadPool&); \
+    template bool compositeImage<P>(BasicImage<P>&, const BasicImage<P>&, const std::ptrdiff_t, const std::ptrdiff_t, const BlendMode, const float, common::ThreadPool&);
+
+    KAF_INSTANTIATE_COMPOSITE(Pixel)
+    KAF_INSTANTIATE_COMPOSITE(RGBA8)
+    KAF_INSTANTIATE_COMPOSITE(BGRA8)
+    KAF_INSTANTIATE_COMPOSITE(BGR8)
+    KAF_INSTANTIATE_COMPOSITE(Gray8)
+#undef KAF_INSTANTIATE_COMPOSITE
+}
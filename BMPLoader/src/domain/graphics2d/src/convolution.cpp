@@ -0,0 +1,424 @@
+/**
+ * @file convolution.cpp
+ * @brief 畳み込みとぼかし・シャープ化の実装。
+ * @details 畳み込みは画像を L2 キャッシュに収まる大きさのタイル（幅 TILE_WIDTH 程度）に分け、タイルごとに
+ *          端の扱いを反映した入力行を読み込み → 水平方向 → 垂直方向の順に処理します。
+ *          タイルどうしは独立しているため、そのまま ThreadPool で並列に処理します。
+ *          ボックスぼかしはタイルの上下左右の重複（半径に比例）を避けるため、行の帯ごとに全幅の移動和で処理します。
+ */
+#include "../include/convolution.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "../include/parallel.hpp"
+#include "../include/pixel_buffer.hpp"
+#include "../include/pixel_format.hpp"
+#include "../include/pixel_vec4.hpp"
+#include "../include/premultiplied.hpp"
+
+namespace kaf::domain::graphics2d{
+    namespace {
+        using namespace simd;
+
+        /** @brief タイルの幅[px]。 */
+        constexpr size_t TILE_WIDTH = 256;
+        /** @brief タイルの中間結果の目安（L2 キャッシュに収まる大きさ）[バイト]。 */
+        constexpr size_t TILE_BYTES = 256 * 1024;
+        /** @brief タイルの高さの下限（上下の重複行の割合を抑えます）。 */
+        constexpr size_t MIN_TILE_ROWS = 16;
+
+        /** @brief 範囲外の位置 index を端の扱いに従って [0, size) へ写します。 */
+        size_t edgeIndex(const std::ptrdiff_t index, const size_t size, const EdgeMode edge){
+            const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(size);
+            switch(edge){
+                case EdgeMode::Wrap:{
+                    const std::ptrdiff_t wrapped = index % count;
+                    return static_cast<size_t>(wrapped < 0 ? wrapped + count : wrapped);
+                }
+                case EdgeMode::Mirror:{
+                    const std::ptrdiff_t period = count * 2;
+                    std::ptrdiff_t folded = index % period;
+                    folded = folded < 0 ? folded + period : folded;
+                    return static_cast<size_t>(folded < count ? folded : period - 1 - folded);
+                }
+                default:
+                    return static_cast<size_t>(std::clamp<std::ptrdiff_t>(index, 0, count - 1));
+            }
+        }
+
+        /** @brief 位置 -radius 〜 size + radius - 1 の参照先の表（size + 2 * radius 要素）。 */
+        std::vector<size_t> edgeMap(const size_t size, const size_t radius, const EdgeMode edge){
+            std::vector<size_t> indices(size + radius * 2);
+            for(size_t idx = 0; idx < indices.size(); ++idx){
+                indices[idx] = edgeIndex(static_cast<std::ptrdiff_t>(idx) - static_cast<std::ptrdiff_t>(radius), size, edge);
+            }
+            return indices;
+        }
+
+        /**
+         * @brief タイル単位の畳み込みの共通部分。
+         * @details horizontal(line, band, width) は左右 radiusX 分を含む入力行 line から band の 1 行を、
+         *          vertical(band, bandWidth, width, rows, output) は上下 radiusY 分を含む band から
+         *          width × rows の出力を求めます。keepPadding の場合 band は左右の余白を含む幅になります。
+         */
+        template<class P, class Horizontal, class Vertical>
+        bool filterTiles(const BasicImageView<const P>& source, const BasicImageView<P>& destination,
+            const size_t radiusX, const size_t radiusY, const bool keepPadding, const EdgeMode edge, common::ThreadPool& pool,
+            const Horizontal& horizontal, const Vertical& vertical){
+            if(!source.isValid() || !destination.isValid() ||
+                source.getWidth() != destination.getWidth() || source.getHeight() != destination.getHeight()){
+                return false;
+            }
+            const size_t width = source.getWidth();
+            const size_t height = source.getHeight();
+            const std::vector<size_t> columns = edgeMap(width, radiusX, edge);
+            const std::vector<size_t> rows = edgeMap(height, radiusY, edge);
+
+            const size_t tileWidth = std::min(width, TILE_WIDTH);
+            const size_t lineWidth = tileWidth + radiusX * 2;
+            const size_t bandWidth = keepPadding ? lineWidth : tileWidth;
+            const size_t fitRows = TILE_BYTES / (bandWidth * sizeof(Pixel));
+            const size_t tileRows = std::min(height, std::max(MIN_TILE_ROWS, fitRows > radiusY * 2 ? fitRows - radiusY * 2 : 0));
+            const size_t tilesX = (width + tileWidth - 1) / tileWidth;
+            const size_t tilesY = (height + tileRows - 1) / tileRows;
+
+            std::atomic<bool> allocated{true};
+            pool.parallelFor(0, tilesX * tilesY, 1, [&](const size_t begin, const size_t end){
+                BasicPixelBuffer<Pixel> line(lineWidth, UNINITIALIZED);
+                BasicPixelBuffer<Pixel> band((tileRows + radiusY * 2) * bandWidth, UNINITIALIZED);
+                BasicPixelBuffer<Pixel> output(tileRows * tileWidth, UNINITIALIZED);
+                if(!line.isValid() || !band.isValid() || !output.isValid()){
+                    allocated = false;
+                    return;
+                }
+                for(size_t tile = begin; tile < end; ++tile){
+                    const size_t x0 = (tile % tilesX) * tileWidth;
+                    const size_t y0 = (tile / tilesX) * tileRows;
+                    const size_t currentWidth = std::min(tileWidth, width - x0);
+                    const size_t currentRows = std::min(tileRows, height - y0);
+                    const size_t currentLineWidth = currentWidth + radiusX * 2;
+                    // 左右の余白が画像内に収まる場合は連続した範囲をまとめて変換します
+                    const bool inside = x0 >= radiusX && x0 + currentWidth + radiusX <= width;
+                    for(size_t idx = 0; idx < currentRows + radiusY * 2; ++idx){
+                        const P* sourceRow = source.rowData(rows[y0 + idx]);
+                        if(inside){
+                            loadPremultipliedRow(sourceRow + (x0 - radiusX), line.pixels_.get(), currentLineWidth);
+                        }
+                        else{
+                            for(size_t x = 0; x < currentLineWidth; ++x){
+                                line.pixels_[x] = premultiply(PixelFormat<P>::toPixel(sourceRow[columns[x0 + x]]));
+                            }
+                        }
+                        horizontal(line.pixels_.get(), band.pixels_.get() + idx * bandWidth, currentWidth);
+                    }
+                    vertical(band.pixels_.get(), bandWidth, currentWidth, currentRows, output.pixels_.get());
+                    for(size_t y = 0; y < currentRows; ++y){
+                        storeUnpremultipliedRow(output.pixels_.get() + y * currentWidth, destination.rowData(y0 + y) + x0, currentWidth);
+                    }
+                }
+            });
+            return allocated;
+        }
+
+        // ---- 水平方向 ----
+        /** @brief 重み付き和（line は左右に weights.size() / 2 の余白を含む）。 */
+        struct HorizontalKernel{
+            const std::vector<float>& weights_;
+            void operator()(const Pixel* line, Pixel* output, const size_t width) const {
+                const float* weight = weights_.data();
+                const size_t taps = weights_.size();
+                for(size_t x = 0; x < width; ++x){
+                    Vec4 sum = zero4();
+                    for(size_t tap = 0; tap < taps; ++tap){
+                        sum = madd4(sum, load4(line[x + tap]), weight[tap]);
+                    }
+                    store4(output[x], sum);
+                }
+            }
+        };
+
+        /** @brief 移動和による平均（1 ピクセル当たり加算と減算 1 回ずつ）。 */
+        struct HorizontalBox{
+            size_t radius_;
+            void operator()(const Pixel* line, Pixel* output, const size_t width) const {
+                const float scale = 1.0f / static_cast<float>(radius_ * 2 + 1);
+                Vec4 sum = zero4();
+                for(size_t tap = 0; tap <= radius_ * 2; ++tap){
+                    sum = add4(sum, load4(line[tap]));
+                }
+                for(size_t x = 0; x < width; ++x){
+                    store4(output[x], mul4(sum, scale));
+                    if(x + 1 < width){
+                        sum = add4(sum, sub4(load4(line[x + radius_ * 2 + 1]), load4(line[x])));
+                    }
+                }
+            }
+        };
+
+        /** @brief 余白を含めてそのまま保持します（2 次元カーネル用）。 */
+        struct HorizontalCopy{
+            size_t radius_;
+            void operator()(const Pixel* line, Pixel* output, const size_t width) const {
+                std::copy(line, line + width + radius_ * 2, output);
+            }
+        };
+
+        // ---- 垂直方向 ----
+        struct VerticalKernel{
+            const std::vector<float>& weights_;
+            void operator()(const Pixel* band, const size_t bandWidth, const size_t width, const size_t rows, Pixel* output) const {
+                const float* weight = weights_.data();
+                const size_t taps = weights_.size();
+                for(size_t y = 0; y < rows; ++y){
+                    const Pixel* window = band + y * bandWidth;
+                    for(size_t x = 0; x < width; ++x){
+                        Vec4 sum = zero4();
+                        for(size_t tap = 0; tap < taps; ++tap){
+                            sum = madd4(sum, load4(window[tap * bandWidth + x]), weight[tap]);
+                        }
+                        store4(output[y * width + x], sum);
+                    }
+                }
+            }
+        };
+
+        /** @brief 2 次元カーネル（band は左右の余白を含む）。 */
+        struct Vertical2D{
+            const ConvolutionKernel& kernel_;
+            void operator()(const Pixel* band, const size_t bandWidth, const size_t width, const size_t rows, Pixel* output) const {
+                for(size_t y = 0; y < rows; ++y){
+                    for(size_t x = 0; x < width; ++x){
+                        Vec4 sum = zero4();
+                        const float* weight = kernel_.weights_.data();
+                        for(size_t ky = 0; ky < kernel_.height_; ++ky){
+                            const Pixel* window = band + (y + ky) * bandWidth + x;
+                            for(size_t kx = 0; kx < kernel_.width_; ++kx){
+                                sum = madd4(sum, load4(window[kx]), *weight++);
+                            }
+                        }
+                        store4(output[y * width + x], sum);
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief 行の帯ごとのボックスぼかし。
+         * @details 帯の先頭で窓（2 * radius + 1 行）の水平方向の移動和を全幅で求めて合計し、以降は 1 行進むごとに
+         *          窓に入る行と出る行の水平方向の移動和を求め直して加減します。窓の行は保持しないため、
+         *          1 ピクセル当たりの計算量も作業領域も半径によりません（帯の先頭の窓の読み込みだけが半径に比例します）。
+         */
+        template<class P>
+        bool boxBlurBands(const BasicImageView<const P>& source, const BasicImageView<P>& destination,
+            const size_t radius, const EdgeMode edge, common::ThreadPool& pool){
+            if(!source.isValid() || !destination.isValid() ||
+                source.getWidth() != destination.getWidth() || source.getHeight() != destination.getHeight()){
+                return false;
+            }
+            const size_t width = source.getWidth();
+            const size_t height = source.getHeight();
+            const std::vector<size_t> columns = edgeMap(width, radius, edge);
+            const std::vector<size_t> rows = edgeMap(height, radius, edge);
+            const size_t windowRows = radius * 2 + 1;
+            const float scale = 1.0f / static_cast<float>(windowRows);
+            // 帯の数は並列度まで（帯の先頭の窓の読み込みが帯の高さを超えないようにする）
+            const size_t concurrency = pool.getConcurrency();
+            const size_t bandRows = std::min(height, std::max((height + concurrency - 1) / concurrency, windowRows));
+            const HorizontalBox horizontal{radius};
+
+            std::atomic<bool> allocated{true};
+            pool.parallelFor(0, height, bandRows, [&](const size_t begin, const size_t end){
+                BasicPixelBuffer<Pixel> line(width + radius * 2, UNINITIALIZED);
+                BasicPixelBuffer<Pixel> entering(width, UNINITIALIZED);
+                BasicPixelBuffer<Pixel> leaving(width, UNINITIALIZED);
+                BasicPixelBuffer<Pixel> window(width, UNINITIALIZED);
+                if(!line.isValid() || !entering.isValid() || !leaving.isValid() || !window.isValid()){
+                    allocated = false;
+                    return;
+                }
+                Pixel* padded = line.pixels_.get();
+                Pixel* sum = window.pixels_.get();
+                // 位置 position（rows の添字）の行の水平方向の移動和
+                const auto filterRow = [&](const size_t position, Pixel* output){
+                    const P* sourceRow = source.rowData(rows[position]);
+                    for(size_t x = 0; x < radius; ++x){
+                        padded[x] = premultiply(PixelFormat<P>::toPixel(sourceRow[columns[x]]));
+                        padded[radius + width + x] = premultiply(PixelFormat<P>::toPixel(sourceRow[columns[radius + width + x]]));
+                    }
+                    loadPremultipliedRow(sourceRow, padded + radius, width);
+                    horizontal(padded, output, width);
+                };
+
+                filterRow(begin, sum);
+                for(size_t idx = 1; idx < windowRows; ++idx){
+                    filterRow(begin + idx, entering.pixels_.get());
+                    for(size_t x = 0; x < width; ++x){
+                        store4(sum[x], add4(load4(sum[x]), load4(entering.pixels_[x])));
+                    }
+                }
+                for(size_t y = begin; y < end; ++y){
+                    for(size_t x = 0; x < width; ++x){
+                        store4(leaving.pixels_[x], mul4(load4(sum[x]), scale));
+                    }
+                    storeUnpremultipliedRow(leaving.pixels_.get(), destination.rowData(y), width);
+                    if(y + 1 < end){
+                        filterRow(y + windowRows, entering.pixels_.get());
+                        filterRow(y, leaving.pixels_.get());
+                        for(size_t x = 0; x < width; ++x){
+                            store4(sum[x], add4(load4(sum[x]), sub4(load4(entering.pixels_[x]), load4(leaving.pixels_[x]))));
+                        }
+                    }
+                }
+            });
+            return allocated;
+        }
+
+        /** @brief 入力と同じサイズの画像を確保し、apply(入力ビュー, 出力ビュー) の結果で生成します。 */
+        template<class P, class Apply>
+        std::unique_ptr<BasicImage<P>> filterImage(const BasicImage<P>& source, const Apply& apply){
+            if(!source.isValid()){
+                return nullptr;
+            }
+            const size_t width = source.getWidth();
+            const size_t height = source.getHeight();
+            auto buffer = std::make_unique<BasicPixelBuffer<P>>(width * height, UNINITIALIZED);
+            if(!buffer->isValid() || !apply(makeView(source), makeView(*buffer, width, height))){
+                return nullptr;
+            }
+            return std::make_unique<BasicImage<P>>(std::move(buffer), width, height);
+        }
+    }
+
+    const char* toString(const EdgeMode edge){
+        switch(edge){
+            case EdgeMode::Clamp: return "clamp";
+            case EdgeMode::Mirror: return "mirror";
+            case EdgeMode::Wrap: return "wrap";
+        }
+        return "unknown";
+    }
+
+    std::vector<float> gaussianKernel(const float sigma){
+        if(!(sigma > 0.0f)){
+            return {1.0f};
+        }
+        const size_t radius = static_cast<size_t>(std::ceil(sigma * 3.0f));
+        std::vector<float> weights(radius * 2 + 1);
+        double total = 0.0;
+        for(size_t idx = 0; idx < weights.size(); ++idx){
+            const double distance = static_cast<double>(idx) - static_cast<double>(radius);
+            const double weight = std::exp(-(distance * distance) / (2.0 * sigma * sigma));
+            weights[idx] = static_cast<float>(weight);
+            total += weight;
+        }
+        for(auto& weight : weights){
+            weight = static_cast<float>(weight / total);
+        }
+        return weights;
+    }
+
+    template<class P>
+    bool convolveView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const ConvolutionKernel& kernel, const EdgeMode edge, common::ThreadPool& pool){
+        if(!kernel.isValid()){
+            return false;
+        }
+        const size_t radiusX = kernel.width_ / 2;
+        const size_t radiusY = kernel.height_ / 2;
+        return filterTiles(source, destination, radiusX, radiusY, true, edge, pool,
+            HorizontalCopy{radiusX}, Vertical2D{kernel});
+    }
+
+    template<class P>
+    bool convolveSeparableView(const BasicImageView<const P>& source, const BasicImageView<P>& destination,
+        const std::vector<float>& horizontal, const std::vector<float>& vertical, const EdgeMode edge, common::ThreadPool& pool){
+        if(horizontal.size() % 2 == 0 || vertical.size() % 2 == 0){
+            return false;
+        }
+        return filterTiles(source, destination, horizontal.size() / 2, vertical.size() / 2, false, edge, pool,
+            HorizontalKernel{horizontal}, VerticalKernel{vertical});
+    }
+
+    template<class P>
+    bool boxBlurView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const size_t radius, const EdgeMode edge, common::ThreadPool& pool){
+        return boxBlurBands(source, destination, radius, edge, pool);
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> convolveImage(const BasicImage<P>& source, const ConvolutionKernel& kernel, const EdgeMode edge, common::ThreadPool& pool){
+        return filterImage(source, [&](const BasicImageView<const P>& input, const BasicImageView<P>& output){
+            return convolveView(input, output, kernel, edge, pool);
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> gaussianBlur(const BasicImage<P>& source, const float sigma, const EdgeMode edge, common::ThreadPool& pool){
+        const std::vector<float> weights = gaussianKernel(sigma);
+        return filterImage(source, [&](const BasicImageView<const P>& input, const BasicImageView<P>& output){
+            return convolveSeparableView(input, output, weights, weights, edge, pool);
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> boxBlur(const BasicImage<P>& source, const size_t radius, const EdgeMode edge, common::ThreadPool& pool){
+        return filterImage(source, [&](const BasicImageView<const P>& input, const BasicImageView<P>& output){
+            return boxBlurView(input, output, radius, edge, pool);
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> unsharpMask(const BasicImage<P>& source, const float sigma, const float amount, const float threshold, const EdgeMode edge, common::ThreadPool& pool){
+        const auto blurred = gaussianBlur(source, sigma, edge, pool);
+        if(blurred == nullptr){
+            return nullptr;
+        }
+        const auto blurredView = makeView(*blurred);
+        return filterImage(source, [&](const BasicImageView<const P>& input, const BasicImageView<P>& output){
+            parallelForRows(output, [&](PixelSpan<P> row, const size_t y){
+                const P* original = input.rowData(y);
+                const P* smooth = blurredView.rowData(y);
+                for(size_t x = 0; x < row.size(); ++x){
+                    Pixel pixel = PixelFormat<P>::toPixel(original[x]);
+                    const Pixel blur = PixelFormat<P>::toPixel(smooth[x]);
+                    float* channel = &pixel.r_;
+                    const float* blurChannel = &blur.r_;
+                    for(size_t idx = 0; idx < 3; ++idx){
+                        const float difference = channel[idx] - blurChannel[idx];
+                        if(std::fabs(difference) >= threshold){
+                            channel[idx] = clampUnit(channel[idx] + amount * difference);
+                        }
+                    }
+                    row[x] = PixelFormat<P>::fromPixel(pixel);
+                }
+            }, pool);
+            return true;
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> sharpen(const BasicImage<P>& source, const float amount, const EdgeMode edge, common::ThreadPool& pool){
+        const ConvolutionKernel kernel{3, 3, {
+            0.0f, -amount, 0.0f,
+            -amount, 1.0f + 4.0f * amount, -amount,
+            0.0f, -amount, 0.0f}};
+        return convolveImage(source, kernel, edge, pool);
+    }
+
+#define KAF_INSTANTIATE_CONVOLUTION(P) \
+    template bool convolveView<P>(const BasicImageView<const P>&, const BasicImageView<P>&, const ConvolutionKernel&, const EdgeMode, common::ThreadPool&); \
+    template bool convolveSeparableView<P>(const BasicImageView<const P>&, const BasicImageView<P>&, const std::vector<float>&, const std::vector<float>&, const EdgeMode, common::ThreadPool&); \
+    template bool boxBlurView<P>(const BasicImageView<const P>&, const BasicImageView<P>&, const size_t, const EdgeMode, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> convolveImage<P>(const BasicImage<P>&, const ConvolutionKernel&, const EdgeMode, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> gaussianBlur<P>(const BasicImage<P>&, const float, const EdgeMode, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> boxBlur<P>(const BasicImage<P>&, const size_t, const EdgeMode, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> unsharpMask<P>(const BasicImage<P>&, const float, const float, const float, const EdgeMode, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> sharpen<P>(const BasicImage<P>&, const float, const EdgeMode, common::ThreadPool&);
+
+    KAF_INSTANTIATE_CONVOLUTION(Pixel)
+    KAF_INSTANTIATE_CONVOLUTION(RGBA8)
+    KAF_INSTANTIATE_CONVOLUTION(BGRA8)
+    KAF_INSTANTIATE_CONVOLUTION(BGR8)
+    KAF_INSTANTIATE_CONVOLUTION(Gray8)
+#undef KAF_INSTANTIATE_CONVOLUTION
+}
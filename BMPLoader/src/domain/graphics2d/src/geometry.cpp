@@ -0,0 +1,275 @@
+/**
+ * @file geometry.cpp
+ * @brief 回転・転置・反転の実装。
+ * @details 90°・270°回転は、負のストライドで上下を反転したビューを介して転置に帰着させます。
+ */
+#include "../include/geometry.hpp"
+
+#include <algorithm>
+
+#include "../include/parallel.hpp"
+#include "../include/pixel_buffer.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define KAF_GEOMETRY_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace kaf::domain::graphics2d{
+    namespace {
+        /** @brief 転置のブロック一辺[px]（入出力のブロックが L1 キャッシュに収まる大きさ）。 */
+        template<class P>
+        constexpr size_t transposeBlockSize(){
+            return sizeof(P) >= 16 ? 32 : (sizeof(P) >= 3 ? 64 : 128);
+        }
+
+        /** @brief 上下を反転したビュー（コピーしません）。 */
+        template<class P>
+        BasicImageView<P> flippedVertically(const BasicImageView<P>& view){
+            return BasicImageView<P>(view.rowData(view.getHeight() - 1), view.getWidth(), view.getHeight(), -view.getRowStride());
+        }
+
+        /** @brief 4 バイトのピクセル 4 個を逆順にします。 */
+#if defined(KAF_GEOMETRY_SSE)
+        inline __m128i reverse4(const __m128i value){
+            return _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+#endif
+
+        template<class P>
+        void reverseCopy(const P* source, P* destination, const size_t width){
+            size_t x = 0;
+#if defined(KAF_GEOMETRY_SSE)
+            if constexpr(sizeof(P) == 4){
+                for(; x + 4 <= width; x += 4){
+                    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + width - x - 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x), reverse4(value));
+                }
+            }
+#endif
+            std::reverse_copy(source, source + (width - x), destination + x);
+        }
+
+        template<class P>
+        void reverseInPlace(P* row, const size_t width){
+            size_t left = 0;
+            size_t right = width;
+#if defined(KAF_GEOMETRY_SSE)
+            if constexpr(sizeof(P) == 4){
+                for(; right - left >= 8; left += 4, right -= 4){
+                    const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + left));
+                    const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + right - 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(row + left), reverse4(tail));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(row + right - 4), reverse4(head));
+                }
+            }
+#endif
+            std::reverse(row + left, row + right);
+        }
+
+        /** @brief 出力の [x0, x0 + width) × [y0, y0 + height) を転置で埋めます。 */
+        template<class P>
+        void transposeBlock(const BasicImageView<const P>& source, const BasicImageView<P>& destination,
+            const size_t x0, const size_t y0, const size_t width, const size_t height){
+            size_t dy = y0;
+#if defined(KAF_GEOMETRY_SSE)
+            if constexpr(sizeof(P) == 4){
+                // 4×4 ピクセルを SSE レジスタ 4 本で転置します
+                for(; dy + 4 <= y0 + height; dy += 4){
+                    size_t dx = x0;
+                    for(; dx + 4 <= x0 + width; dx += 4){
+                        __m128 row0 = _mm_loadu_ps(reinterpret_cast<const float*>(source.rowData(dx) + dy));
+                        __m128 row1 = _mm_loadu_ps(reinterpret_cast<const float*>(source.rowData(dx + 1) + dy));
+                        __m128 row2 = _mm_loadu_ps(reinterpret_cast<const float*>(source.rowData(dx + 2) + dy));
+                        __m128 row3 = _mm_loadu_ps(reinterpret_cast<const float*>(source.rowData(dx + 3) + dy));
+                        _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+                        _mm_storeu_ps(reinterpret_cast<float*>(destination.rowData(dy) + dx), row0);
+                        _mm_storeu_ps(reinterpret_cast<float*>(destination.rowData(dy + 1) + dx), row1);
+                        _mm_storeu_ps(reinterpret_cast<float*>(destination.rowData(dy + 2) + dx), row2);
+                        _mm_storeu_ps(reinterpret_cast<float*>(destination.rowData(dy + 3) + dx), row3);
+                    }
+                    for(; dx < x0 + width; ++dx){
+                        const P* column = source.rowData(dx) + dy;
+                        for(size_t idx = 0; idx < 4; ++idx){
+                            destination.rowData(dy + idx)[dx] = column[idx];
+                        }
+                    }
+                }
+            }
+#endif
+            for(; dy < y0 + height; ++dy){
+                P* output = destination.rowData(dy);
+                for(size_t dx = x0; dx < x0 + width; ++dx){
+                    output[dx] = source.rowData(dx)[dy];
+                }
+            }
+        }
+
+        template<class P>
+        bool sameSize(const BasicImageView<const P>& source, const BasicImageView<P>& destination){
+            return source.isValid() && destination.isValid() &&
+                source.getWidth() == destination.getWidth() && source.getHeight() == destination.getHeight();
+        }
+
+        /** @brief 入力と同じ（swap の場合は縦横を入れ替えた）サイズの画像を確保し、apply で生成します。 */
+        template<class P, class Apply>
+        std::unique_ptr<BasicImage<P>> createTransformed(const BasicImage<P>& source, const bool swap, const Apply& apply){
+            if(!source.isValid()){
+                return nullptr;
+            }
+            const size_t width = swap ? source.getHeight() : source.getWidth();
+            const size_t height = swap ? source.getWidth() : source.getHeight();
+            auto buffer = std::make_unique<BasicPixelBuffer<P>>(width * height, UNINITIALIZED);
+            if(!buffer->isValid() || !apply(makeView(source), makeView(*buffer, width, height))){
+                return nullptr;
+            }
+            return std::make_unique<BasicImage<P>>(std::move(buffer), width, height);
+        }
+    }
+
+    template<class P>
+    bool transposeView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, common::ThreadPool& pool){
+        if(!source.isValid() || !destination.isValid() ||
+            source.getWidth() != destination.getHeight() || source.getHeight() != destination.getWidth()){
+            return false;
+        }
+        constexpr size_t block = transposeBlockSize<P>();
+        const size_t width = destination.getWidth();
+        const size_t height = destination.getHeight();
+        const size_t blockRows = (height + block - 1) / block;
+        pool.parallelFor(0, blockRows, 1, [&](const size_t begin, const size_t end){
+            for(size_t blockRow = begin; blockRow < end; ++blockRow){
+                const size_t y0 = blockRow * block;
+                const size_t rows = std::min(block, height - y0);
+                for(size_t x0 = 0; x0 < width; x0 += block){
+                    transposeBlock(source, destination, x0, y0, std::min(block, width - x0), rows);
+                }
+            }
+        });
+        return true;
+    }
+
+    template<class P>
+    bool rotateView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const Rotation rotation, common::ThreadPool& pool){
+        if(!source.isValid() || !destination.isValid()){
+            return false;
+        }
+        switch(rotation){
+            case Rotation::Rotate90:
+                // 出力の (x, y) = 入力の (y, H - 1 - x)
+                return transposeView(flippedVertically(source), destination, pool);
+            case Rotation::Rotate270:
+                // 出力の (x, W - 1 - y) = 入力の (y, x)
+                return transposeView(source, flippedVertically(destination), pool);
+            default:
+                if(!sameSize(source, destination)){
+                    return false;
+                }
+                parallelForRows(destination, [&](PixelSpan<P> row, const size_t y){
+                    reverseCopy(source.rowData(source.getHeight() - 1 - y), row.data(), row.size());
+                }, pool);
+                return true;
+        }
+    }
+
+    template<class P>
+    bool flipView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const FlipAxis axis, common::ThreadPool& pool){
+        if(!sameSize(source, destination)){
+            return false;
+        }
+        if(axis == FlipAxis::Horizontal){
+            parallelForRows(destination, [&](PixelSpan<P> row, const size_t y){
+                reverseCopy(source.rowData(y), row.data(), row.size());
+            }, pool);
+        }
+        else{
+            const BasicImageView<const P> flipped = flippedVertically(source);
+            parallelForRows(destination, [&](PixelSpan<P> row, const size_t y){
+                const P* input = flipped.rowData(y);
+                std::copy(input, input + row.size(), row.data());
+            }, pool);
+        }
+        return true;
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> transposeImage(const BasicImage<P>& source, common::ThreadPool& pool){
+        return createTransformed(source, true, [&](const BasicImageView<const P>& input, const BasicImageView<P>& output){
+            return transposeView(input, output, pool);
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> rotateImage(const BasicImage<P>& source, const Rotation rotation, common::ThreadPool& pool){
+        return createTransformed(source, rotation != Rotation::Rotate180, [&](const BasicImageView<const P>& input, const BasicImageView<P>& output){
+            return rotateView(input, output, rotation, pool);
+        });
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> flipImage(const BasicImage<P>& source, const FlipAxis axis, common::ThreadPool& pool){
+        return createTransformed(source, false, [&](const BasicImageView<const P>& input, const BasicImageView<P>& output){
+            return flipView(input, output, axis, pool);
+        });
+    }
+
+    template<class P>
+    bool rotate180InPlace(const BasicImageView<P>& view, common::ThreadPool& pool){
+        if(!view.isValid()){
+            return false;
+        }
+        const size_t width = view.getWidth();
+        const size_t height = view.getHeight();
+        const size_t pairs = (height + 1) / 2;
+        pool.parallelFor(0, pairs, parallelRowGrain(width * 2, pairs, pool.getConcurrency()), [&](const size_t begin, const size_t end){
+            for(size_t top = begin; top < end; ++top){
+                const size_t bottom = height - 1 - top;
+                reverseInPlace(view.rowData(top), width);
+                if(top != bottom){
+                    reverseInPlace(view.rowData(bottom), width);
+                    std::swap_ranges(view.rowData(top), view.rowData(top) + width, view.rowData(bottom));
+                }
+            }
+        });
+        return true;
+    }
+
+    template<class P>
+    bool flipInPlace(const BasicImageView<P>& view, const FlipAxis axis, common::ThreadPool& pool){
+        if(!view.isValid()){
+            return false;
+        }
+        const size_t width = view.getWidth();
+        if(axis == FlipAxis::Horizontal){
+            parallelForRows(view, [&](PixelSpan<P> row, size_t){
+                reverseInPlace(row.data(), width);
+            }, pool);
+            return true;
+        }
+        const size_t height = view.getHeight();
+        const size_t pairs = height / 2;
+        pool.parallelFor(0, pairs, parallelRowGrain(width * 2, pairs, pool.getConcurrency()), [&](const size_t begin, const size_t end){
+            for(size_t top = begin; top < end; ++top){
+                std::swap_ranges(view.rowData(top), view.rowData(top) + width, view.rowData(height - 1 - top));
+            }
+        });
+        return true;
+    }
+
+#define KAF_INSTANTIATE_GEOMETRY(P) \
+    template bool transposeView<P>(const BasicImageView<const P>&, const BasicImageView<P>&, common::ThreadPool&); \
+    template bool rotateView<P>(const BasicImageView<const P>&, const BasicImageView<P>&, const Rotation, common::ThreadPool&); \
+    template bool flipView<P>(const BasicImageView<const P>&, const BasicImageView<P>&, const FlipAxis, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> transposeImage<P>(const BasicImage<P>&, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> rotateImage<P>(const BasicImage<P>&, const Rotation, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> flipImage<P>(const BasicImage<P>&, const FlipAxis, common::ThreadPool&); \
+    template bool rotate180InPlace<P>(const BasicImageView<P>&, common::ThreadPool&); \
+    template bool flipInPlace<P>(const BasicImageView<P>&, const FlipAxis, common::ThreadPool&);
+
+    KAF_INSTANTIATE_GEOMETRY(Pixel)
+    KAF_INSTANTIATE_GEOMETRY(RGBA8)
+    KAF_INSTANTIATE_GEOMETRY(BGRA8)
+    KAF_INSTANTIATE_GEOMETRY(BGR8)
+    KAF_INSTANTIATE_GEOMETRY(Gray8)
+#undef KAF_INSTANTIATE_GEOMETRY
+}
@@ -5,23 +5,33 @@
 #include "../include/image.hpp"
 #include "../include/pixel.hpp"
 #include "../include/pixel_buffer.hpp"
+#include "../include/pixel_format.hpp"
+#include "../../common/include/log.hpp"
 
+#include <atomic>
 #include <optional>
 #include <limits>
 #include <memory>
 #include <algorithm>
+#include <utility>
 
 namespace kaf::domain::graphics2d{
-    Image::Image()
+    template<class P>
+    BasicImage<P>::BasicImage()
     : pixelBuffer_(nullptr), width_(0), height_(0){}
 
-    Image::Image(std::unique_ptr<PixelBuffer>&& buffer, size_t width, size_t height)
+    template<class P>
+    BasicImage<P>::BasicImage(std::unique_ptr<BufferType>&& buffer, size_t width, size_t height)
         : pixelBuffer_(std::move(buffer)), width_(width), height_(height){}
 
-    Image::Image(const size_t width, const size_t height, const Pixel& pixel){
+    template<class P>
+    BasicImage<P>::BasicImage(const size_t width, const size_t height, const P& pixel){
         std::optional<size_t> size = domain::graphics2d::mul_size(width, height);
-        if(!size.has_value()) return;
-        std::unique_ptr<domain::graphics2d::PixelBuffer> tmpBuffer = std::make_unique<PixelBuffer>(size.value(), pixel);
+        if(!size.has_value()){
+            KAF_LOG_WARNING("Image size overflows: %zu x %zu", width, height);
+            return;
+        }
+        std::unique_ptr<BufferType> tmpBuffer = std::make_unique<BufferType>(size.value(), pixel);
         if(tmpBuffer == nullptr){
             return;
         }
@@ -30,65 +40,69 @@ namespace kaf::domain::graphics2d{
         setWidth(width);
     }
 
-    Image::~Image(){
+    template<class P>
+    BasicImage<P>::~BasicImage(){
         width_ = 0;
         height_ = 0;
         pixelBuffer_ = nullptr;
     }
-    Image::Image(const Image& other){
-        if(other.getPixelBuffer() != nullptr){
-            auto otherBuffer = other.getPixelBuffer();
-            std::unique_ptr<PixelBuffer> tmpBuffer = std::make_unique<PixelBuffer>(otherBuffer->size_);
-            if(tmpBuffer == nullptr) return;
-            bool result = domain::graphics2d::setPixels(*tmpBuffer, otherBuffer->pixels_, otherBuffer->size_, 0);
-            if(!result){
-                tmpBuffer = nullptr;
-                return;
-            }
-            setPixelBuffer(std::move(tmpBuffer));
-        } else {
-            setPixelBuffer(nullptr);
-        }
-        setHeight(other.getHeight());
-        setWidth(other.getWidth());
-    }
-    Image& Image::operator=(const Image& other){
+    template<class P>
+    BasicImage<P>::BasicImage(const BasicImage& other)
+        : width_(other.width_), height_(other.height_), pixelBuffer_(other.pixelBuffer_){}
+    template<class P>
+    BasicImage<P>& BasicImage<P>::operator=(const BasicImage& other){
         if(this == &other){
             return *this;
         }
-        if(other.getPixelBuffer() != nullptr){
-            auto otherBuffer = other.getPixelBuffer();
-            std::unique_ptr<domain::graphics2d::PixelBuffer> tmpBuffer = std::make_unique<domain::graphics2d::PixelBuffer>(otherBuffer->size_);
-            if(tmpBuffer == nullptr) return *this;
-            bool result = domain::graphics2d::setPixels(*tmpBuffer, otherBuffer->pixels_, otherBuffer->size_, 0);
-            if(!result){
-                tmpBuffer = nullptr;
-                return *this;
-            }
-            setPixelBuffer(std::move(tmpBuffer));
-        } else {
-            setPixelBuffer(nullptr);
-        }
+        pixelBuffer_ = other.pixelBuffer_;
         setHeight(other.getHeight());
         setWidth(other.getWidth());
         return *this;
     }
-    Image::Image(Image&& other){
-        setHeight(other.getHeight());
-        setWidth(other.getWidth());
-        setPixelBuffer(other.passPixelBuffer());
-    }
-    Image& Image::operator=(Image&& other){
+    template<class P>
+    BasicImage<P>::BasicImage(BasicImage&& other)
+        : width_(other.width_), height_(other.height_), pixelBuffer_(std::move(other.pixelBuffer_)){}
+    template<class P>
+    BasicImage<P>& BasicImage<P>::operator=(BasicImage&& other){
         if(this == &other){
             return *this;
         }
         setHeight(other.getHeight());
         setWidth(other.getWidth());
-        setPixelBuffer(other.passPixelBuffer());
+        pixelBuffer_ = std::move(other.pixelBuffer_);
         return *this;
     }
 
-    bool Image::isValid() const {
+    template<class P>
+    void BasicImage<P>::detach(){
+        if(!isShared()){
+            // 他のスレッドで破棄されたコピーの読み取りが、この後の書き込みより前に済んだことを保証する
+            // （use_count は relaxed な読み取りのため、参照カウントの release な減算と対になる acquire が要る）
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return;
+        }
+        const BufferType& shared = *pixelBuffer_;
+        auto copied = std::make_shared<BufferType>(shared.size_, UNINITIALIZED);
+        if(shared.pixels_ && copied->pixels_){
+            std::copy(shared.pixels_.get(), shared.pixels_.get() + shared.size_, copied->pixels_.get());
+        }
+        KAF_LOG_TRACE("Copy on write: %zu pixels", shared.size_);
+        pixelBuffer_ = std::move(copied);
+    }
+
+    template<class P>
+    std::unique_ptr<typename BasicImage<P>::BufferType> BasicImage<P>::passPixelBuffer(){
+        if(!pixelBuffer_){
+            return nullptr;
+        }
+        detach();
+        auto buffer = std::make_unique<BufferType>(std::move(*pixelBuffer_));
+        pixelBuffer_ = nullptr;
+        return buffer;
+    }
+
+    template<class P>
+    bool BasicImage<P>::isValid() const {
         if(!pixelBuffer_){
             return false;
         }
@@ -105,7 +119,8 @@ namespace kaf::domain::graphics2d{
         return true;
     }
 
-    Pixel* Image::getPixel(size_t width, size_t height)const {
+    template<class P>
+    const P* BasicImage<P>::getPixel(size_t width, size_t height)const {
         if(!getPixelBuffer()){
             return nullptr;
         }
@@ -121,7 +136,17 @@ namespace kaf::domain::graphics2d{
         return &(getPixelBuffer()->pixels_[height * width_ + width]);
     }
 
-    bool Image::setPixel(size_t width, size_t height, const Pixel& pixel ){
+    template<class P>
+    P* BasicImage<P>::getPixel(size_t width, size_t height) {
+        if(std::as_const(*this).getPixel(width, height) == nullptr){
+            return nullptr;
+        }
+        detach();
+        return &(pixelBuffer_->pixels_[height * width_ + width]);
+    }
+
+    template<class P>
+    bool BasicImage<P>::setPixel(size_t width, size_t height, const P& pixel ){
         if(!getPixelBuffer()){
             return false;
         }
@@ -134,11 +159,13 @@ namespace kaf::domain::graphics2d{
         if(getHeight() < height){
             return false;
         }
-        getPixelBuffer()->pixels_[height * width_ + width] = pixel;
+        detach();
+        pixelBuffer_->pixels_[height * width_ + width] = pixel;
         return true;
     }
 
-    std::unique_ptr<Image> createImage(std::unique_ptr<PixelBuffer>&& buffer, const size_t width, const size_t height) {
+    template<class P>
+    std::unique_ptr<BasicImage<P>> createImage(std::unique_ptr<BasicPixelBuffer<P>>&& buffer, const size_t width, const size_t height) {
         auto expectedSize = mul_size(width, height);
         if(!expectedSize.has_value()){
             return nullptr;
@@ -146,10 +173,11 @@ namespace kaf::domain::graphics2d{
         if(buffer->size_ < expectedSize.value()){
             return nullptr;
         }
-        return std::make_unique<Image>(std::move(buffer), width, height);
+        return std::make_unique<BasicImage<P>>(std::move(buffer), width, height);
     }
 
-    std::unique_ptr<Image> copyImage(const PixelBuffer& buffer, size_t width, size_t height) {
+    template<class P>
+    std::unique_ptr<BasicImage<P>> copyImage(const BasicPixelBuffer<P>& buffer, size_t width, size_t height) {
         auto expectedSize = mul_size(width, height);
         if(!expectedSize.has_value()){
             return nullptr;
@@ -157,15 +185,16 @@ namespace kaf::domain::graphics2d{
         if(buffer.size_ != expectedSize.value()){
             return nullptr;
         }
-        auto newBuffer = std::make_unique<PixelBuffer>(expectedSize.value());
+        auto newBuffer = std::make_unique<BasicPixelBuffer<P>>(expectedSize.value(), UNINITIALIZED);
         if(!newBuffer || !newBuffer->isValid()){
             return nullptr;
         }
         std::copy(buffer.pixels_.get(), buffer.pixels_.get() + expectedSize.value(), newBuffer->pixels_.get());
-        return std::make_unique<Image>(std::move(newBuffer), width, height);
+        return std::make_unique<BasicImage<P>>(std::move(newBuffer), width, height);
     }
 
-    std::unique_ptr<Image> createImage(const std::vector<Pixel>& pixels, size_t width, size_t height) {
+    template<class P>
+    std::unique_ptr<BasicImage<P>> createImage(const std::vector<P>& pixels, size_t width, size_t height) {
         auto expectedSize = mul_size(width, height);
         if(!expectedSize.has_value()){
             return nullptr;
@@ -173,12 +202,53 @@ namespace kaf::domain::graphics2d{
         if(pixels.size() != expectedSize.value()){
             return nullptr;
         }
-        auto newBuffer = std::make_unique<PixelBuffer>(expectedSize.value());
+        auto newBuffer = std::make_unique<BasicPixelBuffer<P>>(expectedSize.value(), UNINITIALIZED);
         if(!newBuffer || !newBuffer->isValid()){
             return nullptr;
         }
         std::copy(pixels.begin(), pixels.end(), newBuffer->pixels_.get());
-        return std::make_unique<Image>(std::move(newBuffer), width, height);
+        return std::make_unique<BasicImage<P>>(std::move(newBuffer), width, height);
     }
 
+    template<class To, class From>
+    std::unique_ptr<BasicImage<To>> convertImage(const BasicImage<From>& image) {
+        if(!image.isValid()){
+            return nullptr;
+        }
+        const size_t size = image.getWidth() * image.getHeight();
+        auto newBuffer = std::make_unique<BasicPixelBuffer<To>>(size, UNINITIALIZED);
+        if(!newBuffer || !newBuffer->isValid()){
+            return nullptr;
+        }
+        const From* source = image.getPixelBuffer()->pixels_.get();
+        std::transform(source, source + size, newBuffer->pixels_.get(), [](const From& pixel){ return convertPixel<To>(pixel); });
+        return std::make_unique<BasicImage<To>>(std::move(newBuffer), image.getWidth(), image.getHeight());
+    }
+
+#define KAF_INSTANTIATE_IMAGE(P) \
+    template class BasicImage<P>; \
+    template std::unique_ptr<BasicImage<P>> createImage<P>(std::unique_ptr<BasicPixelBuffer<P>>&&, const size_t, const size_t); \
+    template std::unique_ptr<BasicImage<P>> copyImage<P>(const BasicPixelBuffer<P>&, size_t, size_t); \
+    template std::unique_ptr<BasicImage<P>> createImage<P>(const std::vector<P>&, size_t, size_t);
+
+    KAF_INSTANTIATE_IMAGE(Pixel)
+    KAF_INSTANTIATE_IMAGE(RGBA8)
+    KAF_INSTANTIATE_IMAGE(BGRA8)
+    KAF_INSTANTIATE_IMAGE(BGR8)
+    KAF_INSTANTIATE_IMAGE(Gray8)
+#undef KAF_INSTANTIATE_IMAGE
+
+#define KAF_INSTANTIATE_CONVERT_IMAGE(To) \
+    template std::unique_ptr<BasicImage<To>> convertImage<To, Pixel>(const BasicImage<Pixel>&); \
+    template std::unique_ptr<BasicImage<To>> convertImage<To, RGBA8>(const BasicImage<RGBA8>&); \
+    template std::unique_ptr<BasicImage<To>> convertImage<To, BGRA8>(const BasicImage<BGRA8>&); \
+    template std::unique_ptr<BasicImage<To>> convertImage<To, BGR8>(const BasicImage<BGR8>&); \
+    template std::unique_ptr<BasicImage<To>> convertImage<To, Gray8>(const BasicImage<Gray8>&);
+
+    KAF_INSTANTIATE_CONVERT_IMAGE(Pixel)
+    KAF_INSTANTIATE_CONVERT_IMAGE(RGBA8)
+    KAF_INSTANTIATE_CONVERT_IMAGE(BGRA8)
+    KAF_INSTANTIATE_CONVERT_IMAGE(BGR8)
+    KAF_INSTANTIATE_CONVERT_IMAGE(Gray8)
+#undef KAF_INSTANTIATE_CONVERT_IMAGE
 }
@@ -0,0 +1,68 @@
+/**
+ * @file image_view.cpp
+ * @brief ImageView 関連ユーティリティの実装。
+ */
+#include "../include/image_view.hpp"
+
+#include <algorithm>
+
+namespace kaf::domain::graphics2d{
+    template<class P>
+    std::vector<BasicImageView<P>> splitTiles(const BasicImageView<P>& view, const size_t tileWidth, const size_t tileHeight){
+        std::vector<BasicImageView<P>> tiles;
+        if(!view.isValid() || tileWidth == 0 || tileHeight == 0){
+            return tiles;
+        }
+        const size_t columns = (view.getWidth() + tileWidth - 1) / tileWidth;
+        const size_t rows = (view.getHeight() + tileHeight - 1) / tileHeight;
+        tiles.reserve(columns * rows);
+        for(size_t y = 0; y < view.getHeight(); y += tileHeight){
+            const size_t height = std::min(tileHeight, view.getHeight() - y);
+            for(size_t x = 0; x < view.getWidth(); x += tileWidth){
+                tiles.push_back(view.subView(x, y, std::min(tileWidth, view.getWidth() - x), height));
+            }
+        }
+        return tiles;
+    }
+
+    template<class P>
+    bool copyPixels(const BasicImageView<const typename BasicImageView<P>::ValueType>& source, const BasicImageView<P>& destination){
+        if(!source.isValid() || !destination.isValid() ||
+            source.getWidth() != destination.getWidth() || source.getHeight() != destination.getHeight()){
+            return false;
+        }
+        for(size_t y = 0; y < source.getHeight(); ++y){
+            const auto sourceRow = source.row(y);
+            std::copy(sourceRow.begin(), sourceRow.end(), destination.rowData(y));
+        }
+        return true;
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> createImage(const BasicImageView<const P>& view){
+        if(!view.isValid()){
+            return nullptr;
+        }
+        auto buffer = std::make_unique<BasicPixelBuffer<P>>(view.getWidth() * view.getHeight(), UNINITIALIZED);
+        if(!buffer->isValid()){
+            return nullptr;
+        }
+        if(!copyPixels(view, makeView(*buffer, view.getWidth(), view.getHeight()))){
+            return nullptr;
+        }
+        return std::make_unique<BasicImage<P>>(std::move(buffer), view.getWidth(), view.getHeight());
+    }
+
+#define KAF_INSTANTIATE_IMAGE_VIEW(P) \
+    template std::vector<BasicImageView<P>> splitTiles<P>(const BasicImageView<P>&, const size_t, const size_t); \
+    template std::vector<BasicImageView<const P>> splitTiles<const P>(const BasicImageView<const P>&, const size_t, const size_t); \
+    template bool copyPixels<P>(const BasicImageView<const P>&, const BasicImageView<P>&); \
+    template std::unique_ptr<BasicImage<P>> createImage<P>(const BasicImageView<const P>&);
+
+    KAF_INSTANTIATE_IMAGE_VIEW(Pixel)
+    KAF_INSTANTIATE_IMAGE_VIEW(RGBA8)
+    KAF_INSTANTIATE_IMAGE_VIEW(BGRA8)
+    KAF_INSTANTIATE_IMAGE_VIEW(BGR8)
+    KAF_INSTANTIATE_IMAGE_VIEW(Gray8)
+#undef KAF_INSTANTIATE_IMAGE_VIEW
+}
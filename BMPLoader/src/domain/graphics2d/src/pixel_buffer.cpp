@@ -4,20 +4,41 @@
  */
 #include "../include/pixel_buffer.hpp"
 #include "../include/pixel.hpp"
+#include "../include/pixel_format.hpp"
 
 #include <algorithm>
+#include <limits>
 
 namespace kaf::domain::graphics2d{
-    PixelBuffer::PixelBuffer(const size_t size, const Pixel& pixel) {
-        if(size_ > 0 || pixels_ != nullptr) { pixels_ = nullptr; }
-        std::unique_ptr<Pixel[]> pixelArray = std::make_unique<Pixel[]>(size);
-        if(!pixelArray) { return; }
+    template<class P>
+    BasicPixelBuffer<P>::BasicPixelBuffer(const size_t size, const P& pixel)
+        : BasicPixelBuffer(size, UNINITIALIZED){
+        if(pixels_){
+            std::fill(pixels_.get(), pixels_.get() + size_, pixel);
+        }
+    }
+
+    template<class P>
+    BasicPixelBuffer<P>::BasicPixelBuffer(const size_t size, UninitializedTag, PixelBufferPool* pool) {
+        if(size == 0 || size > std::numeric_limits<size_t>::max() / sizeof(P)) { return; }
+        PixelStorageDeleter deleter;
+        void* storage = allocatePixelStorage(size * sizeof(P), pool, deleter);
+        if(storage == nullptr) { return; }
+        pixels_ = PixelArray<P>(static_cast<P*>(storage), std::move(deleter));
         size_ = size;
-        std::fill(pixelArray.get(), pixelArray.get() + size, pixel);
-        pixels_ = std::move(pixelArray);
     }
 
-    bool setPixels(PixelBuffer& target, const std::unique_ptr<Pixel[]>& pixelArray, const size_t size, const size_t startPos){
+    template<class P>
+    bool setPixels(BasicPixelBuffer<P>& target, const std::unique_ptr<P[]>& pixelArray, const size_t size, const size_t startPos){
+        if(target.isValid() && pixelArray && size > 0 && startPos + size <= target.size_){
+            std::copy(pixelArray.get(), pixelArray.get() + size, target.pixels_.get() + startPos);
+            return true;
+        }
+        return false;
+    }
+
+    template<class P>
+    bool setPixels(BasicPixelBuffer<P>& target, const PixelArray<P>& pixelArray, const size_t size, const size_t startPos){
         if(target.isValid() && pixelArray && size > 0 && startPos + size <= target.size_){
             std::copy(pixelArray.get(), pixelArray.get() + size, target.pixels_.get() + startPos);
             return true;
@@ -25,25 +46,43 @@ namespace kaf::domain::graphics2d{
         return false;
     }
 
-    bool setPixels(PixelBuffer& target, const std::vector<Pixel>& pixelList, const size_t startPos) {
+    template<class P>
+    bool setPixels(BasicPixelBuffer<P>& target, const std::vector<P>& pixelList, const size_t startPos) {
         if(target.isValid() && !pixelList.empty() && startPos + pixelList.size() <= target.size_){
             std::copy(pixelList.begin(), pixelList.end(), target.pixels_.get() + startPos);
             return true;
         }
         return false;
     }
-    bool setPixel(PixelBuffer& target, const Pixel& pixel, const size_t pos){
+    template<class P>
+    bool setPixel(BasicPixelBuffer<P>& target, const P& pixel, const size_t pos){
         if(target.isValid() && pos < target.size_){
             target.pixels_[pos] = pixel;
             return true;
         }
         return false;
     }
-    bool getPixel(const PixelBuffer& buffer, Pixel& pixel, const size_t pos){
+    template<class P>
+    bool getPixel(const BasicPixelBuffer<P>& buffer, P& pixel, const size_t pos){
         if(buffer.isValid() && pos < buffer.size_){
             pixel = buffer.pixels_[pos];
             return true;
         }
         return false;
     }
+
+#define KAF_INSTANTIATE_PIXEL_BUFFER(P) \
+    template struct BasicPixelBuffer<P>; \
+    template bool setPixels<P>(BasicPixelBuffer<P>&, const std::unique_ptr<P[]>&, const size_t, const size_t); \
+    template bool setPixels<P>(BasicPixelBuffer<P>&, const PixelArray<P>&, const size_t, const size_t); \
+    template bool setPixels<P>(BasicPixelBuffer<P>&, const std::vector<P>&, const size_t); \
+    template bool setPixel<P>(BasicPixelBuffer<P>&, const P&, const size_t); \
+    template bool getPixel<P>(const BasicPixelBuffer<P>&, P&, const size_t);
+
+    KAF_INSTANTIATE_PIXEL_BUFFER(Pixel)
+    KAF_INSTANTIATE_PIXEL_BUFFER(RGBA8)
+    KAF_INSTANTIATE_PIXEL_BUFFER(BGRA8)
+    KAF_INSTANTIATE_PIXEL_BUFFER(BGR8)
+    KAF_INSTANTIATE_PIXEL_BUFFER(Gray8)
+#undef KAF_INSTANTIATE_PIXEL_BUFFER
 }
@@ -0,0 +1,123 @@
+/**
+ * @file pixel_buffer_pool.cpp
+ * @brief PixelBufferPool とアライメント付き確保の実装。
+ */
+#include "../include/pixel_buffer_pool.hpp"
+
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace kaf::domain::graphics2d{
+    namespace {
+        void* allocateAligned(const size_t bytes){
+            return ::operator new(bytes, std::align_val_t{PIXEL_BUFFER_ALIGNMENT});
+        }
+
+        void freeAligned(void* storage) noexcept{
+            ::operator delete(storage, std::align_val_t{PIXEL_BUFFER_ALIGNMENT});
+        }
+    }
+
+    struct PixelBufferPool::State{
+        explicit State(const size_t maxRetainedBytes): maxRetainedBytes_(maxRetainedBytes){}
+        ~State(){ clear(); }
+
+        void clear(){
+            std::lock_guard<std::mutex> lock(mutex_);
+            for(auto& [bytes, blocks] : free_){
+                for(void* block : blocks){
+                    freeAligned(block);
+                }
+            }
+            free_.clear();
+            retainedBytes_ = 0;
+        }
+
+        /** @brief 領域を保持します。上限を超える場合は解放します。 */
+        void put(void* storage, const size_t bytes) noexcept{
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if(retainedBytes_ + bytes <= maxRetainedBytes_){
+                    try{
+                        free_[bytes].push_back(storage);
+                        retainedBytes_ += bytes;
+                        return;
+                    }
+                    catch(...){
+                        // 保持できない場合は解放する
+                    }
+                }
+            }
+            freeAligned(storage);
+        }
+
+        const size_t maxRetainedBytes_;
+        mutable std::mutex mutex_;
+        std::unordered_map<size_t, std::vector<void*>> free_;
+        size_t retainedBytes_ = 0;
+        size_t reuseCount_ = 0;
+    };
+
+    PixelBufferPool::PixelBufferPool(const size_t maxRetainedBytes)
+        : state_(std::make_shared<State>(maxRetainedBytes)){}
+
+    void* PixelBufferPool::acquire(const size_t bytes){
+        if(bytes == 0){
+            return nullptr;
+        }
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex_);
+            auto found = state_->free_.find(bytes);
+            if(found != state_->free_.end() && !found->second.empty()){
+                void* block = found->second.back();
+                found->second.pop_back();
+                state_->retainedBytes_ -= bytes;
+                ++state_->reuseCount_;
+                return block;
+            }
+        }
+        return allocateAligned(bytes);
+    }
+
+    void PixelBufferPool::release(void* storage, const size_t bytes) noexcept{
+        if(storage != nullptr){
+            state_->put(storage, bytes);
+        }
+    }
+
+    void PixelBufferPool::clear(){
+        state_->clear();
+    }
+
+    size_t PixelBufferPool::getRetainedBytes() const{
+        std::lock_guard<std::mutex> lock(state_->mutex_);
+        return state_->retainedBytes_;
+    }
+
+    size_t PixelBufferPool::getReuseCount() const{
+        std::lock_guard<std::mutex> lock(state_->mutex_);
+        return state_->reuseCount_;
+    }
+
+    void PixelStorageDeleter::operator()(void* storage) const noexcept{
+        if(storage == nullptr){
+            return;
+        }
+        if(pool_){
+            pool_->put(storage, bytes_);
+            return;
+        }
+        freeAligned(storage);
+    }
+
+    void* allocatePixelStorage(const size_t bytes, PixelBufferPool* pool, PixelStorageDeleter& deleter){
+        deleter.bytes_ = bytes;
+        deleter.pool_ = pool != nullptr ? pool->getState() : nullptr;
+        if(bytes == 0){
+            return nullptr;
+        }
+        return pool != nullptr ? pool->acquire(bytes) : allocateAligned(bytes);
+    }
+}
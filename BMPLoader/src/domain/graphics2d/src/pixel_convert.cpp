@@ -0,0 +1,436 @@
+/**
+ * @file pixel_convert.cpp
+ * @brief 8bit BGR(A) ⇔ Pixel 変換カーネルの実装。
+ * @details AVX2 版は関数単位のターゲット指定でビルドするため、全体のコンパイルオプションは変更しません。
+ */
+#include "../include/pixel_convert.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define KAF_PIXEL_CONVERT_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define KAF_TARGET_AVX2
+#else
+#define KAF_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define KAF_PIXEL_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace kaf::domain::graphics2d{
+    namespace {
+        static_assert(sizeof(Pixel) == 4 * sizeof(float), "Pixel must be four packed floats");
+
+        float* floatsOf(Pixel* pixel){ return reinterpret_cast<float*>(pixel); }
+        const float* floatsOf(const Pixel* pixel){ return reinterpret_cast<const float*>(pixel); }
+
+        inline float unitOf(const std::uint8_t value){
+            return static_cast<float>(value) / 255.0f;
+        }
+
+        /** @brief SIMD 版と同じ演算順で [0, 1] → 0〜255 に変換します（NaN は 0）。 */
+        inline std::uint8_t byteOf(const float value){
+            const float positive = value > 0.0f ? value : 0.0f;
+            const float clamped = positive < 1.0f ? positive : 1.0f;
+            return static_cast<std::uint8_t>(clamped * 255.0f + 0.5f);
+        }
+
+        // ---- スカラー実装（SIMD 版の端数処理にも使用） ----
+        template<size_t Stride, bool HasAlpha>
+        void decodeScalar(const std::uint8_t* source, Pixel* destination, size_t count){
+            for(size_t idx = 0; idx < count; ++idx, source += Stride){
+                Pixel& pixel = destination[idx];
+                pixel.r_ = unitOf(source[2]);
+                pixel.g_ = unitOf(source[1]);
+                pixel.b_ = unitOf(source[0]);
+                pixel.a_ = HasAlpha ? unitOf(source[3]) : 1.0f;
+            }
+        }
+
+        template<size_t Stride>
+        void encodeScalar(const Pixel* source, std::uint8_t* destination, size_t count){
+            for(size_t idx = 0; idx < count; ++idx, destination += Stride){
+                const Pixel& pixel = source[idx];
+                destination[0] = byteOf(pixel.b_);
+                destination[1] = byteOf(pixel.g_);
+                destination[2] = byteOf(pixel.r_);
+                if(Stride == 4){
+                    destination[3] = byteOf(pixel.a_);
+                }
+            }
+        }
+
+        const PixelConvertKernels SCALAR_KERNELS{
+            SimdLevel::Scalar,
+            decodeScalar<3, false>,
+            decodeScalar<4, false>,
+            decodeScalar<4, true>,
+            encodeScalar<3>,
+            encodeScalar<4>,
+        };
+
+#if defined(KAF_PIXEL_CONVERT_X86)
+        // ---- SSE2 ----
+        /** @brief [b, g, r, x] の int32 を [r, g, b, a] の float に変換します。 */
+        template<bool HasAlpha>
+        inline void storeBgrxSse2(const __m128i bgrx, float* destination){
+            __m128 value = _mm_div_ps(_mm_cvtepi32_ps(bgrx), _mm_set1_ps(255.0f));
+            value = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+            if(!HasAlpha){
+                const __m128 rgbMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+                value = _mm_or_ps(_mm_and_ps(value, rgbMask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+            }
+            _mm_storeu_ps(destination, value);
+        }
+
+        /** @brief 4 ピクセル分の BGRX バイト列を Pixel に変換します。 */
+        template<bool HasAlpha>
+        inline void decodeFourSse2(const __m128i bytes, Pixel* destination){
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+            const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+            storeBgrxSse2<HasAlpha>(_mm_unpacklo_epi16(low, zero), floatsOf(destination));
+            storeBgrxSse2<HasAlpha>(_mm_unpackhi_epi16(low, zero), floatsOf(destination + 1));
+            storeBgrxSse2<HasAlpha>(_mm_unpacklo_epi16(high, zero), floatsOf(destination + 2));
+            storeBgrxSse2<HasAlpha>(_mm_unpackhi_epi16(high, zero), floatsOf(destination + 3));
+        }
+
+        inline std::int32_t loadInt32(const std::uint8_t* source){
+            std::int32_t value;
+            std::memcpy(&value, source, sizeof(value));
+            return value;
+        }
+
+        void bgr8ToPixelSse2(const std::uint8_t* source, Pixel* destination, size_t count){
+            size_t idx = 0;
+            // 4 バイト単位で読むため、最後の読み込みが行末を越えない範囲だけを処理する
+            for(; idx + 5 <= count; idx += 4){
+                const std::uint8_t* src = source + idx * 3;
+                const __m128i bytes = _mm_set_epi32(loadInt32(src + 9), loadInt32(src + 6), loadInt32(src + 3), loadInt32(src));
+                decodeFourSse2<false>(bytes, destination + idx);
+            }
+            decodeScalar<3, false>(source + idx * 3, destination + idx, count - idx);
+        }
+
+        template<bool HasAlpha>
+        void bgra8ToPixelSse2(const std::uint8_t* source, Pixel* destination, size_t count){
+            size_t idx = 0;
+            for(; idx + 4 <= count; idx += 4){
+                decodeFourSse2<HasAlpha>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + idx * 4)), destination + idx);
+            }
+            decodeScalar<4, HasAlpha>(source + idx * 4, destination + idx, count - idx);
+        }
+
+        /** @brief Pixel 1 個を [b, g, r, a] の int32（0〜255）に変換します。 */
+        inline __m128i quantizeSse2(const float* source){
+            __m128 value = _mm_loadu_ps(source);
+            value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            value = _mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+            value = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+            return _mm_cvttps_epi32(value);
+        }
+
+        /** @brief 4 ピクセルを BGRA の 16 バイトに変換します。 */
+        inline __m128i encodeFourSse2(const Pixel* source){
+            const __m128i low = _mm_packs_epi32(quantizeSse2(floatsOf(source)), quantizeSse2(floatsOf(source + 1)));
+            const __m128i high = _mm_packs_epi32(quantizeSse2(floatsOf(source + 2)), quantizeSse2(floatsOf(source + 3)));
+            return _mm_packus_epi16(low, high);
+        }
+
+        void pixelToBgr8Sse2(const Pixel* source, std::uint8_t* destination, size_t count){
+            size_t idx = 0;
+            // 1 ピクセルごとに 4 バイト書き、次のピクセルで 4 バイト目を上書きする
+            for(; idx + 5 <= count; idx += 4){
+                const __m128i bgra = encodeFourSse2(source + idx);
+                std::uint8_t* dst = destination + idx * 3;
+                const std::int32_t pixel0 = _mm_cvtsi128_si32(bgra);
+                const std::int32_t pixel1 = _mm_cvtsi128_si32(_mm_srli_si128(bgra, 4));
+                const std::int32_t pixel2 = _mm_cvtsi128_si32(_mm_srli_si128(bgra, 8));
+                const std::int32_t pixel3 = _mm_cvtsi128_si32(_mm_srli_si128(bgra, 12));
+                std::memcpy(dst, &pixel0, 4);
+                std::memcpy(dst + 3, &pixel1, 4);
+                std::memcpy(dst + 6, &pixel2, 4);
+                std::memcpy(dst + 9, &pixel3, 4);
+            }
+            encodeScalar<3>(source + idx, destination + idx * 3, count - idx);
+        }
+
+        void pixelToBgra8Sse2(const Pixel* source, std::uint8_t* destination, size_t count){
+            size_t idx = 0;
+            for(; idx + 4 <= count; idx += 4){
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + idx * 4), encodeFourSse2(source + idx));
+            }
+            encodeScalar<4>(source + idx, destination + idx * 4, count - idx);
+        }
+
+        const PixelConvertKernels SSE2_KERNELS{
+            SimdLevel::SSE2,
+            bgr8ToPixelSse2,
+            bgra8ToPixelSse2<false>,
+            bgra8ToPixelSse2<true>,
+            pixelToBgr8Sse2,
+            pixelToBgra8Sse2,
+        };
+
+        // ---- AVX2 ----
+        /** @brief 2 ピクセル分の BGRX（8 バイト）を Pixel に変換します。 */
+        template<bool HasAlpha>
+        KAF_TARGET_AVX2 inline void decodeTwoAvx2(const __m128i bgrx, float* destination){
+            __m256 value = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bgrx)), _mm256_set1_ps(255.0f));
+            value = _mm256_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+            if(!HasAlpha){
+                value = _mm256_blend_ps(value, _mm256_set1_ps(1.0f), 0x88);
+            }
+            _mm256_storeu_ps(destination, value);
+        }
+
+        template<bool HasAlpha>
+        KAF_TARGET_AVX2 inline void decodeFourAvx2(const __m128i bgrx, Pixel* destination){
+            decodeTwoAvx2<HasAlpha>(bgrx, floatsOf(destination));
+            decodeTwoAvx2<HasAlpha>(_mm_srli_si128(bgrx, 8), floatsOf(destination + 2));
+        }
+
+        KAF_TARGET_AVX2 void bgr8ToPixelAvx2(const std::uint8_t* source, Pixel* destination, size_t count){
+            const __m128i expand = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+            size_t idx = 0;
+            // 16 バイト読み込みが行末を越えない範囲だけを処理する
+            for(; idx + 6 <= count; idx += 4){
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + idx * 3));
+                decodeFourAvx2<false>(_mm_shuffle_epi8(bytes, expand), destination + idx);
+            }
+            decodeScalar<3, false>(source + idx * 3, destination + idx, count - idx);
+        }
+
+        template<bool HasAlpha>
+        KAF_TARGET_AVX2 void bgra8ToPixelAvx2(const std::uint8_t* source, Pixel* destination, size_t count){
+            size_t idx = 0;
+            for(; idx + 4 <= count; idx += 4){
+                decodeFourAvx2<HasAlpha>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + idx * 4)), destination + idx);
+            }
+            decodeScalar<4, HasAlpha>(source + idx * 4, destination + idx, count - idx);
+        }
+
+        /** @brief 2 ピクセルを [b, g, r, a] × 2 の int32 に変換します。 */
+        KAF_TARGET_AVX2 inline __m256i quantizeAvx2(const float* source){
+            __m256 value = _mm256_loadu_ps(source);
+            value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+            value = _mm256_add_ps(_mm256_mul_ps(value, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f));
+            value = _mm256_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+            return _mm256_cvttps_epi32(value);
+        }
+
+        KAF_TARGET_AVX2 inline __m128i encodeFourAvx2(const Pixel* source){
+            const __m256i front = quantizeAvx2(floatsOf(source));
+            const __m256i back = quantizeAvx2(floatsOf(source + 2));
+            const __m128i low = _mm_packs_epi32(_mm256_castsi256_si128(front), _mm256_extracti128_si256(front, 1));
+            const __m128i high = _mm_packs_epi32(_mm256_castsi256_si128(back), _mm256_extracti128_si256(back, 1));
+            return _mm_packus_epi16(low, high);
+        }
+
+        KAF_TARGET_AVX2 void pixelToBgr8Avx2(const Pixel* source, std::uint8_t* destination, size_t count){
+            const __m128i compact = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+            size_t idx = 0;
+            for(; idx + 4 <= count; idx += 4){
+                const __m128i bgr = _mm_shuffle_epi8(encodeFourAvx2(source + idx), compact);
+                std::uint8_t* dst = destination + idx * 3;
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), bgr);
+                const std::int32_t tail = _mm_cvtsi128_si32(_mm_srli_si128(bgr, 8));
+                std::memcpy(dst + 8, &tail, 4);
+            }
+            encodeScalar<3>(source + idx, destination + idx * 3, count - idx);
+        }
+
+        KAF_TARGET_AVX2 void pixelToBgra8Avx2(const Pixel* source, std::uint8_t* destination, size_t count){
+            size_t idx = 0;
+            for(; idx + 4 <= count; idx += 4){
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + idx * 4), encodeFourAvx2(source + idx));
+            }
+            encodeScalar<4>(source + idx, destination + idx * 4, count - idx);
+        }
+
+        const PixelConvertKernels AVX2_KERNELS{
+            SimdLevel::AVX2,
+            bgr8ToPixelAvx2,
+            bgra8ToPixelAvx2<false>,
+            bgra8ToPixelAvx2<true>,
+            pixelToBgr8Avx2,
+            pixelToBgra8Avx2,
+        };
+
+        bool cpuSupportsAvx2(){
+#if defined(_MSC_VER) && !defined(__clang__)
+            int registers[4];
+            __cpuid(registers, 0);
+            if(registers[0] < 7){
+                return false;
+            }
+            __cpuid(registers, 1);
+            const bool osSavesYmm = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+            __cpuidex(registers, 7, 0);
+            return osSavesYmm && (registers[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+#if defined(KAF_PIXEL_CONVERT_NEON)
+        // ---- NEON（AArch64） ----
+        inline void widenNeon(const uint8x8_t channel, float32x4_t& low, float32x4_t& high){
+            const float32x4_t scale = vdupq_n_f32(255.0f);
+            const uint16x8_t wide = vmovl_u8(channel);
+            low = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(wide))), scale);
+            high = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(wide))), scale);
+        }
+
+        inline void storeEightNeon(const uint8x8_t b, const uint8x8_t g, const uint8x8_t r, const float32x4_t alphaLow, const float32x4_t alphaHigh, Pixel* destination){
+            float32x4x4_t low, high;
+            widenNeon(r, low.val[0], high.val[0]);
+            widenNeon(g, low.val[1], high.val[1]);
+            widenNeon(b, low.val[2], high.val[2]);
+            low.val[3] = alphaLow;
+            high.val[3] = alphaHigh;
+            vst4q_f32(floatsOf(destination), low);
+            vst4q_f32(floatsOf(destination + 4), high);
+        }
+
+        void bgr8ToPixelNeon(const std::uint8_t* source, Pixel* destination, size_t count){
+            const float32x4_t one = vdupq_n_f32(1.0f);
+            size_t idx = 0;
+            for(; idx + 8 <= count; idx += 8){
+                const uint8x8x3_t bgr = vld3_u8(source + idx * 3);
+                storeEightNeon(bgr.val[0], bgr.val[1], bgr.val[2], one, one, destination + idx);
+            }
+            decodeScalar<3, false>(source + idx * 3, destination + idx, count - idx);
+        }
+
+        template<bool HasAlpha>
+        void bgra8ToPixelNeon(const std::uint8_t* source, Pixel* destination, size_t count){
+            size_t idx = 0;
+            for(; idx + 8 <= count; idx += 8){
+                const uint8x8x4_t bgra = vld4_u8(source + idx * 4);
+                float32x4_t alphaLow = vdupq_n_f32(1.0f);
+                float32x4_t alphaHigh = alphaLow;
+                if(HasAlpha){
+                    widenNeon(bgra.val[3], alphaLow, alphaHigh);
+                }
+                storeEightNeon(bgra.val[0], bgra.val[1], bgra.val[2], alphaLow, alphaHigh, destination + idx);
+            }
+            decodeScalar<4, HasAlpha>(source + idx * 4, destination + idx, count - idx);
+        }
+
+        inline uint8x8_t quantizeNeon(const float32x4_t low, const float32x4_t high){
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const float32x4_t one = vdupq_n_f32(1.0f);
+            const float32x4_t scale = vdupq_n_f32(255.0f);
+            const float32x4_t half = vdupq_n_f32(0.5f);
+            const float32x4_t clampedLow = vminq_f32(vmaxnmq_f32(low, zero), one);
+            const float32x4_t clampedHigh = vminq_f32(vmaxnmq_f32(high, zero), one);
+            const uint32x4_t bytesLow = vcvtq_u32_f32(vaddq_f32(vmulq_f32(clampedLow, scale), half));
+            const uint32x4_t bytesHigh = vcvtq_u32_f32(vaddq_f32(vmulq_f32(clampedHigh, scale), half));
+            return vmovn_u16(vcombine_u16(vmovn_u32(bytesLow), vmovn_u32(bytesHigh)));
+        }
+
+        template<bool HasAlpha>
+        void encodeNeon(const Pixel* source, std::uint8_t* destination, size_t count){
+            constexpr size_t stride = HasAlpha ? 4 : 3;
+            size_t idx = 0;
+            for(; idx + 8 <= count; idx += 8){
+                const float32x4x4_t low = vld4q_f32(floatsOf(source + idx));
+                const float32x4x4_t high = vld4q_f32(floatsOf(source + idx + 4));
+                const uint8x8_t r = quantizeNeon(low.val[0], high.val[0]);
+                const uint8x8_t g = quantizeNeon(low.val[1], high.val[1]);
+                const uint8x8_t b = quantizeNeon(low.val[2], high.val[2]);
+                if(HasAlpha){
+                    const uint8x8x4_t bgra = {{b, g, r, quantizeNeon(low.val[3], high.val[3])}};
+                    vst4_u8(destination + idx * stride, bgra);
+                }
+                else{
+                    const uint8x8x3_t bgr = {{b, g, r}};
+                    vst3_u8(destination + idx * stride, bgr);
+                }
+            }
+            encodeScalar<stride>(source + idx, destination + idx * stride, count - idx);
+        }
+
+        const PixelConvertKernels NEON_KERNELS{
+            SimdLevel::NEON,
+            bgr8ToPixelNeon,
+            bgra8ToPixelNeon<false>,
+            bgra8ToPixelNeon<true>,
+            encodeNeon<false>,
+            encodeNeon<true>,
+        };
+#endif
+    }
+
+    SimdLevel detectSimdLevel(){
+#if defined(KAF_PIXEL_CONVERT_X86)
+        return cpuSupportsAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#elif defined(KAF_PIXEL_CONVERT_NEON)
+        return SimdLevel::NEON;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    bool isSimdLevelSupported(const SimdLevel level){
+        switch(level){
+        case SimdLevel::Scalar:
+            return true;
+#if defined(KAF_PIXEL_CONVERT_X86)
+        case SimdLevel::SSE2:
+            return true;
+        case SimdLevel::AVX2:
+            return cpuSupportsAvx2();
+#elif defined(KAF_PIXEL_CONVERT_NEON)
+        case SimdLevel::NEON:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    const PixelConvertKernels& getPixelConvertKernels(const SimdLevel level){
+        if(!isSimdLevelSupported(level)){
+            return SCALAR_KERNELS;
+        }
+        switch(level){
+#if defined(KAF_PIXEL_CONVERT_X86)
+        case SimdLevel::SSE2:
+            return SSE2_KERNELS;
+        case SimdLevel::AVX2:
+            return AVX2_KERNELS;
+#elif defined(KAF_PIXEL_CONVERT_NEON)
+        case SimdLevel::NEON:
+            return NEON_KERNELS;
+#endif
+        default:
+            return SCALAR_KERNELS;
+        }
+    }
+
+    const PixelConvertKernels& getPixelConvertKernels(){
+        static const PixelConvertKernels& kernels = getPixelConvertKernels(detectSimdLevel());
+        return kernels;
+    }
+
+    const char* toString(const SimdLevel level){
+        switch(level){
+        case SimdLevel::SSE2:
+            return "sse2";
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::NEON:
+            return "neon";
+        default:
+            return "scalar";
+        }
+    }
+}
@@ -0,0 +1,32 @@
+/**
+ * @file premultiplied.cpp
+ * @brief 乗算済み float RGBA との行単位の変換。
+ */
+#include "../include/premultiplied.hpp"
+
+namespace kaf::domain::graphics2d{
+    template<class P>
+    void loadPremultipliedRow(const P* source, Pixel* destination, const size_t width){
+        for(size_t x = 0; x < width; ++x){
+            destination[x] = premultiply(PixelFormat<P>::toPixel(source[x]));
+        }
+    }
+
+    template<class P>
+    void storeUnpremultipliedRow(const Pixel* source, P* destination, const size_t width){
+        for(size_t x = 0; x < width; ++x){
+            destination[x] = PixelFormat<P>::fromPixel(unpremultiply(source[x]));
+        }
+    }
+
+#define KAF_INSTANTIATE_PREMULTIPLIED(P) \
+    template void loadPremultipliedRow<P>(const P*, Pixel*, const size_t); \
+    template void storeUnpremultipliedRow<P>(const Pixel*, P*, const size_t);
+
+    KAF_INSTANTIATE_PREMULTIPLIED(Pixel)
+    KAF_INSTANTIATE_PREMULTIPLIED(RGBA8)
+    KAF_INSTANTIATE_PREMULTIPLIED(BGRA8)
+    KAF_INSTANTIATE_PREMULTIPLIED(BGR8)
+    KAF_INSTANTIATE_PREMULTIPLIED(Gray8)
+#undef KAF_INSTANTIATE_PREMULTIPLIED
+}
@@ -0,0 +1,252 @@
+/**
+ * @file resize.cpp
+ * @brief 分離可能フィルタによるリサイズの実装。
+ * @details 重みの計算と窓の取り方は Pillow（ImagingResample）と同じ方式です。
+ *          Pixel 1 個（float×4）を 1 本の SIMD レジスタとして積和します。
+ */
+#include "../include/resize.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "../include/parallel.hpp"
+#include "../include/pixel_buffer.hpp"
+#include "../include/pixel_format.hpp"
+#include "../include/pixel_vec4.hpp"
+#include "../include/premultiplied.hpp"
+
+namespace kaf::domain::graphics2d{
+    namespace {
+        using namespace simd;
+
+        constexpr double PI = 3.14159265358979323846;
+        /** @brief 1 タスクが受け持つ出力行数の下限（帯の境界で重複する入力行の割合を抑えます）。 */
+        constexpr size_t MIN_BAND_ROWS = 16;
+
+        // ---- フィルタ ----
+        double filterSupport(const ResizeFilter filter){
+            switch(filter){
+                case ResizeFilter::Bilinear: return 1.0;
+                case ResizeFilter::Bicubic: return 2.0;
+                case ResizeFilter::Lanczos3: return 3.0;
+                default: return 0.5;
+            }
+        }
+
+        double sinc(const double x){
+            if(x == 0.0){
+                return 1.0;
+            }
+            return std::sin(PI * x) / (PI * x);
+        }
+
+        double filterWeight(const ResizeFilter filter, const double x){
+            const double distance = std::fabs(x);
+            switch(filter){
+                case ResizeFilter::Bilinear:
+                    return distance < 1.0 ? 1.0 - distance : 0.0;
+                case ResizeFilter::Bicubic:{
+                    constexpr double a = -0.5;
+                    if(distance < 1.0){
+                        return ((a + 2.0) * distance - (a + 3.0)) * distance * distance + 1.0;
+                    }
+                    if(distance < 2.0){
+                        return (((distance - 5.0) * distance + 8.0) * distance - 4.0) * a;
+                    }
+                    return 0.0;
+                }
+                case ResizeFilter::Lanczos3:
+                    return distance < 3.0 ? sinc(x) * sinc(x / 3.0) : 0.0;
+                default:
+                    return distance < 0.5 ? 1.0 : 0.0;
+            }
+        }
+
+        /**
+         * @struct ResampleWeights
+         * @brief 1 方向分の重み（出力位置ごとに、入力の先頭位置・タップ数・正規化済みの重み）。
+         */
+        struct ResampleWeights{
+            /** 出力 1 個当たりの最大タップ数（weights_ のストライド） */
+            size_t taps_{};
+            std::vector<size_t> first_;
+            std::vector<size_t> count_;
+            std::vector<float> weights_;
+        };
+
+        ResampleWeights computeWeights(const size_t sourceSize, const size_t destinationSize, const ResizeFilter filter){
+            const double scale = static_cast<double>(sourceSize) / static_cast<double>(destinationSize);
+            const double filterScale = std::max(scale, 1.0);
+            const double support = filterSupport(filter) * filterScale;
+
+            ResampleWeights result;
+            result.taps_ = static_cast<size_t>(std::ceil(support)) * 2 + 1;
+            result.first_.resize(destinationSize);
+            result.count_.resize(destinationSize);
+            result.weights_.assign(destinationSize * result.taps_, 0.0f);
+
+            std::vector<double> weights(result.taps_);
+            for(size_t out = 0; out < destinationSize; ++out){
+                const double center = (static_cast<double>(out) + 0.5) * scale;
+                const double low = std::floor(center - support + 0.5);
+                const double high = std::floor(center + support + 0.5);
+                const size_t first = low > 0.0 ? static_cast<size_t>(low) : 0;
+                const size_t last = std::min(high > 0.0 ? static_cast<size_t>(high) : 0, sourceSize);
+                const size_t count = std::min(last > first ? last - first : 0, result.taps_);
+
+                double total = 0.0;
+                for(size_t tap = 0; tap < count; ++tap){
+                    weights[tap] = filterWeight(filter, (static_cast<double>(first + tap) - center + 0.5) / filterScale);
+                    total += weights[tap];
+                }
+                float* destination = &result.weights_[out * result.taps_];
+                for(size_t tap = 0; tap < count; ++tap){
+                    destination[tap] = static_cast<float>(total != 0.0 ? weights[tap] / total : weights[tap]);
+                }
+                result.first_[out] = first;
+                result.count_[out] = count;
+            }
+            return result;
+        }
+
+        // ---- カーネル ----
+        /** @brief 水平方向: 入力 1 行から出力 1 行を求めます。 */
+        void resampleRow(const Pixel* source, Pixel* destination, const ResampleWeights& weights){
+            const size_t width = weights.first_.size();
+            const size_t taps = weights.taps_;
+            const size_t* first = weights.first_.data();
+            const size_t* count = weights.count_.data();
+            const float* weight = weights.weights_.data();
+            for(size_t out = 0; out < width; ++out, weight += taps){
+                const Pixel* window = source + first[out];
+                const size_t windowSize = count[out];
+                Vec4 even = zero4();
+                Vec4 odd = zero4();
+                size_t tap = 0;
+                for(; tap + 2 <= windowSize; tap += 2){
+                    even = madd4(even, load4(window[tap]), weight[tap]);
+                    odd = madd4(odd, load4(window[tap + 1]), weight[tap + 1]);
+                }
+                if(tap < windowSize){
+                    even = madd4(even, load4(window[tap]), weight[tap]);
+                }
+                store4(destination[out], add4(even, odd));
+            }
+        }
+
+        /** @brief 垂直方向: 水平方向の結果（ストライド width の行）から出力 1 行を求めます。 */
+        void resampleColumn(const Pixel* firstRow, const size_t count, const float* weight, Pixel* destination, const size_t width){
+            for(size_t x = 0; x < width; ++x){
+                const Pixel* column = firstRow + x;
+                Vec4 sum = zero4();
+                for(size_t tap = 0; tap < count; ++tap){
+                    sum = madd4(sum, load4(column[tap * width]), weight[tap]);
+                }
+                store4(destination[x], sum);
+            }
+        }
+
+        /** @brief 入力位置の対応表（最近傍）。 */
+        std::vector<size_t> nearestIndices(const size_t sourceSize, const size_t destinationSize){
+            std::vector<size_t> indices(destinationSize);
+            const double scale = static_cast<double>(sourceSize) / static_cast<double>(destinationSize);
+            for(size_t out = 0; out < destinationSize; ++out){
+                indices[out] = std::min(static_cast<size_t>((static_cast<double>(out) + 0.5) * scale), sourceSize - 1);
+            }
+            return indices;
+        }
+
+        template<class P>
+        void resizeNearest(const BasicImageView<const P>& source, const BasicImageView<P>& destination, common::ThreadPool& pool){
+            const std::vector<size_t> columns = nearestIndices(source.getWidth(), destination.getWidth());
+            const std::vector<size_t> rows = nearestIndices(source.getHeight(), destination.getHeight());
+            parallelForRows(destination, [&](PixelSpan<P> row, const size_t y){
+                const P* sourceRow = source.rowData(rows[y]);
+                for(size_t x = 0; x < row.size(); ++x){
+                    row[x] = sourceRow[columns[x]];
+                }
+            }, pool);
+        }
+    }
+
+    const char* toString(const ResizeFilter filter){
+        switch(filter){
+            case ResizeFilter::Nearest: return "nearest";
+            case ResizeFilter::Bilinear: return "bilinear";
+            case ResizeFilter::Bicubic: return "bicubic";
+            case ResizeFilter::Lanczos3: return "lanczos3";
+        }
+        return "unknown";
+    }
+
+    template<class P>
+    bool resizeView(const BasicImageView<const P>& source, const BasicImageView<P>& destination, const ResizeFilter filter, common::ThreadPool& pool){
+        if(!source.isValid() || !destination.isValid()){
+            return false;
+        }
+        if(filter == ResizeFilter::Nearest){
+            resizeNearest(source, destination, pool);
+            return true;
+        }
+
+        const size_t sourceWidth = source.getWidth();
+        const size_t width = destination.getWidth();
+        const size_t height = destination.getHeight();
+        const ResampleWeights horizontal = computeWeights(sourceWidth, width, filter);
+        const ResampleWeights vertical = computeWeights(source.getHeight(), height, filter);
+
+        // 出力を行の帯（タイル）に分け、帯ごとに必要な入力行だけを水平方向に処理してから垂直方向に畳み込みます。
+        // 中間結果が帯の大きさに収まるためキャッシュに載り、帯どうしは独立に並列処理できます。
+        const size_t grain = std::max(parallelRowGrain(width * vertical.taps_, height, pool.getConcurrency()), MIN_BAND_ROWS);
+        std::atomic<bool> allocated{true};
+        pool.parallelFor(0, height, grain, [&](const size_t begin, const size_t end){
+            const size_t sourceFirst = vertical.first_[begin];
+            const size_t sourceEnd = vertical.first_[end - 1] + vertical.count_[end - 1];
+            BasicPixelBuffer<Pixel> band((sourceEnd - sourceFirst) * width + 1, UNINITIALIZED);
+            BasicPixelBuffer<Pixel> line(std::max(sourceWidth, width), UNINITIALIZED);
+            if(!band.isValid() || !line.isValid()){
+                allocated.store(false, std::memory_order_relaxed);
+                return;
+            }
+            for(size_t y = sourceFirst; y < sourceEnd; ++y){
+                loadPremultipliedRow(source.rowData(y), line.pixels_.get(), sourceWidth);
+                resampleRow(line.pixels_.get(), band.pixels_.get() + (y - sourceFirst) * width, horizontal);
+            }
+            for(size_t y = begin; y < end; ++y){
+                resampleColumn(band.pixels_.get() + (vertical.first_[y] - sourceFirst) * width, vertical.count_[y],
+                    &vertical.weights_[y * vertical.taps_], line.pixels_.get(), width);
+                storeUnpremultipliedRow(line.pixels_.get(), destination.rowData(y), width);
+            }
+        });
+        return allocated.load(std::memory_order_relaxed);
+    }
+
+    template<class P>
+    std::unique_ptr<BasicImage<P>> resizeImage(const BasicImage<P>& source, const size_t width, const size_t height, const ResizeFilter filter, common::ThreadPool& pool){
+        const auto size = mul_size(width, height);
+        if(!source.isValid() || !size.has_value() || size.value() == 0){
+            return nullptr;
+        }
+        auto buffer = std::make_unique<BasicPixelBuffer<P>>(size.value(), UNINITIALIZED);
+        if(!buffer->isValid()){
+            return nullptr;
+        }
+        if(!resizeView(makeView(source), makeView(*buffer, width, height), filter, pool)){
+            return nullptr;
+        }
+        return std::make_unique<BasicImage<P>>(std::move(buffer), width, height);
+    }
+
+#define KAF_INSTANTIATE_RESIZE(P) \
+    template bool resizeView<P>(const BasicImageView<const P>&, const BasicImageView<P>&, const ResizeFilter, common::ThreadPool&); \
+    template std::unique_ptr<BasicImage<P>> resizeImage<P>(const BasicImage<P>&, const size_t, const size_t, const ResizeFilter, common::ThreadPool&);
+
+    KAF_INSTANTIATE_RESIZE(Pixel)
+    KAF_INSTANTIATE_RESIZE(RGBA8)
+    KAF_INSTANTIATE_RESIZE(BGRA8)
+    KAF_INSTANTIATE_RESIZE(BGR8)
+    KAF_INSTANTIATE_RESIZE(Gray8)
+#undef KAF_INSTANTIATE_RESIZE
+}
@@ -0,0 +1,336 @@
+/**
+ * @file statistics.cpp
+ * @brief 画像の統計と自動レベル補正の実装。
+ */
+#include "../include/statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+
+#include "../include/parallel.hpp"
+#include "../include/premultiplied.hpp"
+
+namespace kaf::domain::graphics2d{
+    namespace {
+        constexpr size_t CHANNELS = 4;
+        using Histogram = std::array<std::uint64_t, HISTOGRAM_BINS>;
+
+        /**
+         * @brief タスクローカルの集計。
+         * @details 同じ値が続く画像で同じビンへの加算が直列に並ばないよう、
+         *          偶数・奇数番目のピクセルを別のヒストグラムに数え、最後に合算します。
+         */
+        struct Accumulator{
+            std::array<std::array<Histogram, CHANNELS>, 2> histograms_{};
+            /** Pixel のみ（8bit 形式はヒストグラムから求めます） */
+            std::array<double, CHANNELS> sum_{};
+            std::array<double, CHANNELS> sumSquares_{};
+            std::array<float, CHANNELS> min_{};
+            std::array<float, CHANNELS> max_{};
+            size_t count_{};
+
+            Accumulator(){
+                min_.fill(std::numeric_limits<float>::infinity());
+                max_.fill(-std::numeric_limits<float>::infinity());
+            }
+
+            void merge(const Accumulator& other){
+                for(size_t lane = 0; lane < 2; ++lane){
+                    for(size_t channel = 0; channel < CHANNELS; ++channel){
+                        for(size_t bin = 0; bin < HISTOGRAM_BINS; ++bin){
+                            histograms_[0][channel][bin] += other.histograms_[lane][channel][bin];
+                        }
+                    }
+                }
+                for(size_t channel = 0; channel < CHANNELS; ++channel){
+                    sum_[channel] += other.sum_[channel];
+                    sumSquares_[channel] += other.sumSquares_[channel];
+                    min_[channel] = std::min(min_[channel], other.min_[channel]);
+                    max_[channel] = std::max(max_[channel], other.max_[channel]);
+                }
+                count_ += other.count_;
+            }
+        };
+
+        inline void countPixel(std::array<Histogram, CHANNELS>& histogram, const RGBA8& pixel){
+            ++histogram[0][pixel.r_]; ++histogram[1][pixel.g_]; ++histogram[2][pixel.b_]; ++histogram[3][pixel.a_];
+        }
+        inline void countPixel(std::array<Histogram, CHANNELS>& histogram, const BGRA8& pixel){
+            ++histogram[0][pixel.r_]; ++histogram[1][pixel.g_]; ++histogram[2][pixel.b_]; ++histogram[3][pixel.a_];
+        }
+        inline void countPixel(std::array<Histogram, CHANNELS>& histogram, const BGR8& pixel){
+            ++histogram[0][pixel.r_]; ++histogram[1][pixel.g_]; ++histogram[2][pixel.b_];
+        }
+        inline void countPixel(std::array<Histogram, CHANNELS>& histogram, const Gray8& pixel){
+            ++histogram[0][pixel.v_];
+        }
+
+        inline void accumulateValue(Accumulator& accumulator, const size_t channel, const float value){
+            ++accumulator.histograms_[0][channel][unitToByte(value)];
+            accumulator.sum_[channel] += value;
+            accumulator.sumSquares_[channel] += static_cast<double>(value) * value;
+            accumulator.min_[channel] = std::min(accumulator.min_[channel], value);
+            accumulator.max_[channel] = std::max(accumulator.max_[channel], value);
+        }
+
+        /** @brief 行の x = 0, step, 2 * step, ... のピクセルを集計します。 */
+        template<class P>
+        void accumulateRow(const P* row, const size_t width, const size_t step, Accumulator& accumulator){
+            size_t count = 0;
+            if constexpr(std::is_same_v<P, Pixel>){
+                for(size_t x = 0; x < width; x += step, ++count){
+                    accumulateValue(accumulator, 0, row[x].r_);
+                    accumulateValue(accumulator, 1, row[x].g_);
+                    accumulateValue(accumulator, 2, row[x].b_);
+                    accumulateValue(accumulator, 3, row[x].a_);
+                }
+            }
+            else{
+                size_t x = 0;
+                for(; x + step < width; x += step * 2, count += 2){
+                    countPixel(accumulator.histograms_[0], row[x]);
+                    countPixel(accumulator.histograms_[1], row[x + step]);
+                }
+                for(; x < width; x += step, ++count){
+                    countPixel(accumulator.histograms_[0], row[x]);
+                }
+            }
+            accumulator.count_ += count;
+        }
+
+        /** @brief 8bit 形式の集計結果から統計を求めます。 */
+        void fromHistogram(ChannelStatistics& statistics){
+            std::uint64_t count = 0;
+            double sum = 0.0;
+            double sumSquares = 0.0;
+            size_t first = HISTOGRAM_BINS;
+            size_t last = 0;
+            for(size_t bin = 0; bin < HISTOGRAM_BINS; ++bin){
+                const std::uint64_t frequency = statistics.histogram_[bin];
+                if(frequency == 0){
+                    continue;
+                }
+                first = std::min(first, bin);
+                last = bin;
+                count += frequency;
+                sum += static_cast<double>(bin) * frequency;
+                sumSquares += static_cast<double>(bin * bin) * frequency;
+            }
+            if(count == 0){
+                return;
+            }
+            const double mean = sum / count;
+            const double variance = std::max(0.0, sumSquares / count - mean * mean);
+            statistics.min_ = static_cast<float>(first) / 255.0f;
+            statistics.max_ = static_cast<float>(last) / 255.0f;
+            statistics.mean_ = static_cast<float>(mean / 255.0);
+            statistics.stddev_ = static_cast<float>(std::sqrt(variance) / 255.0);
+        }
+
+        template<class P>
+        void finish(const Accumulator& accumulator, ImageStatistics& statistics){
+            statistics.sampleCount_ = accumulator.count_;
+            for(size_t channel = 0; channel < CHANNELS; ++channel){
+                statistics.channels_[channel].histogram_ = accumulator.histograms_[0][channel];
+            }
+            if constexpr(std::is_same_v<P, Gray8>){
+                statistics.channels_[1].histogram_ = statistics.channels_[0].histogram_;
+                statistics.channels_[2].histogram_ = statistics.channels_[0].histogram_;
+            }
+            if constexpr(std::is_same_v<P, Gray8> || std::is_same_v<P, BGR8>){
+                // アルファを持たない形式は不透明
+                statistics.channels_[3].histogram_[HISTOGRAM_BINS - 1] = accumulator.count_;
+            }
+
+            for(size_t channel = 0; channel < CHANNELS; ++channel){
+                ChannelStatistics& target = statistics.channels_[channel];
+                if constexpr(std::is_same_v<P, Pixel>){
+                    if(accumulator.count_ == 0){
+                        continue;
+                    }
+                    const double mean = accumulator.sum_[channel] / accumulator.count_;
+                    const double variance = std::max(0.0, accumulator.sumSquares_[channel] / accumulator.count_ - mean * mean);
+                    target.min_ = accumulator.min_[channel];
+                    target.max_ = accumulator.max_[channel];
+                    target.mean_ = static_cast<float>(mean);
+                    target.stddev_ = static_cast<float>(std::sqrt(variance));
+                }
+                else{
+                    fromHistogram(target);
+                }
+            }
+        }
+
+        /**
+         * @brief 1 チャンネルのレベル変換（[low, high] → [0, 1]）。
+         * @details 8bit 形式は表を引き、Pixel は同じ一次式を直接計算します（丸めによる段差を避けるため）。
+         */
+        struct LevelMap{
+            bool identity_ = true;
+            float low_{};
+            float scale_ = 1.0f;
+            std::array<std::uint8_t, HISTOGRAM_BINS> table_{};
+
+            LevelMap() = default;
+            LevelMap(const float low, const float high){
+                if(!(high > low)){
+                    for(size_t bin = 0; bin < HISTOGRAM_BINS; ++bin){
+                        table_[bin] = static_cast<std::uint8_t>(bin);
+                    }
+                    return;
+                }
+                identity_ = false;
+                low_ = low;
+                scale_ = 1.0f / (high - low);
+                for(size_t bin = 0; bin < HISTOGRAM_BINS; ++bin){
+                    table_[bin] = unitToByte((byteToUnit(static_cast<std::uint8_t>(bin)) - low_) * scale_);
+                }
+            }
+
+            float apply(const float value) const { return clampUnit((value - low_) * scale_); }
+        };
+
+        using LevelMaps = std::array<LevelMap, 3>;
+
+        inline void remapPixel(RGBA8& pixel, const LevelMaps& maps){
+            pixel.r_ = maps[0].table_[pixel.r_]; pixel.g_ = maps[1].table_[pixel.g_]; pixel.b_ = maps[2].table_[pixel.b_];
+        }
+        inline void remapPixel(BGRA8& pixel, const LevelMaps& maps){
+            pixel.r_ = maps[0].table_[pixel.r_]; pixel.g_ = maps[1].table_[pixel.g_]; pixel.b_ = maps[2].table_[pixel.b_];
+        }
+        inline void remapPixel(BGR8& pixel, const LevelMaps& maps){
+            pixel.r_ = maps[0].table_[pixel.r_]; pixel.g_ = maps[1].table_[pixel.g_]; pixel.b_ = maps[2].table_[pixel.b_];
+        }
+        inline void remapPixel(Gray8& pixel, const LevelMaps& maps){
+            pixel.v_ = maps[0].table_[pixel.v_];
+        }
+        inline void remapPixel(Pixel& pixel, const LevelMaps& maps){
+            if(!maps[0].identity_) pixel.r_ = maps[0].apply(pixel.r_);
+            if(!maps[1].identity_) pixel.g_ = maps[1].apply(pixel.g_);
+            if(!maps[2].identity_) pixel.b_ = maps[2].apply(pixel.b_);
+        }
+
+        template<class P>
+        void remap(const BasicImageView<P>& view, const LevelMaps& maps, common::ThreadPool& pool){
+            if(maps[0].identity_ && maps[1].identity_ && maps[2].identity_){
+                return;
+            }
+            parallelForRows(view, [&maps](PixelSpan<P> row, size_t){
+                for(P& pixel : row){
+                    remapPixel(pixel, maps);
+                }
+            }, pool);
+        }
+
+        bool isValidClip(const float clip){
+            return clip >= 0.0f && clip < 0.5f;
+        }
+    }
+
+    float ChannelStatistics::percentile(const double fraction) const {
+        std::uint64_t count = 0;
+        for(const std::uint64_t frequency : histogram_){
+            count += frequency;
+        }
+        if(count == 0){
+            return 0.0f;
+        }
+        const double clamped = std::clamp(fraction, 0.0, 1.0);
+        const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped * count)));
+        std::uint64_t cumulative = 0;
+        for(size_t bin = 0; bin < HISTOGRAM_BINS; ++bin){
+            cumulative += histogram_[bin];
+            if(cumulative >= rank){
+                return static_cast<float>(bin) / 255.0f;
+            }
+        }
+        return 1.0f;
+    }
+
+    template<class P>
+    std::unique_ptr<ImageStatistics> computeStatistics(const BasicImageView<const P>& source, const size_t sampleStep, common::ThreadPool& pool){
+        if(!source.isValid() || sampleStep == 0){
+            return nullptr;
+        }
+        const size_t width = source.getWidth();
+        const size_t sampledWidth = (width + sampleStep - 1) / sampleStep;
+        const size_t sampledRows = (source.getHeight() + sampleStep - 1) / sampleStep;
+
+        Accumulator total;
+        std::mutex mutex;
+        pool.parallelFor(0, sampledRows, parallelRowGrain(sampledWidth, sampledRows, pool.getConcurrency()), [&](const size_t begin, const size_t end){
+            Accumulator local;
+            for(size_t row = begin; row < end; ++row){
+                accumulateRow(source.rowData(row * sampleStep), width, sampleStep, local);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            total.merge(local);
+        });
+
+        auto statistics = std::make_unique<ImageStatistics>();
+        finish<P>(total, *statistics);
+        return statistics;
+    }
+
+    template<class P>
+    std::unique_ptr<ImageStatistics> computeStatistics(const BasicImage<P>& source, const size_t sampleStep, common::ThreadPool& pool){
+        if(!source.isValid()){
+            return nullptr;
+        }
+        return computeStatistics(makeView(source), sampleStep, pool);
+    }
+
+    template<class P>
+    bool autoLevels(const BasicImageView<P>& view, const float clip, const size_t sampleStep, common::ThreadPool& pool){
+        if(!isValidClip(clip)){
+            return false;
+        }
+        const auto statistics = computeStatistics(BasicImageView<const P>(view), sampleStep, pool);
+        if(!statistics){
+            return false;
+        }
+        LevelMaps maps;
+        for(size_t channel = 0; channel < maps.size(); ++channel){
+            const ChannelStatistics& target = statistics->channels_[channel];
+            maps[channel] = LevelMap(target.percentile(clip), target.percentile(1.0 - clip));
+        }
+        remap(view, maps, pool);
+        return true;
+    }
+
+    template<class P>
+    bool autoContrast(const BasicImageView<P>& view, const float clip, const size_t sampleStep, common::ThreadPool& pool){
+        if(!isValidClip(clip)){
+            return false;
+        }
+        const auto statistics = computeStatistics(BasicImageView<const P>(view), sampleStep, pool);
+        if(!statistics){
+            return false;
+        }
+        ChannelStatistics combined;
+        for(size_t channel = 0; channel < 3; ++channel){
+            for(size_t bin = 0; bin < HISTOGRAM_BINS; ++bin){
+                combined.histogram_[bin] += statistics->channels_[channel].histogram_[bin];
+            }
+        }
+        const LevelMap map(combined.percentile(clip), combined.percentile(1.0 - clip));
+        remap(view, LevelMaps{map, map, map}, pool);
+        return true;
+    }
+
+#define KAF_INSTANTIATE_STATISTICS(P) \
+    template std::unique_ptr<ImageStatistics> computeStatistics<P>(const BasicImageView<const P>&, const size_t, common::ThreadPool&); \
+    template std::unique_ptr<ImageStatistics> computeStatistics<P>(const BasicImage<P>&, const size_t, common::ThreadPool&); \
+    template bool autoLevels<P>(const BasicImageView<P>&, const float, const size_t, common::ThreadPool&); \
+    template bool autoContrast<P>(const BasicImageView<P>&, const float, const size_t, common::ThreadPool&);
+
+    KAF_INSTANTIATE_STATISTICS(Pixel)
+    KAF_INSTANTIATE_STATISTICS(RGBA8)
+    KAF_INSTANTIATE_STATISTICS(BGRA8)
+    KAF_INSTANTIATE_STATISTICS(BGR8)
+    KAF_INSTANTIATE_STATISTICS(Gray8)
+#undef KAF_INSTANTIATE_STATISTICS
+}
@@ -1,39 +1,216 @@
 /**
  * @file event_bus.hpp
- * @brief シンプルなイベントバスの宣言。
+ * @brief スレッドセーフなイベントバスの宣言。
  */
 #ifndef __EVENTBUS_H__
 #define __EVENTBUS_H__
 
-#include <functional>
-#include <unordered_map>
-#include <typeindex>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "../../../domain/common/include/event_sink.hpp"
+#include "event_handler.hpp"
 
 namespace kaf::infra::application{
+    /** @brief 非同期配信のキューが満杯のときの publish の動作。 */
+    enum class BackpressurePolicy{
+        /** 空きができるまで待つ（イベントを失いません） */
+        Block,
+        /** 最も古いイベントを捨てて追加する */
+        DropOldest,
+        /** 追加しようとしたイベントを捨てる */
+        DropNewest,
+    };
+
+    /** @brief 文字列表現を返します。 */
+    const char* toString(const BackpressurePolicy policy);
+
+    /** @brief 非同期配信のキューの容量の上限[件]（スロットは 1 件 128 バイトのため、キュー全体で 128 MiB）。 */
+    inline constexpr size_t MAX_ASYNC_CAPACITY = size_t{1} << 20;
+
+    /**
+     * @struct AsyncDispatchOptions
+     * @brief 非同期配信の設定。
+     */
+    struct AsyncDispatchOptions{
+        /** キューの容量[件]（2 のべき乗に切り上げます。MAX_ASYNC_CAPACITY を超える値は警告を出して MAX_ASYNC_CAPACITY にします） */
+        size_t capacity_ = 4096;
+        /** 配信スレッドがキューから 1 回にまとめて取り出す最大件数 */
+        size_t batchSize_ = 64;
+        /** キューが満杯のときの動作 */
+        BackpressurePolicy backpressure_ = BackpressurePolicy::Block;
+    };
+
     /**
      * @class EventBus
      * @brief 型をキーにした購読と配信を提供します。
+     * @details 購読者は不変のスナップショット（型識別子ごとに連続したハンドラ列）として公開し、
+     *          publish はスナップショットのポインタを 1 回読むだけで、ロックもヒープ確保もしません（RCU 方式）。
+     *          subscribe は新しいスナップショットを作って差し替えます。配信中のスレッドが古いスナップショットを
+     *          読んでいる可能性があるため、古いものはバスの破棄時にまとめて解放します
+     *          （購読は起動時に行い、以降は配信が中心となる使い方を想定しています）。
+     *          publish と subscribe はどのスレッドからでも同時に呼び出せます。
+     *          ハンドラは複数のスレッドから同時に呼び出されることがあります。
+     *
+     *          AsyncDispatchOptions を指定して生成すると非同期配信になり、publish はイベントを
+     *          有界のリングバッファへ複製するだけで戻ります。ハンドラはバス専用の配信スレッドで、
+     *          publish された順にまとめて呼び出されます。遅いハンドラが publish 側を止めることはありません
+     *          （BackpressurePolicy::Block でキューが満杯の場合を除きます）。
+     *          コピーできないイベント型と、配信スレッド上のハンドラから publish されたイベントは、その場で同期配信します。
      */
     class EventBus final : public kaf::domain::common::IEventSink {
-        /** @brief 型ごとのサブスクリプション保持。 */
-        std::unordered_map<std::type_index, std::vector<std::function<void(const void*)>>> subscriptions_;
-        /**
-         * @brief IEventSink の型消去 publish 実装。
-         * @param typeInfo イベントの型情報
-         * @param pointer  イベント実体へのポインタ
-         */
-        void publish_erased(const std::type_info& typeInfo,const void* pointer) noexcept override;
     public:
+        /** @brief 同期配信のバスを生成します（publish の中でハンドラを呼び出します）。 */
+        EventBus();
+        /** @brief 非同期配信のバスを生成し、配信スレッドを起動します。 */
+        explicit EventBus(const AsyncDispatchOptions& options);
+        /** @brief 非同期配信では drain() してから破棄します。 */
+        ~EventBus() override;
+        EventBus(const EventBus& other) = delete;
+        EventBus& operator=(const EventBus& other) = delete;
+
         /**
          * @brief 指定型のイベント購読を登録します。
+         * @details 登録後に開始した publish から配信されます。
          * @tparam E イベント型
-         * @param fn コールバック（const E&）
+         * @param fn コールバック（const E& で呼び出せる関数オブジェクト）
+         */
+        template<class E, class F>
+        void subscribe(F&& fn){
+            using Event = std::remove_cv_t<E>;
+            addHandler(kaf::domain::common::eventTypeId<Event>(), EventType::of<Event>(), EventHandler::create<Event>(std::forward<F>(fn)));
+        }
+
+        /** @brief 非同期配信中か（drain() 後は false）。 */
+        bool isAsync() const { return async_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief この呼び出しまでに publish されたイベントがすべて配信（または破棄）されるまで待ちます。
+         * @details 同期配信のバスと、配信スレッド上のハンドラからの呼び出しでは何もしません。
+         */
+        void flush();
+
+        /**
+         * @brief キューに残ったイベントをすべて配信してから配信スレッドを停止し、以降は同期配信にします。
+         * @details 停止と競合した publish がキューに入れたイベントは、呼び出し元のスレッドで配信してから戻ります。
+         *          非同期配信中に開始した publish がすべて戻るまで待つため、drain 後にキューへ残るイベントはありません
+         *          （BackpressurePolicy::Block で満杯を待つ publish も、この配信で空いたスロットに入れて戻ります）。
          */
-        template<class E>
-        void subscribe(std::function<void(const E&)> fn);
+        void drain();
+
+        /** @brief バックプレッシャーで捨てたイベントの累計件数。 */
+        size_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        /** @brief イベント型の複製・移動・破棄（型ごとに 1 つ、コピーできない型では copy_ と relocate_ が nullptr）。 */
+        struct EventType{
+            size_t size_;
+            size_t alignment_;
+            void (*copy_)(void* destination, const void* source);
+            /** source から destination へ移動し、source を破棄します */
+            void (*relocate_)(void* destination, void* source);
+            void (*destroy_)(void* event);
+
+            template<class E>
+            static const EventType* of(){
+                static constexpr EventType type{
+                    sizeof(E),
+                    alignof(E),
+                    copyOf<E>(),
+                    relocateOf<E>(),
+                    [](void* event){ static_cast<E*>(event)->~E(); },
+                };
+                return &type;
+            }
+
+            template<class E>
+            static constexpr auto copyOf() -> void (*)(void*, const void*){
+                if constexpr(std::is_copy_constructible_v<E>){
+                    return [](void* destination, const void* source){ new (destination) E(*static_cast<const E*>(source)); };
+                }
+                else{
+                    return nullptr;
+                }
+            }
+
+            template<class E>
+            static constexpr auto relocateOf() -> void (*)(void*, void*){
+                if constexpr(std::is_copy_constructible_v<E>){
+                    return [](void* destination, void* source){
+                        E* event = static_cast<E*>(source);
+                        new (destination) E(std::move_if_noexcept(*event));
+                        event->~E();
+                    };
+                }
+                else{
+                    return nullptr;
+                }
+            }
+        };
+
+        /** @brief 購読者の不変スナップショット。 */
+        struct Snapshot{
+            /** 型識別子ごとのハンドラ列の先頭（型識別子 + 1 番目が末尾） */
+            std::vector<size_t> offsets_;
+            /** 型識別子ごとのイベント型 */
+            std::vector<const EventType*> types_;
+            /** 型識別子順に並べたハンドラ */
+            std::vector<EventHandler> handlers_;
+        };
+
+        class AsyncQueue;
+
+        /**
+         * @brief IEventSink の型消去 publish 実装。
+         * @param typeId イベント型の識別子
+         * @param pointer  イベント実体へのポインタ
+         */
+        void publish_erased(const kaf::domain::common::EventTypeId typeId, const void* pointer) noexcept override;
+
+        /** @brief スナップショットのハンドラを呼び出します。 */
+        static void deliver(const Snapshot* snapshot, const kaf::domain::common::EventTypeId typeId, const void* pointer);
+
+        /** @brief ハンドラを追加したスナップショットを公開します。 */
+        void addHandler(const kaf::domain::common::EventTypeId typeId, const EventType* type, EventHandler&& handler);
+
+        /** @brief 配信スレッドの本体。 */
+        void dispatchLoop();
+
+        /** @brief キューに残ったイベントを呼び出し元のスレッドで配信します。 */
+        void dispatchRemaining();
+
+        /** @brief 配信が読むスナップショット。 */
+        std::atomic<const Snapshot*> current_{nullptr};
+        /** @brief 購読の更新を直列化します。 */
+        std::mutex mutex_;
+        /** @brief 型識別子ごとの購読（更新側のみが触れる原本）。 */
+        std::vector<std::vector<EventHandler>> registry_;
+        /** @brief 型識別子ごとのイベント型（更新側のみが触れる原本）。 */
+        std::vector<const EventType*> types_;
+        /** @brief 公開したすべてのスナップショット（最後が current_）。 */
+        std::vector<std::unique_ptr<const Snapshot>> snapshots_;
+
+        /** @brief 非同期配信の設定。 */
+        AsyncDispatchOptions options_{};
+        /** @brief 非同期配信のキュー（同期配信では nullptr）。 */
+        std::unique_ptr<AsyncQueue> queue_;
+        /** @brief 非同期配信中か。 */
+        std::atomic<bool> async_{false};
+        /** @brief 配信スレッド。 */
+        std::thread dispatcher_;
+        /** @brief drain() を直列化します。 */
+        std::mutex drainMutex_;
+        /** @brief 捨てたイベントの件数。 */
+        std::atomic<size_t> dropped_{0};
+        /** @brief キューへ追加しようとしている publish の件数（drain はこれが 0 になるまで配信を続けます）。 */
+        std::atomic<size_t> publishers_{0};
     };
 }
 
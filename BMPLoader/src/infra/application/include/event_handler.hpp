@@ -0,0 +1,129 @@
+/**
+ * @file event_handler.hpp
+ * @brief イベントのコールバックを保持する、小バッファ最適化付きの型消去関数オブジェクト。
+ */
+#ifndef __EVENT_HANDLER_H__
+#define __EVENT_HANDLER_H__
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kaf::infra::application{
+    /**
+     * @class EventHandler
+     * @brief const void* のイベントを受け取るコールバック。
+     * @details INLINE_SIZE バイト以下の関数オブジェクト（参照キャプチャのラムダや std::function など）は
+     *          オブジェクト内に直接保持し、呼び出しは関数ポインタ 1 回の間接呼び出しです。
+     *          それより大きいものだけヒープに確保します。
+     *          複数のスレッドから同時に呼び出されるため、関数オブジェクトは const で呼び出せる必要があります。
+     */
+    class EventHandler{
+    public:
+        /** @brief 内部に保持できる関数オブジェクトの最大サイズ[byte]。 */
+        static constexpr size_t INLINE_SIZE = 4 * sizeof(void*);
+
+        /** @brief 既定コンストラクタ。空のハンドラで初期化します。 */
+        EventHandler() = default;
+
+        /**
+         * @brief イベント型 E を受け取る関数オブジェクトから生成します。
+         * @tparam E イベント型
+         * @param fn const E& で呼び出せる関数オブジェクト
+         */
+        template<class E, class F>
+        static EventHandler create(F&& fn){
+            using Callable = std::decay_t<F>;
+            static_assert(std::is_invocable_v<const Callable&, const E&>, "handler must be callable as fn(const E&) const");
+            EventHandler handler;
+            if constexpr(isInline<Callable>()){
+                new (handler.storage_) Callable(std::forward<F>(fn));
+                handler.invoke_ = [](const void* storage, const void* event){
+                    std::invoke(*static_cast<const Callable*>(storage), *static_cast<const E*>(event));
+                };
+                handler.operations_ = &inlineOperations<Callable>;
+            }
+            else{
+                *reinterpret_cast<Callable**>(handler.storage_) = new Callable(std::forward<F>(fn));
+                handler.invoke_ = [](const void* storage, const void* event){
+                    std::invoke(**static_cast<const Callable* const*>(storage), *static_cast<const E*>(event));
+                };
+                handler.operations_ = &heapOperations<Callable>;
+            }
+            return handler;
+        }
+
+        ~EventHandler(){ reset(); }
+
+        EventHandler(const EventHandler& other){ copyFrom(other); }
+        EventHandler& operator=(const EventHandler& other){
+            if(this != &other){
+                reset();
+                copyFrom(other);
+            }
+            return *this;
+        }
+
+        /** @brief ハンドラを保持しているか。 */
+        explicit operator bool() const { return invoke_ != nullptr; }
+
+        /** @brief イベントを渡して呼び出します（空のハンドラでは何もしません）。 */
+        void operator()(const void* event) const {
+            if(invoke_ != nullptr){
+                invoke_(storage_, event);
+            }
+        }
+
+    private:
+        using Invoke = void (*)(const void* storage, const void* event);
+
+        /** @brief 関数オブジェクトの複製・破棄（型ごとに 1 つ）。 */
+        struct Operations{
+            void (*copy_)(void* destination, const void* source);
+            void (*destroy_)(void* storage);
+        };
+
+        template<class Callable>
+        static constexpr bool isInline(){
+            return sizeof(Callable) <= INLINE_SIZE && alignof(Callable) <= alignof(std::max_align_t);
+        }
+
+        template<class Callable>
+        static constexpr Operations inlineOperations{
+            [](void* destination, const void* source){ new (destination) Callable(*static_cast<const Callable*>(source)); },
+            [](void* storage){ static_cast<Callable*>(storage)->~Callable(); },
+        };
+
+        template<class Callable>
+        static constexpr Operations heapOperations{
+            [](void* destination, const void* source){
+                *static_cast<Callable**>(destination) = new Callable(**static_cast<const Callable* const*>(source));
+            },
+            [](void* storage){ delete *static_cast<Callable**>(storage); },
+        };
+
+        void copyFrom(const EventHandler& other){
+            if(other.operations_ != nullptr){
+                other.operations_->copy_(storage_, other.storage_);
+            }
+            invoke_ = other.invoke_;
+            operations_ = other.operations_;
+        }
+
+        void reset(){
+            if(operations_ != nullptr){
+                operations_->destroy_(storage_);
+            }
+            invoke_ = nullptr;
+            operations_ = nullptr;
+        }
+
+        alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE]{};
+        Invoke invoke_ = nullptr;
+        const Operations* operations_ = nullptr;
+    };
+}
+
+#endif
@@ -1,23 +1,498 @@
 /**
  * @file event_bus.cpp
  * @brief EventBus の実装。
+ * @details 非同期配信のキューは、スロットごとの通し番号で空き・使用中を表す有界リングバッファ
+ *          （Vyukov 方式）です。publish 側はスロットの確保に CAS を 1 回使うだけで、ロックを取りません。
+ *          配信スレッドは準備のできた連続スロットを 1 回の CAS でまとめて取り出します。
+ *          ロックと条件変数は、配信スレッドが眠っている・publish 側が満杯で待っている場合だけ使います。
  */
 #include "../include/event_bus.hpp"
 
+#include <condition_variable>
+#include <cstdint>
+#include <vector>
+
+#include "../../../domain/common/include/log.hpp"
+
 namespace kaf::infra::application{
-    void EventBus::publish_erased(const std::type_info& typeInfo,const void* pointer) noexcept {
-        auto it = subscriptions_.find(std::type_index{typeInfo});
-        if(it == subscriptions_.end()){
+    using kaf::domain::common::EventTypeId;
+
+    namespace {
+        /** @brief 現在のスレッドが配信スレッドとして動いているバス。 */
+        thread_local const EventBus* dispatchingBus = nullptr;
+
+        /** @brief 生存期間中、カウンタを 1 増やします（drain が待つ publish の件数）。 */
+        class CountScope{
+        public:
+            explicit CountScope(std::atomic<size_t>& count) : count_(count){
+                count_.fetch_add(1, std::memory_order_seq_cst);
+            }
+            ~CountScope(){ count_.fetch_sub(1, std::memory_order_release); }
+            CountScope(const CountScope& other) = delete;
+            CountScope& operator=(const CountScope& other) = delete;
+        private:
+            std::atomic<size_t>& count_;
+        };
+
+        /** @brief value 以上の最小の 2 のべき乗を返します（value は MAX_ASYNC_CAPACITY 以下）。 */
+        size_t roundUpToPowerOfTwo(const size_t value){
+            size_t result = 2;
+            while(result < value){
+                result <<= 1;
+            }
+            return result;
+        }
+    }
+
+    /**
+     * @class EventBus::AsyncQueue
+     * @brief 複製したイベントを保持する有界リングバッファと、配信スレッド・待機側の起床の仕組み。
+     */
+    class EventBus::AsyncQueue{
+    public:
+        /** @brief スロット内に直接保持できるイベントの最大サイズ[byte]（超える場合はヒープに確保します）。 */
+        static constexpr size_t INLINE_EVENT_SIZE = 32;
+
+        /**
+         * @class StoredEvent
+         * @brief 複製したイベント 1 件（INLINE_EVENT_SIZE 以下は内部に、超えるものはヒープに保持します）。
+         */
+        class StoredEvent{
+        public:
+            StoredEvent() = default;
+            ~StoredEvent(){ reset(); }
+            StoredEvent(const StoredEvent& other) = delete;
+            StoredEvent& operator=(const StoredEvent& other) = delete;
+
+            /** @brief イベントを保持しているか。 */
+            bool hasEvent() const { return type_ != nullptr; }
+            EventTypeId getTypeId() const { return typeId_; }
+            const void* getEvent() const { return event_; }
+
+            /**
+             * @brief イベントを複製して保持します。
+             * @retval true 成功
+             * @retval false 確保または複製に失敗（空のまま）
+             */
+            bool store(const EventTypeId typeId, const EventType* type, const void* event) noexcept {
+                void* storage = storage_;
+                try{
+                    if(!isInline(type)){
+                        storage = ::operator new(type->size_, std::align_val_t(type->alignment_));
+                    }
+                    type->copy_(storage, event);
+                }
+                catch(...){
+                    if(storage != storage_){
+                        ::operator delete(storage, std::align_val_t(type->alignment_));
+                    }
+                    return false;
+                }
+                typeId_ = typeId;
+                type_ = type;
+                event_ = storage;
+                return true;
+            }
+
+            /** @brief other のイベントを移し、other を空にします（ヒープのイベントはポインタだけを移します）。 */
+            void moveFrom(StoredEvent& other) noexcept {
+                reset();
+                if(!other.hasEvent()){
+                    return;
+                }
+                typeId_ = other.typeId_;
+                type_ = other.type_;
+                if(other.event_ == other.storage_){
+                    type_->relocate_(storage_, other.storage_);
+                    event_ = storage_;
+                }
+                else{
+                    event_ = other.event_;
+                }
+                other.type_ = nullptr;
+                other.event_ = nullptr;
+            }
+
+            /** @brief イベントを破棄して空にします。 */
+            void reset() noexcept {
+                if(type_ == nullptr){
+                    return;
+                }
+                type_->destroy_(event_);
+                if(event_ != storage_){
+                    ::operator delete(event_, std::align_val_t(type_->alignment_));
+                }
+                type_ = nullptr;
+                event_ = nullptr;
+            }
+
+        private:
+            static bool isInline(const EventType* type){
+                return type->size_ <= INLINE_EVENT_SIZE && type->alignment_ <= alignof(std::max_align_t);
+            }
+
+            const EventType* type_ = nullptr;
+            void* event_ = nullptr;
+            EventTypeId typeId_{};
+            alignas(std::max_align_t) unsigned char storage_[INLINE_EVENT_SIZE];
+        };
+
+        explicit AsyncQueue(const size_t capacity)
+            : slots_(std::make_unique<Slot[]>(roundUpToPowerOfTwo(capacity))), mask_(roundUpToPowerOfTwo(capacity) - 1){
+            for(size_t idx = 0; idx <= mask_; ++idx){
+                slots_[idx].sequence_.store(idx, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief イベントを複製して追加します。
+         * @retval true 追加した（複製に失敗したイベントは空のスロットとして捨てます）
+         * @retval false 満杯
+         */
+        bool tryPush(const EventTypeId typeId, const EventType* type, const void* event){
+            size_t position = enqueue_.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            for(;;){
+                slot = &slots_[position & mask_];
+                const size_t sequence = slot->sequence_.load(std::memory_order_acquire);
+                const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - position);
+                if(difference == 0){
+                    if(enqueue_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                        break;
+                    }
+                }
+                else if(difference < 0){
+                    return false;
+                }
+                else{
+                    position = enqueue_.load(std::memory_order_relaxed);
+                }
+            }
+            slot->event_.store(typeId, type, event);
+            slot->sequence_.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief 先頭から最大 maxCount 件を batch へ移して取り出します。
+         * @details スロットはハンドラの呼び出し前に空けるため、配信中のイベントはキューの容量を占めません。
+         * @return 取り出した件数（0 は空、または先頭のイベントを書き込み中）
+         */
+        size_t popBatch(const size_t maxCount, StoredEvent* batch){
+            size_t position = dequeue_.load(std::memory_order_relaxed);
+            size_t count = 0;
+            for(;;){
+                count = 0;
+                while(count < maxCount &&
+                    slots_[(position + count) & mask_].sequence_.load(std::memory_order_acquire) == position + count + 1){
+                    ++count;
+                }
+                if(count == 0){
+                    const size_t sequence = slots_[position & mask_].sequence_.load(std::memory_order_acquire);
+                    if(static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0){
+                        return 0;
+                    }
+                    position = dequeue_.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if(dequeue_.compare_exchange_weak(position, position + count, std::memory_order_relaxed)){
+                    break;
+                }
+            }
+            for(size_t idx = 0; idx < count; ++idx){
+                Slot& slot = slots_[(position + idx) & mask_];
+                batch[idx].moveFrom(slot.event_);
+                slot.sequence_.store(position + idx + mask_ + 1, std::memory_order_release);
+            }
+            return count;
+        }
+
+        /**
+         * @brief 最大 batch.size() 件を取り出し、deliver(typeId, event) で配信します（配信側）。
+         * @details スロットを空けた時点で満杯で待つ publish を起こし、配信後に flush の待ちを起こします。
+         * @return 取り出した件数
+         */
+        template<class Deliver>
+        size_t dispatchBatch(std::vector<StoredEvent>& batch, const Deliver& deliver){
+            const size_t count = popBatch(batch.size(), batch.data());
+            if(count > 0){
+                notifySpace();
+                for(size_t idx = 0; idx < count; ++idx){
+                    if(batch[idx].hasEvent()){
+                        deliver(batch[idx].getTypeId(), batch[idx].getEvent());
+                        batch[idx].reset();
+                    }
+                }
+            }
+            complete();
+            return count;
+        }
+
+        /** @brief 最も古いイベントを 1 件捨てます（BackpressurePolicy::DropOldest）。 */
+        bool dropOldest(){
+            StoredEvent dropped;
+            return popBatch(1, &dropped) > 0;
+        }
+
+        /** @brief 取り出せるイベントが無いか。 */
+        bool isEmpty() const {
+            const size_t position = dequeue_.load(std::memory_order_acquire);
+            return slots_[position & mask_].sequence_.load(std::memory_order_acquire) != position + 1;
+        }
+
+        /** @brief これまでに確保されたスロットの通し番号（publish 済みの件数）。 */
+        size_t getEnqueuePosition() const { return enqueue_.load(std::memory_order_acquire); }
+        /** @brief これまでに取り出されたスロットの通し番号。 */
+        size_t getDequeuePosition() const { return dequeue_.load(std::memory_order_acquire); }
+
+        /** @brief 追加後、配信スレッドが眠っていれば起こします。 */
+        void notifyConsumer(){
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(consumerSleeping_.load(std::memory_order_relaxed)){
+                std::lock_guard<std::mutex> lock(mutex_);
+                consumerWake_.notify_one();
+            }
+        }
+
+        /** @brief 取り出しでスロットが空いたことを、満杯で待っているスレッドに知らせます（配信側）。 */
+        void notifySpace(){
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(waiters_.load(std::memory_order_relaxed) > 0){
+                std::lock_guard<std::mutex> lock(mutex_);
+                producerWake_.notify_all();
+            }
+        }
+
+        /** @brief 配信済みの位置を更新し、flush で待っているスレッドを起こします（配信側、ハンドラの呼び出し後）。 */
+        void complete(){
+            completed_.store(getDequeuePosition(), std::memory_order_release);
+            notifySpace();
+        }
+
+        /**
+         * @brief イベントが来るまで配信スレッドを眠らせます。
+         * @retval true 取り出せるイベントがある
+         * @retval false 停止要求があり、キューが空
+         */
+        bool waitForEvents(){
+            consumerSleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(isEmpty()){
+                std::unique_lock<std::mutex> lock(mutex_);
+                consumerWake_.wait(lock, [this]{ return stopping_ || !isEmpty(); });
+            }
+            consumerSleeping_.store(false, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(mutex_);
+            return !stopping_ || !isEmpty();
+        }
+
+        /** @brief 空きができるまで待ってから追加します（BackpressurePolicy::Block）。 */
+        void pushBlocking(const EventTypeId typeId, const EventType* type, const void* event){
+            Waiter waiter(*this);
+            if(!tryPush(typeId, type, event)){
+                std::unique_lock<std::mutex> lock(mutex_);
+                producerWake_.wait(lock, [&]{ return tryPush(typeId, type, event); });
+            }
+        }
+
+        /** @brief position 番目までのイベントが配信されるまで待ちます。 */
+        void waitCompleted(const size_t position){
+            Waiter waiter(*this);
+            std::unique_lock<std::mutex> lock(mutex_);
+            producerWake_.wait(lock, [&]{ return completed_.load(std::memory_order_acquire) >= position; });
+        }
+
+        /** @brief 配信スレッドに停止を要求します。 */
+        void stop(){
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            consumerWake_.notify_one();
+        }
+
+    private:
+        struct alignas(64) Slot{
+            std::atomic<size_t> sequence_{};
+            StoredEvent event_;
+        };
+
+        /** @brief 待機中の件数を数える（起こす側は 0 件なら条件変数に触れません）。 */
+        class Waiter{
+        public:
+            explicit Waiter(AsyncQueue& queue) : queue_(queue){
+                queue_.waiters_.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+            ~Waiter(){ queue_.waiters_.fetch_sub(1, std::memory_order_relaxed); }
+            Waiter(const Waiter& other) = delete;
+            Waiter& operator=(const Waiter& other) = delete;
+        private:
+            AsyncQueue& queue_;
+        };
+
+        std::unique_ptr<Slot[]> slots_;
+        size_t mask_;
+        alignas(64) std::atomic<size_t> enqueue_{0};
+        alignas(64) std::atomic<size_t> dequeue_{0};
+        alignas(64) std::atomic<size_t> completed_{0};
+        std::atomic<bool> consumerSleeping_{false};
+        std::atomic<size_t> waiters_{0};
+        std::mutex mutex_;
+        std::condition_variable consumerWake_;
+        std::condition_variable producerWake_;
+        bool stopping_ = false;
+    };
+
+    const char* toString(const BackpressurePolicy policy){
+        switch(policy){
+            case BackpressurePolicy::Block: return "block";
+            case BackpressurePolicy::DropOldest: return "drop-oldest";
+            case BackpressurePolicy::DropNewest: return "drop-newest";
+        }
+        return "unknown";
+    }
+
+    EventBus::EventBus() = default;
+
+    EventBus::EventBus(const AsyncDispatchOptions& options)
+        : options_(options){
+        if(options_.capacity_ > MAX_ASYNC_CAPACITY){
+            KAF_LOG_WARNING("Event queue capacity %zu exceeds the maximum; clamped to %zu", options_.capacity_, MAX_ASYNC_CAPACITY);
+            options_.capacity_ = MAX_ASYNC_CAPACITY;
+        }
+        if(options_.batchSize_ == 0){
+            options_.batchSize_ = 1;
+        }
+        queue_ = std::make_unique<AsyncQueue>(options_.capacity_);
+        async_.store(true, std::memory_order_release);
+        dispatcher_ = std::thread(&EventBus::dispatchLoop, this);
+    }
+
+    EventBus::~EventBus(){
+        if(queue_){
+            drain();
+        }
+    }
+
+    void EventBus::deliver(const Snapshot* snapshot, const EventTypeId typeId, const void* pointer){
+        if(snapshot == nullptr || typeId + 1 >= snapshot->offsets_.size()){
             return;
         }
-        for(auto&  func: it->second){
-            func(pointer);
+        const EventHandler* handler = snapshot->handlers_.data() + snapshot->offsets_[typeId];
+        const EventHandler* last = snapshot->handlers_.data() + snapshot->offsets_[typeId + 1];
+        for(; handler != last; ++handler){
+            (*handler)(pointer);
         }
     }
-    template<class E>
-    void EventBus::subscribe(std::function<void(const E&)> func) {
-        subscriptions_[std::type_index{typeid(E)}].push_back(
-            [func=std::move(func)](const void* pointer){ func(*static_cast<const E*>(pointer)); }
-        );
+
+    void EventBus::publish_erased(const EventTypeId typeId, const void* pointer) noexcept {
+        const Snapshot* snapshot = current_.load(std::memory_order_acquire);
+        if(snapshot == nullptr || typeId + 1 >= snapshot->offsets_.size() ||
+            snapshot->offsets_[typeId] == snapshot->offsets_[typeId + 1]){
+            return;
+        }
+        const EventType* type = snapshot->types_[typeId];
+        if(!async_.load(std::memory_order_acquire) || type->copy_ == nullptr || dispatchingBus == this){
+            deliver(snapshot, typeId, pointer);
+            return;
+        }
+        // drain がキューを空にした後で追加しないよう、publish 中として数えてから非同期配信中かを確かめ直す
+        // （drain は async_ を下ろした後、数えた publish がすべて戻るまでキューの配信を続ける）
+        const CountScope scope(publishers_);
+        if(!async_.load(std::memory_order_seq_cst)){
+            deliver(snapshot, typeId, pointer);
+            return;
+        }
+
+        AsyncQueue& queue = *queue_;
+        if(!queue.tryPush(typeId, type, pointer)){
+            switch(options_.backpressure_){
+                case BackpressurePolicy::DropNewest:
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                case BackpressurePolicy::DropOldest:
+                    do{
+                        if(queue.dropOldest()){
+                            dropped_.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }while(!queue.tryPush(typeId, type, pointer));
+                    break;
+                default:
+                    queue.pushBlocking(typeId, type, pointer);
+                    break;
+            }
+        }
+        queue.notifyConsumer();
+    }
+
+    void EventBus::dispatchLoop(){
+        dispatchingBus = this;
+        AsyncQueue& queue = *queue_;
+        std::vector<AsyncQueue::StoredEvent> batch(options_.batchSize_);
+        const auto dispatch = [this](const EventTypeId typeId, const void* pointer){
+            deliver(current_.load(std::memory_order_acquire), typeId, pointer);
+        };
+        while(queue.dispatchBatch(batch, dispatch) > 0 || queue.waitForEvents()){
+        }
+        dispatchingBus = nullptr;
+    }
+
+    void EventBus::dispatchRemaining(){
+        // 停止と競合した publish が戻るまで配信を続けます（Block で満杯を待つ publish にも空きを作る）
+        AsyncQueue& queue = *queue_;
+        std::vector<AsyncQueue::StoredEvent> batch(options_.batchSize_);
+        const auto dispatch = [this](const EventTypeId typeId, const void* pointer){
+            deliver(current_.load(std::memory_order_acquire), typeId, pointer);
+        };
+        while(publishers_.load(std::memory_order_seq_cst) > 0 ||
+            queue.getDequeuePosition() != queue.getEnqueuePosition()){
+            if(queue.dispatchBatch(batch, dispatch) == 0){
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void EventBus::flush(){
+        if(!isAsync() || dispatchingBus == this){
+            return;
+        }
+        queue_->waitCompleted(queue_->getEnqueuePosition());
+    }
+
+    void EventBus::drain(){
+        std::lock_guard<std::mutex> lock(drainMutex_);
+        if(async_.exchange(false, std::memory_order_seq_cst)){
+            queue_->stop();
+            dispatcher_.join();
+        }
+        dispatchRemaining();
+    }
+
+    void EventBus::addHandler(const EventTypeId typeId, const EventType* type, EventHandler&& handler){
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(registry_.size() <= typeId){
+            registry_.resize(static_cast<size_t>(typeId) + 1);
+            types_.resize(static_cast<size_t>(typeId) + 1, nullptr);
+        }
+        registry_[typeId].push_back(std::move(handler));
+        types_[typeId] = type;
+
+        auto snapshot = std::make_unique<Snapshot>();
+        snapshot->offsets_.reserve(registry_.size() + 1);
+        size_t count = 0;
+        for(const auto& handlers : registry_){
+            snapshot->offsets_.push_back(count);
+            count += handlers.size();
+        }
+        snapshot->offsets_.push_back(count);
+        snapshot->types_ = types_;
+        snapshot->handlers_.reserve(count);
+        for(const auto& handlers : registry_){
+            snapshot->handlers_.insert(snapshot->handlers_.end(), handlers.begin(), handlers.end());
+        }
+
+        current_.store(snapshot.get(), std::memory_order_release);
+        snapshots_.push_back(std::move(snapshot));
     }
 }
@@ -7,46 +7,106 @@
 #define __BMP_H__
 
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <fstream>
+#include <vector>
 
+#include "bmp_header.hpp"
+#include "codec_events.hpp"
+#include "../../../domain/common/include/cancellation.hpp"
+#include "../../../domain/common/include/event_sink.hpp"
 #include "../../../domain/graphics2d/include/image.hpp"
+#include "../../../domain/graphics2d/include/image_view.hpp"
 #include "../../../domain/graphics2d/include/pixel.hpp"
+#include "../../../domain/graphics2d/include/pixel_format.hpp"
+#include "../../../domain/graphics2d/include/pixel_buffer_pool.hpp"
 namespace kaf::infra::codecs{
 
     /**
-     * @class BMP
+     * @struct CodecOptions
+     * @brief BMP 読み書きの動作設定。
+     */
+    struct CodecOptions{
+        /**
+         * デコード/エンコードに使うスレッド数。
+         * 1 で従来どおりの逐次処理、0 でハードウェアスレッド数、2 以上で行帯ごとに並列処理します。
+         * 行帯は ThreadPool::shared() のワーカーで処理するため、同時に動くスレッドはプールの並列度までです。
+         * 並列時も結果は逐次処理とビット単位で一致します。
+         */
+        size_t threadCount_ = 1;
+        /**
+         * 読み込み時のピクセル配列の確保元（nullptr でヒープから直接確保）。
+         * 同サイズの画像を続けて読み込む場合、前の画像の配列を再利用します。プールは画像より長く生存させる必要はありません。
+         */
+        domain::graphics2d::PixelBufferPool* bufferPool_ = nullptr;
+        /**
+         * 進捗（CodecProgress）と中断（CodecAborted）の送り先（nullptr で送りません）。
+         * 並列時はワーカースレッドからも送るため、複数スレッドから publish できる必要があります。
+         */
+        domain::common::IEventSink* eventSink_ = nullptr;
+        /** CodecProgress を送る最小間隔 */
+        std::chrono::milliseconds progressInterval_{50};
+        /** 行帯ごとに確認する中断要求（nullptr で確認しません） */
+        const domain::common::CancellationToken* cancellation_ = nullptr;
+        /** 行帯ごとに確認する期限（既定は期限なし） */
+        std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+    };
+
+    /**
+     * @class BasicBMP
      * @brief BMP 画像のロード/セーブを提供するクラス。
-     * @details domain::graphics2d::Image を継承し、
+     * @details domain::graphics2d::BasicImage を継承し、
      *          非圧縮(BI_RGB)の 24/32bpp を対象に読み書きを行います。
+     *          BGR8/BGRA8 はファイルと同じバイト配置のため、行単位のコピーで読み書きします。
+     * @tparam P ピクセル形式（Pixel, RGBA8, BGRA8, BGR8, Gray8）
      */
-    class BMP : public ::kaf::domain::graphics2d::Image {
+    template<class P>
+    class BasicBMP : public ::kaf::domain::graphics2d::BasicImage<P> {
+        using Base = ::kaf::domain::graphics2d::BasicImage<P>;
     public:
+        using typename Base::PixelType;
+        using typename Base::BufferType;
+        using Base::isValid;
+        using Base::getWidth;
+        using Base::getHeight;
+        using Base::setWidth;
+        using Base::setHeight;
+        using Base::getPixelBuffer;
+        using Base::passPixelBuffer;
+        using Base::setPixelBuffer;
+        using Base::getPixel;
+        using Base::setPixel;
+        using Base::row;
+        /** @brief 読み取り専用のビューの型。 */
+        using ConstViewType = ::kaf::domain::graphics2d::BasicImageView<const P>;
+
         /** @brief BMP ファイルヘッダ（BITMAPFILEHEADER）のサイズ[バイト]。 */
         const size_t FILEHEADER_SIZE = 14;
         /** @brief DIB ヘッダ（BITMAPINFOHEADER）のサイズ[バイト]。 */
         const size_t INFOHEADER_SIZE = 40;
 
-        const unsigned int BI_RGB = 0;
+        /** @brief 非圧縮を表す圧縮形式。 */
+        static constexpr unsigned int BI_RGB = 0;
 
         /**
          * @brief 既定コンストラクタ。空の画像で初期化します。
          */
-        BMP();
+        BasicBMP();
 
         /**
          * @brief 指定サイズで新規画像を初期化します。
          * @param width 画像の幅[px]
          * @param height 画像の高さ[px]
          */
-        BMP(const size_t width, const size_t height, const kaf::domain::graphics2d::Pixel& pixel = kaf::domain::graphics2d::Pixel(1.0f,1.0f,1.0f));
+        BasicBMP(const size_t width, const size_t height, const P& pixel = ::kaf::domain::graphics2d::PixelFormat<P>::white());
 
-        ~BMP();
-        BMP(const BMP& other);
-        BMP& operator=(const BMP& other);
-        BMP(BMP&& other);
-        BMP& operator=(BMP&& other);
+        ~BasicBMP();
+        BasicBMP(const BasicBMP& other);
+        BasicBMP& operator=(const BasicBMP& other);
+        BasicBMP(BasicBMP&& other);
+        BasicBMP& operator=(BasicBMP&& other);
 
         /**
          * @brief 既存の画素バッファを用いて画像を設定します。
@@ -56,7 +116,7 @@ namespace kaf::infra::codecs{
          * @retval true 設定成功
          * @retval false 失敗（サイズ不一致 等）
          */
-        bool setImage(const domain::graphics2d::PixelBuffer& pixels, size_t width, size_t height);
+        bool setImage(const BufferType& pixels, size_t width, size_t height);
 
         /**
          * @brief BMP ファイルを読み込み、画像を構築します。
@@ -66,6 +126,16 @@ namespace kaf::infra::codecs{
          */
         bool loadImage(const std::string& inputFilePath);
 
+        /**
+         * @brief 動作設定を指定して BMP ファイルを読み込みます。
+         * @details 並列時はファイルをメモリマップし、行帯ごとに各スレッドでデコードします。
+         * @param inputFilePath 入力ファイルパス
+         * @param options 動作設定
+         * @retval true 読み込み成功
+         * @retval false 失敗（ファイル不在、不正ヘッダ、未対応形式 等）
+         */
+        bool loadImage(const std::string& inputFilePath, const CodecOptions& options);
+
         /**
          * @brief 画像を BMP として保存します。
          * @param outputFilePath 出力ファイルパス
@@ -74,40 +144,129 @@ namespace kaf::infra::codecs{
          */
         bool saveImage(const std::string& outputFilePath, const size_t bitPerPixel = 32)const;
 
+        /**
+         * @brief 動作設定を指定して画像を BMP として保存します。
+         * @details 並列時は書き出し単位ごとに行帯を各スレッドでエンコードし、順に書き込みます。
+         * @param outputFilePath 出力ファイルパス
+         * @param bitPerPixel ビット深度（24 or 32）
+         * @param options 動作設定
+         * @retval true 保存成功
+         * @retval false 失敗（画像未生成、書き込み失敗 等）
+         */
+        bool saveImage(const std::string& outputFilePath, const size_t bitPerPixel, const CodecOptions& options)const;
+
+
+        /**
+         * @brief ビューの領域を BMP として保存します（切り抜き・タイルをコピーせずに書き出せます）。
+         * @param outputFilePath 出力ファイルパス
+         * @param view 保存する領域
+         * @param bitPerPixel ビット深度（24 or 32）
+         * @param options 動作設定
+         * @retval true 保存成功
+         * @retval false 失敗（無効なビュー、書き込み失敗 等）
+         */
+        static bool saveView(const std::string& outputFilePath, const ConstViewType& view, const size_t bitPerPixel = 32, const CodecOptions& options = CodecOptions{});
+
+        /**
+         * @brief ヘッダ（先頭 54 バイト）のみを読み取り、画像メタデータを取得します。
+         * @details ピクセル配列は読み込みません。未対応形式（圧縮、ビット深度、トップダウン）でも
+         *          メタデータを返すため、読み込み可否は isSupportedBitmap で判定してください。
+         * @param inputFilePath 入力ファイルパス
+         * @param info 読み取ったメタデータ(出力)
+         * @retval true 取得成功
+         * @retval false 失敗（ファイル不在、BMP 以外、ヘッダ破損 等）
+         */
+        static bool probe(const std::string& inputFilePath, BitmapInfo& info);
 
     private:
         /**
          * @brief BITMAPFILEHEADER（先頭14バイト）を読み取り検証します。
          * @param infStream 入力ストリーム（バイナリ）
+         * @param info 読み取ったメタデータ(出力、ピクセル配列オフセット)
          * @retval true 検証成功（'BM' シグネチャ等）
          * @retval false 検証失敗
          */
-        bool readBitmapFileHeader(std::ifstream& infStream)const;
+        bool readBitmapFileHeader(std::ifstream& infStream, BitmapInfo& info)const;
 
         /**
-         * @brief BITMAPINFOHEADER（40バイト）を読み取り検証します。
+         * @brief BITMAPINFOHEADER（40バイト）を読み取り検証し、幅・高さを設定します。
          * @param infStream 入力ストリーム（バイナリ）
-         * @param bitsPerPixel 読み取ったビット深度(出力)
+         * @param info 読み取ったメタデータ(出力、ビット深度 等)
          * @retval true 検証成功（bpp、圧縮形式、幅高さ 等）
          * @retval false 検証失敗
          */
-        bool readBitmapInfoHeader(std::ifstream& infStream, std::uint16_t& bitsPerPixel);
+        bool readBitmapInfoHeader(std::ifstream& infStream, BitmapInfo& info);
 
         /**
-         * @brief ピクセル配列（カラーバッファ）を 1 行分読み込みます。
+         * @brief ピクセル配列（カラーバッファ）を複数行まとめて読み込みます。
+         * @details パディング込みの lineCount 行を 1 回の read でステージングバッファへ読み込み、
+         *          行単位でデコードしてピクセルバッファへ書き込みます。
          * @param infStream 入力ストリーム（バイナリ）
          * @param bytePerPixel 1 ピクセル当たりのバイト数（3 or 4）
-         * @param lineNumber 読み込み対象の行インデックス
+         * @param lineNumber 読み込み開始行のインデックス（ファイル上の順序、0 が最下行）
+         * @param lineCount 読み込む行数
+         * @param staging ステージングバッファ（必要に応じて拡張され、呼び出し間で再利用されます）
          * @retval true 読み込み成功
          * @retval false 失敗（サイズ不一致、読み取りエラー 等）
          */
-        bool readBitmapCollorBuffer(std::ifstream& infStream, const size_t& bytePerPixel, size_t lineNumber);
+        bool readBitmapCollorBuffer(std::ifstream& infStream, const size_t& bytePerPixel, size_t lineNumber, size_t lineCount, std::vector<unsigned char>& staging);
 
-        bool writeBitmapFileHeader(std::ofstream& outfStream, const size_t& bytePerPixel)const;
-        bool writeBitmapInfoHeader(std::ofstream& outfStream, const size_t& bytePerPixel)const;
-        bool writeBitmapCollorBuffer(std::ofstream& outfStream, const size_t& bytePerPixel, size_t lineNumber)const;
+        /**
+         * @brief メモリマップしたファイルから画像を読み込みます（並列デコード）。
+         * @param inputFilePath 入力ファイルパス
+         * @param threadCount スレッド数（2 以上）
+         * @param options 動作設定（ピクセル配列の確保元、進捗の送り先、中断要求、期限）
+         * @retval true 読み込み成功
+         * @retval false 失敗（中断を含む）
+         */
+        bool loadMappedImage(const std::string& inputFilePath, const size_t threadCount, const CodecOptions& options);
+
+        /**
+         * @brief メモリ上のピクセル配列（パディング込み）から複数行をデコードします。
+         * @param source lineNumber 行目の先頭（ファイル上の順序）
+         * @param bytePerPixel 1 ピクセル当たりのバイト数（3 or 4）
+         * @param lineNumber デコード開始行のインデックス（ファイル上の順序、0 が最下行）
+         * @param lineCount デコードする行数
+         * @retval true 成功
+         * @retval false 失敗（範囲外 等）
+         */
+        bool decodeBitmapCollorBuffer(const unsigned char* source, const size_t& bytePerPixel, size_t lineNumber, size_t lineCount);
+
+        /**
+         * @brief 複数行をパディング込みのピクセル配列へエンコードします。
+         * @param view 出力する領域
+         * @param destination lineNumber 行目の書き込み先（パディング部分は変更しません）
+         * @param bytePerPixel 1 ピクセル当たりのバイト数（3 or 4）
+         * @param lineNumber エンコード開始行のインデックス（ファイル上の順序、0 が最下行）
+         * @param lineCount エンコードする行数
+         * @retval true 成功
+         * @retval false 失敗（範囲外 等）
+         */
+        static bool encodeBitmapCollorBuffer(const ConstViewType& view, unsigned char* destination, const size_t& bytePerPixel, size_t lineNumber, size_t lineCount);
+
+        static bool writeBitmapFileHeader(std::ofstream& outfStream, const BitmapInfo& info);
+        static bool writeBitmapInfoHeader(std::ofstream& outfStream, const BitmapInfo& info);
+
+        /**
+         * @brief ピクセル配列（カラーバッファ）を複数行まとめて書き込みます。
+         * @details lineCount 行をパディング込みでステージングバッファへエンコードし、1 回の write で書き出します。
+         *          threadCount が 2 以上の場合、エンコードは行帯ごとに並列に行います。
+         * @param outfStream 出力ストリーム（バイナリ）
+         * @param view 出力する領域
+         * @param bytePerPixel 1 ピクセル当たりのバイト数（3 or 4）
+         * @param lineNumber 書き込み開始行のインデックス（ファイル上の順序、0 が最下行）
+         * @param lineCount 書き込む行数
+         * @param staging ステージングバッファ（必要に応じて拡張され、呼び出し間で再利用されます）
+         * @param threadCount エンコードに使うスレッド数
+         * @retval true 書き込み成功
+         * @retval false 失敗（範囲外、書き込みエラー 等）
+         */
+        static bool writeBitmapCollorBuffer(std::ofstream& outfStream, const ConstViewType& view, const size_t& bytePerPixel, size_t lineNumber, size_t lineCount, std::vector<unsigned char>& staging, const size_t threadCount);
 
     };
 
+    /** @brief 従来の浮動小数点 RGBA 形式の BMP。 */
+    using BMP = BasicBMP<::kaf::domain::graphics2d::Pixel>;
+
 }
 #endif
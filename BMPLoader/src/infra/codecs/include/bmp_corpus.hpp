@@ -0,0 +1,84 @@
+/**
+ * @file bmp_corpus.hpp
+ * @brief ベンチマーク用の合成 BMP コーパスを決定的に生成するユーティリティ。
+ */
+#ifndef __BMP_CORPUS_H__
+#define __BMP_CORPUS_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kaf::infra::codecs{
+    /** @brief 既定のコーパスに含めるファイルサイズの上限（256 MiB）。 */
+    inline constexpr std::uintmax_t DEFAULT_CORPUS_MAX_FILE_BYTES = 256u * 1024u * 1024u;
+
+    /**
+     * @struct CorpusImageSpec
+     * @brief コーパスの 1 画像分の仕様。
+     */
+    struct CorpusImageSpec{
+        /** 分類（padding, aspect, size）。ファイル名の先頭に使います */
+        std::string category_;
+        /** 幅[px] */
+        size_t width_{};
+        /** 高さ[px] */
+        size_t height_{};
+        /** ビット深度（24 または 32） */
+        std::uint16_t bitsPerPixel_{};
+        /** ピクセル値を決める乱数の種 */
+        std::uint64_t seed_{};
+    };
+
+    /**
+     * @struct CorpusEntry
+     * @brief 生成したコーパスの 1 ファイル分の情報。
+     */
+    struct CorpusEntry{
+        CorpusImageSpec spec_;
+        /** ファイルパス（'/' 区切り） */
+        std::string path_;
+        /** ファイルサイズ[バイト] */
+        std::uintmax_t fileSize_{};
+        /** 今回書き出したか（false は既存のファイルを再利用） */
+        bool generated_{};
+    };
+
+    /**
+     * @brief 仕様から書き出される BMP のファイルサイズを返します（ヘッダ込み）。
+     */
+    std::uintmax_t corpusFileSize(const CorpusImageSpec& spec);
+
+    /**
+     * @brief 仕様から決まるファイル名（例: padding_3x33_24bpp.bmp）を返します。
+     */
+    std::string corpusFileName(const CorpusImageSpec& spec);
+
+    /**
+     * @brief 既定のコーパス仕様を返します。
+     * @details 24/32bpp それぞれについて、行パディングの全パターン（幅 mod 4 の 4 通り）、
+     *          極端な縦横比、サムネイルから数 GB までのサイズを含みます。
+     *          種は仕様の寸法から決まるため、仕様を追加しても既存の画像の内容は変わりません。
+     * @param maxFileBytes これを超えるファイルサイズの仕様を除外します
+     * @return 仕様の一覧（ファイルサイズの昇順）
+     */
+    std::vector<CorpusImageSpec> defaultCorpusSpecs(const std::uintmax_t maxFileBytes = DEFAULT_CORPUS_MAX_FILE_BYTES);
+
+    /**
+     * @brief 仕様どおりの BMP を BMP::saveImage でディレクトリへ書き出します。
+     * @details ピクセル値は種と座標だけから決まるため、同じ仕様からは常に同じバイト列が得られます。
+     *          期待するサイズのファイルが既にある場合は書き出さずに再利用します。
+     *          書き出し中は 1 画像分（ファイルサイズ程度）のメモリを使います。
+     * @param directoryPath 出力ディレクトリ（無ければ作成します）
+     * @param specs 生成する仕様
+     * @param entries 生成したファイルの情報（仕様の順）
+     * @param threadCount ピクセル値の生成と書き出しのスレッド数（0: ハードウェアスレッド数）
+     * @retval true 全ファイルの生成に成功
+     * @retval false 失敗（ディレクトリを作成できない、書き出しに失敗したなど）
+     */
+    bool generateCorpus(const std::string& directoryPath, const std::vector<CorpusImageSpec>& specs,
+        std::vector<CorpusEntry>& entries, const size_t threadCount = 0);
+}
+
+#endif
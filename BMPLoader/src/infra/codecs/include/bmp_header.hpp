@@ -0,0 +1,102 @@
+/**
+ * @file bmp_header.hpp
+ * @brief BMP ヘッダ（BITMAPFILEHEADER / BITMAPINFOHEADER）の解析。
+ * @details ストリーム読み込み・メモリマップの双方で同じ検証を行うため、
+ *          メモリ上のバイト列を対象に解析します。
+ */
+#ifndef __BMP_HEADER_H__
+#define __BMP_HEADER_H__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kaf::infra::codecs{
+    /** @brief BMP ファイルヘッダ（BITMAPFILEHEADER）のサイズ[バイト]。 */
+    constexpr size_t BITMAP_FILEHEADER_SIZE = 14;
+    /** @brief DIB ヘッダ（BITMAPINFOHEADER）のサイズ[バイト]。 */
+    constexpr size_t BITMAP_INFOHEADER_SIZE = 40;
+
+    /**
+     * @brief 4 バイト境界にパディングした 1 行のバイト数を返します。
+     * @param bytePerPixel 1 ピクセル当たりのバイト数
+     * @param width 幅[px]
+     */
+    inline size_t bitmapLineStride(const size_t bytePerPixel, const size_t width){
+        return (bytePerPixel * width + 3) / 4 * 4;
+    }
+
+    /**
+     * @struct BitmapInfo
+     * @brief ヘッダから読み取った画像メタデータ。
+     */
+    struct BitmapInfo{
+        /** 幅[px] */
+        size_t width_{};
+        /** 高さ[px] */
+        size_t height_{};
+        /** ビット深度（24 or 32） */
+        std::uint16_t bitsPerPixel_{};
+        /** 圧縮形式（BI_RGB のみ対応） */
+        std::uint32_t compression_{};
+        /** ファイル先頭からピクセル配列までのオフセット[バイト] */
+        std::uint32_t pixelOffset_{};
+        /** 行の並び（true: トップダウン（高さが負）、false: ボトムアップ） */
+        bool topDown_{};
+
+        /** @brief 1 ピクセル当たりのバイト数。 */
+        size_t bytePerPixel() const { return bitsPerPixel_ / 8; }
+        /** @brief 4 バイト境界にパディングした 1 行のバイト数。 */
+        size_t lineStride() const { return bitmapLineStride(bytePerPixel(), width_); }
+    };
+
+    /**
+     * @brief BITMAPFILEHEADER（先頭14バイト）を解析し検証します。
+     * @param header ヘッダ先頭（BITMAP_FILEHEADER_SIZE バイト以上）
+     * @param info 読み取ったメタデータ(出力)
+     * @retval true 検証成功（'BM' シグネチャ、ピクセル配列オフセット）
+     * @retval false 検証失敗
+     */
+    bool parseBitmapFileHeader(const unsigned char* header, BitmapInfo& info);
+
+    /**
+     * @brief BITMAPINFOHEADER（40バイト）からメタデータを取り出します。
+     * @details 対応形式かどうかは検証しません（ヘッダのみを調べる用途向け）。
+     * @param infoHeader ヘッダ先頭（BITMAP_INFOHEADER_SIZE バイト以上）
+     * @param info 読み取ったメタデータ(出力)
+     * @retval true 取り出し成功
+     * @retval false 幅・高さが不正
+     */
+    bool decodeBitmapInfoHeader(const unsigned char* infoHeader, BitmapInfo& info);
+
+    /**
+     * @brief メタデータが読み書き対象の形式（BI_RGB、24/32bpp、ボトムアップ）かを返します。
+     * @param info 検証するメタデータ
+     */
+    bool isSupportedBitmap(const BitmapInfo& info);
+
+    /**
+     * @brief BITMAPINFOHEADER（40バイト）を解析し検証します。
+     * @param infoHeader ヘッダ先頭（BITMAP_INFOHEADER_SIZE バイト以上）
+     * @param info 読み取ったメタデータ(出力)
+     * @retval true 検証成功（bpp、圧縮形式、幅高さ、行の並び）
+     * @retval false 検証失敗
+     */
+    bool parseBitmapInfoHeader(const unsigned char* infoHeader, BitmapInfo& info);
+
+    /**
+     * @brief BITMAPFILEHEADER（14バイト）を書き出し用に組み立てます。
+     * @param info 画像メタデータ（幅・高さ・ビット深度・ピクセル配列オフセット）
+     * @param header 出力先（BITMAP_FILEHEADER_SIZE バイト以上）
+     */
+    void serializeBitmapFileHeader(const BitmapInfo& info, unsigned char* header);
+
+    /**
+     * @brief BITMAPINFOHEADER（40バイト）を書き出し用に組み立てます。
+     * @details 32bit に収まらないピクセル配列サイズは 0（BI_RGB では省略可）として書き出します。
+     * @param info 画像メタデータ（幅・高さ・ビット深度・圧縮形式）
+     * @param infoHeader 出力先（BITMAP_INFOHEADER_SIZE バイト以上）
+     */
+    void serializeBitmapInfoHeader(const BitmapInfo& info, unsigned char* infoHeader);
+}
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file bmp_index.hpp
+ * @brief BMP ファイル群のヘッダを走査し、メタデータ索引を作成するユーティリティ。
+ */
+#ifndef __BMP_INDEX_H__
+#define __BMP_INDEX_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "bmp_header.hpp"
+
+namespace kaf::infra::codecs{
+    /**
+     * @struct BitmapIndexEntry
+     * @brief 索引の 1 ファイル分のエントリ。
+     */
+    struct BitmapIndexEntry{
+        /** ファイルパス（'/' 区切り） */
+        std::string path_;
+        /** ファイルサイズ[バイト] */
+        std::uintmax_t fileSize_{};
+        /** ヘッダを読み取れたか（false の場合 info_ は未設定） */
+        bool valid_{};
+        /** ヘッダから読み取ったメタデータ */
+        BitmapInfo info_{};
+    };
+
+    /**
+     * @brief ディレクトリ以下の BMP ファイル（拡張子 .bmp/.dib）を列挙し、ヘッダを並列に読み取ります。
+     * @details 各ファイルは BMP::probe でヘッダのみを読み取ります。結果はパス順に並びます。
+     * @param directoryPath 走査するディレクトリ
+     * @param threadCount スレッド数（1: 呼び出し元のみ、それ以外: ThreadPool::shared() で並列）
+     * @param recursive サブディレクトリも走査するか
+     * @return 索引エントリ（ディレクトリが存在しない場合は空）
+     */
+    std::vector<BitmapIndexEntry> scanBitmapDirectory(const std::string& directoryPath, const size_t threadCount = 0, const bool recursive = true);
+
+    /**
+     * @brief 索引を CSV として書き出します。
+     * @details 列: path,file_size,valid,supported,width,height,bits_per_pixel,compression,orientation
+     * @param entries 索引エントリ
+     * @param output 出力ストリーム
+     * @retval true 書き込み成功
+     * @retval false 書き込みエラー
+     */
+    bool writeBitmapIndexCsv(const std::vector<BitmapIndexEntry>& entries, std::ostream& output);
+
+    /**
+     * @brief 索引をコンパクトなバイナリ形式（リトルエンディアン）で書き出します。
+     * @details ヘッダ: "KBIX", uint32 バージョン(1), uint64 件数。
+     *          エントリ: uint32 パス長, パス, uint64 ファイルサイズ, uint32 幅, uint32 高さ,
+     *          uint16 ビット深度, uint32 圧縮形式, uint8 フラグ（bit0: valid, bit1: supported, bit2: トップダウン）。
+     * @param entries 索引エントリ
+     * @param output 出力ストリーム（バイナリ）
+     * @retval true 書き込み成功
+     * @retval false 書き込みエラー
+     */
+    bool writeBitmapIndexBinary(const std::vector<BitmapIndexEntry>& entries, std::ostream& output);
+}
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * @file bmp_line_codec.hpp
+ * @brief BMP ピクセル配列 1 行分の BGR(A) 8bit ⇔ Pixel 変換。
+ */
+#ifndef __BMP_LINE_CODEC_H__
+#define __BMP_LINE_CODEC_H__
+
+#include <cstddef>
+
+#include "../../../domain/graphics2d/include/pixel.hpp"
+#include "../../../domain/graphics2d/include/pixel_format.hpp"
+
+namespace kaf::infra::codecs{
+    /**
+     * @brief BGR(A) の 1 行をピクセル列へデコードします。
+     * @details Pixel へのデコードではアルファ成分を読み込まず、既定値（1.0）とします。
+     *          8bit 形式へのデコードは 32bpp のアルファ値をそのまま保持し（24bpp は 255）、
+     *          Gray8 は輝度（BT.601）に変換します。
+     * @tparam P ピクセル形式（Pixel, RGBA8, BGRA8, BGR8, Gray8）
+     * @param source 入力行（width * bytePerPixel バイト）
+     * @param bytePerPixel 1 ピクセル当たりのバイト数（3 or 4）
+     * @param destination 出力ピクセル列（width 要素）
+     * @param width 幅[px]
+     */
+    template<class P>
+    void decodeBitmapLine(const unsigned char* source, const size_t bytePerPixel, P* destination, const size_t width);
+
+    /**
+     * @brief ピクセル列を BGR(A) の 1 行へエンコードします。
+     * @details パディングは書き込みません。24bpp ではアルファ成分を書き出しません。
+     *          Pixel からのエンコードは各成分を [0, 1] にクランプして四捨五入します。
+     * @tparam P ピクセル形式（Pixel, RGBA8, BGRA8, BGR8, Gray8）
+     * @param source 入力ピクセル列（width 要素）
+     * @param bytePerPixel 1 ピクセル当たりのバイト数（3 or 4）
+     * @param destination 出力行（width * bytePerPixel バイト）
+     * @param width 幅[px]
+     */
+    template<class P>
+    void encodeBitmapLine(const P* source, const size_t bytePerPixel, unsigned char* destination, const size_t width);
+}
+
+#endif
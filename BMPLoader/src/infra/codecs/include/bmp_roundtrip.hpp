@@ -0,0 +1,117 @@
+/**
+ * @file bmp_roundtrip.hpp
+ * @brief BMP の読み込み→保存の往復を計測し、基準値と比べて性能の劣化を検出するユーティリティ。
+ */
+#ifndef __BMP_ROUNDTRIP_H__
+#define __BMP_ROUNDTRIP_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "bmp.hpp"
+#include "bmp_index.hpp"
+
+namespace kaf::infra::codecs{
+    /** @brief 劣化とみなす既定の閾値（基準値から 10% 悪化）。 */
+    inline constexpr double DEFAULT_REGRESSION_THRESHOLD = 0.10;
+
+    /**
+     * @struct RoundTripOptions
+     * @brief 往復計測の設定。
+     */
+    struct RoundTripOptions{
+        /** 読み込み・保存に使う設定 */
+        CodecOptions codec_;
+        /** 全ファイルを往復させる回数 */
+        size_t repeat_ = 1;
+        /** 保存先のディレクトリ（空で一時ディレクトリ）。保存したファイルは計測後すぐに削除します */
+        std::string outputDirectory_;
+    };
+
+    /**
+     * @struct RoundTripReport
+     * @brief 往復計測の結果。
+     */
+    struct RoundTripReport{
+        /** 成功した往復の回数 */
+        size_t imageCount_{};
+        /** 読み込みまたは保存に失敗した回数 */
+        size_t failureCount_{};
+        /** 成功した往復で読み込んだファイルの合計バイト数 */
+        std::uintmax_t bytes_{};
+        /** 成功した往復の合計時間[s] */
+        double seconds_{};
+        /** 読み込んだファイルのバイト数 / 時間[MB/s]（1 MB = 10^6 バイト） */
+        double megabytesPerSecond_{};
+        /** 1 秒あたりの往復回数 */
+        double imagesPerSecond_{};
+        /** 1 往復の所要時間の中央値[ms] */
+        double p50Milliseconds_{};
+        /** 1 往復の所要時間の 99 パーセンタイル[ms] */
+        double p99Milliseconds_{};
+        /**
+         * 計測終了時点でのプロセスの最大常駐メモリ[バイト]（取得できない環境では 0）。
+         * プロセス開始からの最大値のため、同じプロセスで先に行った処理（コーパス生成など）の分も含みます
+         */
+        std::uintmax_t peakResidentBytes_{};
+    };
+
+    /**
+     * @struct RoundTripComparison
+     * @brief 1 指標分の基準値との比較。
+     */
+    struct RoundTripComparison{
+        /** 指標名（CSV の metric 列と同じ） */
+        std::string metric_;
+        double baseline_{};
+        double current_{};
+        /** 悪化の割合（0.1 で 10% 悪化、負の値は改善） */
+        double change_{};
+        /** 閾値を超えて悪化したか */
+        bool regressed_{};
+    };
+
+    /**
+     * @brief 各ファイルを BasicBMP<P> で読み込み、同じビット深度で保存する往復を計測します。
+     * @details 1 往復の時間は loadImage と saveImage の合計です（保存したファイルの削除は含みません）。
+     *          未対応の BMP（isSupportedBitmap が false）は対象外です。
+     * @param entries 対象ファイル（scanBitmapDirectory の結果など）
+     * @param options 計測の設定
+     * @param report 計測結果
+     * @retval true 1 回以上往復し、失敗がなかった
+     * @retval false 失敗があった、または対象のファイルがなかった
+     */
+    template<class P>
+    bool runRoundTrip(const std::vector<BitmapIndexEntry>& entries, const RoundTripOptions& options, RoundTripReport& report);
+
+    /**
+     * @brief 基準値と比べます。
+     * @details スループット（MB/s、images/s）は低下を、所要時間（p50、p99）と最大常駐メモリは増加を悪化とみなします。
+     *          基準値が 0 の指標は比較しません（change_ は 0）。
+     * @param baseline 基準値
+     * @param current 今回の結果
+     * @param threshold 劣化とみなす悪化の割合（0.1 で 10%）
+     * @return 指標ごとの比較
+     */
+    std::vector<RoundTripComparison> compareRoundTrip(const RoundTripReport& baseline, const RoundTripReport& current, const double threshold = DEFAULT_REGRESSION_THRESHOLD);
+
+    /**
+     * @brief 結果を CSV（列: metric,value）として書き出します。基準値の保存に使います。
+     * @retval true 書き込み成功
+     * @retval false 書き込みエラー
+     */
+    bool writeRoundTripReportCsv(const RoundTripReport& report, std::ostream& output);
+
+    /**
+     * @brief writeRoundTripReportCsv で書き出した CSV を読み込みます（未知の指標は無視します）。
+     * @retval true 読み込み成功
+     * @retval false 形式が不正
+     */
+    bool readRoundTripReportCsv(std::istream& input, RoundTripReport& report);
+}
+
+#endif
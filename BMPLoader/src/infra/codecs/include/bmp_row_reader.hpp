@@ -0,0 +1,72 @@
+/**
+ * @file bmp_row_reader.hpp
+ * @brief BMP を 1 行ずつ読み込むストリーミングリーダ。
+ */
+#ifndef __BMP_ROW_READER_H__
+#define __BMP_ROW_READER_H__
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "bmp_header.hpp"
+#include "../../../domain/graphics2d/include/pixel.hpp"
+
+namespace kaf::infra::codecs{
+    /**
+     * @class BmpRowReader
+     * @brief BMP ファイルを画像の上の行から順に 1 行ずつデコードします。
+     * @details ファイル上のボトムアップ順序とパディングはこのクラスが吸収します。
+     *          保持するのは 1 行分のステージングバッファのみで、画像全体は展開しません。
+     */
+    class BmpRowReader{
+    public:
+        /** @brief 既定コンストラクタ。何も開いていない状態で初期化します。 */
+        BmpRowReader();
+        ~BmpRowReader();
+        BmpRowReader(const BmpRowReader& other) = delete;
+        BmpRowReader& operator=(const BmpRowReader& other) = delete;
+        BmpRowReader(BmpRowReader&& other) = default;
+        BmpRowReader& operator=(BmpRowReader&& other) = default;
+
+        /**
+         * @brief BMP ファイルを開き、ヘッダを検証します。
+         * @param inputFilePath 入力ファイルパス
+         * @retval true 成功
+         * @retval false 失敗（ファイル不在、不正ヘッダ、未対応形式、ピクセル配列の欠落 等）
+         */
+        bool open(const std::string& inputFilePath);
+        /** @brief ファイルを閉じます。 */
+        void close();
+        /** @brief ファイルを開いているか。 */
+        bool isOpen() const { return inputFile_.is_open(); }
+
+        size_t getWidth() const { return info_.width_; }
+        size_t getHeight() const { return info_.height_; }
+        /** @brief ヘッダから読み取ったメタデータ。 */
+        const BitmapInfo& getInfo() const { return info_; }
+        /** @brief 次に readLine で得られる行の Y 座標（0 が最上行）。 */
+        size_t getNextLine() const { return nextLine_; }
+
+        /**
+         * @brief 次の 1 行を読み込みます。
+         * @param line 出力ピクセル列（幅に合わせてリサイズされます）
+         * @retval true 読み込み成功
+         * @retval false 失敗（未オープン、全行読み込み済み、読み取りエラー 等）
+         */
+        bool readLine(std::vector<domain::graphics2d::Pixel>& line);
+
+    private:
+        /** 入力ストリーム */
+        std::ifstream inputFile_;
+        /** ヘッダ情報 */
+        BitmapInfo info_{};
+        /** 次に読み込む行（0 が最上行） */
+        size_t nextLine_{};
+        /** 1 行分のステージングバッファ */
+        std::vector<unsigned char> staging_;
+    };
+}
+
+#endif
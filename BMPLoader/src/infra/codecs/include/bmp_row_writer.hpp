@@ -0,0 +1,75 @@
+/**
+ * @file bmp_row_writer.hpp
+ * @brief BMP を 1 行ずつ書き出すストリーミングライタ。
+ */
+#ifndef __BMP_ROW_WRITER_H__
+#define __BMP_ROW_WRITER_H__
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "bmp_header.hpp"
+#include "../../../domain/graphics2d/include/pixel.hpp"
+
+namespace kaf::infra::codecs{
+    /**
+     * @class BmpRowWriter
+     * @brief 画像の上の行から順に受け取ったピクセル列を BMP（BI_RGB）として書き出します。
+     * @details 各行はファイル上のボトムアップ位置へ直接書き込まれ、パディングも付与されます。
+     *          保持するのは 1 行分のステージングバッファのみです。
+     */
+    class BmpRowWriter{
+    public:
+        /** @brief 既定コンストラクタ。何も開いていない状態で初期化します。 */
+        BmpRowWriter();
+        ~BmpRowWriter();
+        BmpRowWriter(const BmpRowWriter& other) = delete;
+        BmpRowWriter& operator=(const BmpRowWriter& other) = delete;
+        BmpRowWriter(BmpRowWriter&& other) = default;
+        BmpRowWriter& operator=(BmpRowWriter&& other) = default;
+
+        /**
+         * @brief 出力ファイルを作成し、ヘッダを書き込みます。
+         * @param outputFilePath 出力ファイルパス（既存ファイルは上書きしません）
+         * @param width 幅[px]
+         * @param height 高さ[px]
+         * @param bitPerPixel ビット深度（24 or 32）
+         * @retval true 成功
+         * @retval false 失敗（既存ファイル、不正サイズ、書き込み失敗 等）
+         */
+        bool open(const std::string& outputFilePath, const size_t width, const size_t height, const size_t bitPerPixel = 32);
+
+        /**
+         * @brief 次の 1 行を書き込みます。
+         * @param line 入力ピクセル列（幅と同じ要素数）
+         * @retval true 書き込み成功
+         * @retval false 失敗（未オープン、全行書き込み済み、幅不一致、書き込みエラー 等）
+         */
+        bool writeLine(const std::vector<domain::graphics2d::Pixel>& line);
+
+        /**
+         * @brief ファイルを閉じます。
+         * @retval true 全行を書き込み済みで正常に閉じた
+         * @retval false 行が不足している、または書き込みエラー
+         */
+        bool close();
+        /** @brief ファイルを開いているか。 */
+        bool isOpen() const { return outputFile_.is_open(); }
+        /** @brief 次に writeLine で書き込む行の Y 座標（0 が最上行）。 */
+        size_t getNextLine() const { return nextLine_; }
+
+    private:
+        /** 出力ストリーム */
+        std::ofstream outputFile_;
+        /** ヘッダ情報 */
+        BitmapInfo info_{};
+        /** 次に書き込む行（0 が最上行） */
+        size_t nextLine_{};
+        /** 1 行分のステージングバッファ（パディング込み） */
+        std::vector<unsigned char> staging_;
+    };
+}
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file codec_events.hpp
+ * @brief 読み書き中に IEventSink へ送るイベント（進捗、中断）。
+ */
+#ifndef __CODEC_EVENTS_H__
+#define __CODEC_EVENTS_H__
+
+#include <cstddef>
+
+namespace kaf::infra::codecs{
+    /** @brief イベントを送った処理。 */
+    enum class CodecOperation{
+        Load,
+        Save,
+    };
+
+    /** @brief 中断の理由。 */
+    enum class CodecAbortReason{
+        /** CancellationToken で中断が要求された */
+        Cancelled,
+        /** 期限を過ぎた */
+        DeadlineExceeded,
+    };
+
+    /** @brief 文字列表現を返します。 */
+    const char* toString(const CodecOperation operation);
+    /** @brief 文字列表現を返します。 */
+    const char* toString(const CodecAbortReason reason);
+
+    /**
+     * @struct CodecProgress
+     * @brief 進捗（CodecOptions::progressInterval_ ごとに最大 1 回と、成功時の最後に 1 回）。
+     */
+    struct CodecProgress{
+        CodecOperation operation_ = CodecOperation::Load;
+        /** 処理済みの行数 */
+        size_t rowsDone_{};
+        /** 全体の行数 */
+        size_t rowCount_{};
+        /** 読み書き済みのピクセル配列のバイト数（パディング込み） */
+        size_t bytesDone_{};
+        /** ピクセル配列全体のバイト数 */
+        size_t byteCount_{};
+    };
+
+    /**
+     * @struct CodecAborted
+     * @brief 中断（読み書きは失敗として戻ります）。
+     */
+    struct CodecAborted{
+        CodecOperation operation_ = CodecOperation::Load;
+        CodecAbortReason reason_ = CodecAbortReason::Cancelled;
+        /** 中断までに処理した行数 */
+        size_t rowsDone_{};
+        /** 全体の行数 */
+        size_t rowCount_{};
+    };
+}
+
+#endif
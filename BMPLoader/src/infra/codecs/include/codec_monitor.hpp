@@ -0,0 +1,81 @@
+/**
+ * @file codec_monitor.hpp
+ * @brief 読み書きの行帯ごとの進捗通知と中断判定。
+ */
+#ifndef __CODEC_MONITOR_H__
+#define __CODEC_MONITOR_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "bmp.hpp"
+#include "codec_events.hpp"
+
+namespace kaf::infra::codecs{
+    /**
+     * @class CodecMonitor
+     * @brief 1 回の読み込み・保存について、進捗を間引いて送り、中断要求と期限を確認します。
+     * @details 送り先・中断要求・期限のいずれも指定されていない場合、各呼び出しは分岐 1 つで戻ります。
+     *          advance はワーカースレッドから同時に呼び出せます（進捗は 1 スレッドだけが送ります）。
+     */
+    class CodecMonitor{
+    public:
+        /**
+         * @param options 動作設定（送り先、中断要求、期限、進捗の間隔）
+         * @param operation 処理の種類
+         * @param rowCount 全体の行数
+         * @param byteCount ピクセル配列全体のバイト数
+         */
+        CodecMonitor(const CodecOptions& options, const CodecOperation operation, const size_t rowCount, const size_t byteCount);
+        CodecMonitor(const CodecMonitor& other) = delete;
+        CodecMonitor& operator=(const CodecMonitor& other) = delete;
+
+        /**
+         * @brief 中断要求と期限を確認します（中断する場合は CodecAborted を 1 度だけ送ります）。
+         * @retval true 続行
+         * @retval false 中断
+         */
+        bool checkpoint();
+
+        /**
+         * @brief 行帯の完了を記録し、間隔を過ぎていれば進捗を送り、続行するかを返します。
+         * @param rows 完了した行数
+         * @param bytes 完了したバイト数
+         * @retval true 続行
+         * @retval false 中断
+         */
+        bool advance(const size_t rows, const size_t bytes);
+
+        /** @brief 成功時の最後の進捗を送ります。 */
+        void finish();
+
+        /** @brief 中断したか。 */
+        bool isAborted() const { return aborted_.load(std::memory_order_relaxed); }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        static std::int64_t ticks(const Clock::time_point time);
+        void abort(const CodecAbortReason reason);
+        void publishProgress();
+
+        domain::common::IEventSink* sink_;
+        const domain::common::CancellationToken* cancellation_;
+        Clock::time_point deadline_;
+        std::int64_t interval_;
+        CodecOperation operation_;
+        size_t rowCount_;
+        size_t byteCount_;
+        /** 送り先・中断要求・期限のいずれかがあるか */
+        bool active_;
+        std::atomic<size_t> rowsDone_{0};
+        std::atomic<size_t> bytesDone_{0};
+        /** 次に進捗を送れる時刻 */
+        std::atomic<std::int64_t> nextReport_{0};
+        std::atomic<bool> aborted_{false};
+    };
+}
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file mapped_bmp.hpp
+ * @brief メモリマップした BMP ファイルの読み取り専用ビュー。
+ */
+#ifndef __MAPPED_BMP_H__
+#define __MAPPED_BMP_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "bmp_header.hpp"
+#include "mapped_file.hpp"
+#include "../../../domain/graphics2d/include/image_view.hpp"
+#include "../../../domain/graphics2d/include/pixel_format.hpp"
+
+namespace kaf::infra::codecs{
+    /**
+     * @class MappedBMP
+     * @brief BMP ファイルをマップし、ピクセル配列をコピーせずに BGR(A) 8bit のまま参照します。
+     * @details BMP と同じヘッダ検証を行い、非圧縮(BI_RGB)の 24/32bpp を対象とします。
+     *          行はファイル上ボトムアップで並ぶため、画像座標 y（0 が最上行）から
+     *          行先頭への変換はこのクラスが行います。
+     */
+    class MappedBMP{
+    public:
+        /** @brief 既定コンストラクタ。空のビューで初期化します。 */
+        MappedBMP();
+        ~MappedBMP();
+        MappedBMP(const MappedBMP& other) = delete;
+        MappedBMP& operator=(const MappedBMP& other) = delete;
+        MappedBMP(MappedBMP&& other) noexcept;
+        MappedBMP& operator=(MappedBMP&& other) noexcept;
+
+        /**
+         * @brief BMP ファイルをマップし、ヘッダを検証します。
+         * @param inputFilePath 入力ファイルパス
+         * @retval true マップ成功
+         * @retval false 失敗（ファイル不在、不正ヘッダ、未対応形式、ピクセル配列の欠落 等）
+         */
+        bool open(const std::string& inputFilePath);
+        /** @brief マップを解放し、空のビューに戻します。 */
+        void close();
+
+        /** @brief ビューが有効か。 */
+        bool isValid() const { return file_.isOpen(); }
+
+        size_t getWidth() const { return info_.width_; }
+        size_t getHeight() const { return info_.height_; }
+        /** @brief 1 ピクセル当たりのバイト数（3: BGR, 4: BGRA）。 */
+        size_t getBytePerPixel() const { return info_.bytePerPixel(); }
+        /** @brief パディング込みの 1 行のバイト数。 */
+        size_t getLineStride() const { return info_.lineStride(); }
+        /** @brief ヘッダから読み取ったメタデータ。 */
+        const BitmapInfo& getInfo() const { return info_; }
+
+        /**
+         * @brief ピクセル配列の先頭（ファイル上の最下行）を返します。
+         * @return パディング込みで getHeight() 行が連続するバイト列（無効時 nullptr）
+         */
+        const std::uint8_t* getPixelArray() const { return isValid() ? file_.data() + info_.pixelOffset_ : nullptr; }
+
+        /**
+         * @brief 指定行の先頭を返します。
+         * @param height Y 座標（0 が最上行）
+         * @return 行先頭の BGR(A) バイト列（範囲外・無効時 nullptr）
+         */
+        const std::uint8_t* getLine(const size_t height) const;
+
+        /**
+         * @brief 指定位置のピクセルを返します。
+         * @param width X 座標
+         * @param height Y 座標（0 が最上行）
+         * @return ピクセルの BGR(A) バイト列（範囲外・無効時 nullptr）
+         */
+        const std::uint8_t* getPixel(const size_t width, const size_t height) const;
+
+        /**
+         * @brief 24bpp のピクセル配列を上から順の BGR8 ビューとして返します（コピーしません）。
+         * @details 行はボトムアップのまま、負の行ストライドで参照します。
+         * @return ビュー（32bpp・無効時は空のビュー）
+         */
+        domain::graphics2d::BasicImageView<const domain::graphics2d::BGR8> getBgrView() const;
+
+        /**
+         * @brief 32bpp のピクセル配列を上から順の BGRA8 ビューとして返します（コピーしません）。
+         * @return ビュー（24bpp・無効時は空のビュー）
+         */
+        domain::graphics2d::BasicImageView<const domain::graphics2d::BGRA8> getBgraView() const;
+
+    private:
+        /** マップしたファイル */
+        MappedFile file_;
+        /** ヘッダ情報 */
+        BitmapInfo info_{};
+    };
+}
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file mapped_file.hpp
+ * @brief 読み取り専用のファイルメモリマップ。
+ */
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <cstddef>
+#include <string>
+
+namespace kaf::infra::codecs{
+    /**
+     * @class MappedFile
+     * @brief ファイル全体を読み取り専用で共有マップします。
+     * @details 共有マップのため、同じファイルを開く複数プロセス間でページキャッシュが共有されます。
+     */
+    class MappedFile{
+    public:
+        /** @brief 既定コンストラクタ。何もマップしていない状態で初期化します。 */
+        MappedFile();
+        ~MappedFile();
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @brief ファイルをマップします。既にマップ済みなら先に解放します。
+         * @param inputFilePath 入力ファイルパス
+         * @retval true マップ成功
+         * @retval false 失敗（ファイル不在、空ファイル、マップ失敗 等）
+         */
+        bool open(const std::string& inputFilePath);
+        /** @brief マップを解放します。 */
+        void close();
+
+        /** @brief マップ済みか。 */
+        bool isOpen() const { return data_ != nullptr; }
+        /** @brief マップ先頭。 */
+        const unsigned char* data() const { return data_; }
+        /** @brief マップサイズ[バイト]。 */
+        size_t size() const { return size_; }
+
+    private:
+        /** マップ先頭 */
+        const unsigned char* data_ = nullptr;
+        /** マップサイズ[バイト] */
+        size_t size_{};
+#ifdef _WIN32
+        /** ファイルマッピングオブジェクトのハンドル */
+        void* mapping_ = nullptr;
+#endif
+    };
+}
+
+#endif
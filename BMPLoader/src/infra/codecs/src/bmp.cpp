@@ -3,6 +3,9 @@
  * @brief BMP 読み書きクラスの実装（進行中）。
  */
 #include "../include/bmp.hpp"
+#include "../include/bmp_line_codec.hpp"
+#include "../include/codec_monitor.hpp"
+#include "../include/mapped_bmp.hpp"
 
 #include <fstream>
 #include <algorithm>
@@ -10,85 +13,96 @@
 #include <optional>
 #include <cstdint>
 #include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
 
 #include "../../../domain/graphics2d/include/image.hpp"
 #include "../../../domain/graphics2d/include/pixel.hpp"
 #include "../../../domain/graphics2d/include/pixel_buffer.hpp"
+#include "../../../domain/common/include/log.hpp"
+#include "../../../domain/common/include/thread_pool.hpp"
 
 namespace kaf::infra::codecs{
+    namespace {
+        /** @brief 1 回の read で読み込むステージングバッファの目安サイズ[バイト]。 */
+        constexpr size_t STAGING_BUFFER_SIZE = 4 * 1024 * 1024;
+        /** @brief 並列エンコード時のステージングバッファの上限[バイト]（スレッド数によらない）。 */
+        constexpr size_t MAX_SAVE_STAGING_SIZE = 16 * 1024 * 1024;
+        /** @brief 並列デコードで進捗の記録と中断の確認を行う間隔の目安[バイト]。 */
+        constexpr size_t CHECKPOINT_BAND_SIZE = 1024 * 1024;
 
-    BMP::BMP(): ::kaf::domain::graphics2d::Image(){
+        /** @brief 設定値から実際に使うスレッド数を決めます（0 はハードウェアスレッド数）。 */
+        size_t resolveThreadCount(const size_t threadCount){
+            if(threadCount != 0){
+                return threadCount;
+            }
+            return std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        /**
+         * @brief [0, lineCount) を threadCount 個の行帯に分割し、各行帯で function(begin, end) を共有プール上で並列に呼び出します。
+         * @details スレッドは ThreadPool::shared() のワーカーを再利用するため、呼び出しごとの起動・終了はなく、
+         *          threadCount がコア数より多くても同時に動くのはプールの並列度までです。
+         * @return すべての呼び出しが true を返した場合 true
+         */
+        template<class Function>
+        bool forEachLineBand(const size_t lineCount, const size_t threadCount, Function&& function){
+            const size_t bandCount = std::min(threadCount, lineCount);
+            if(bandCount <= 1){
+                return function(size_t{0}, lineCount);
+            }
+            const size_t bandSize = (lineCount + bandCount - 1) / bandCount;
+            std::atomic<bool> result{true};
+            domain::common::ThreadPool::shared().parallelFor(0, lineCount, bandSize, [&](const size_t begin, const size_t end){
+                if(!function(begin, end)){
+                    result.store(false, std::memory_order_relaxed);
+                }
+            });
+            return result.load(std::memory_order_relaxed);
+        }
+    }
+
+    template<class P>
+    BasicBMP<P>::BasicBMP(): Base(){
         // Default constructor
     }
 
-    BMP::BMP(const size_t width, const size_t height, const kaf::domain::graphics2d::Pixel& pixel):
-        ::kaf::domain::graphics2d::Image(width, height, pixel){
+    template<class P>
+    BasicBMP<P>::BasicBMP(const size_t width, const size_t height, const P& pixel):
+        Base(width, height, pixel){
     }
 
-    BMP::~BMP(){
+    template<class P>
+    BasicBMP<P>::~BasicBMP(){
         setHeight(0);
         setWidth(0);
         setPixelBuffer(nullptr);
     }
-    BMP::BMP(const BMP& other){
-        if(other.getPixelBuffer() != nullptr){
-            auto otherBuffer = other.getPixelBuffer();
-            std::unique_ptr<domain::graphics2d::PixelBuffer> tmpBuffer = std::make_unique<domain::graphics2d::PixelBuffer>(otherBuffer->size_);
-            if(tmpBuffer == nullptr) return;
-            bool result = domain::graphics2d::setPixels(*tmpBuffer, otherBuffer->pixels_, otherBuffer->size_, 0);
-            if(!result){
-                tmpBuffer = nullptr;
-                return;
-            }
-            setPixelBuffer(std::move(tmpBuffer));
-        } else {
-            setPixelBuffer(nullptr);
-        }
-        setHeight(other.getHeight());
-        setWidth(other.getWidth());
+    template<class P>
+    BasicBMP<P>::BasicBMP(const BasicBMP& other): Base(other){
     }
-    BMP& BMP::operator=(const BMP& other){
-        if(this == &other){
-            return *this;
-        }
-        if(other.getPixelBuffer() != nullptr){
-            auto otherBuffer = other.getPixelBuffer();
-            std::unique_ptr<domain::graphics2d::PixelBuffer> tmpBuffer = std::make_unique<domain::graphics2d::PixelBuffer>(otherBuffer->size_);
-            if(tmpBuffer == nullptr) return *this;
-            bool result = domain::graphics2d::setPixels(*tmpBuffer, otherBuffer->pixels_, otherBuffer->size_, 0);
-            if(!result){
-                tmpBuffer = nullptr;
-                return *this;
-            }
-            setPixelBuffer(std::move(tmpBuffer));
-        } else {
-            setPixelBuffer(nullptr);
-        }
-        setHeight(other.getHeight());
-        setWidth(other.getWidth());
+    template<class P>
+    BasicBMP<P>& BasicBMP<P>::operator=(const BasicBMP& other){
+        Base::operator=(other);
         return *this;
     }
-    BMP::BMP(BMP&& other){
-        setHeight(other.getHeight());
-        setWidth(other.getWidth());
-        setPixelBuffer(other.passPixelBuffer());
+    template<class P>
+    BasicBMP<P>::BasicBMP(BasicBMP&& other): Base(std::move(other)){
     }
-    BMP& BMP::operator=(BMP&& other){
-        if(this == &other){
-            return *this;
-        }
-        setHeight(other.getHeight());
-        setWidth(other.getWidth());
-        setPixelBuffer(other.passPixelBuffer());
+    template<class P>
+    BasicBMP<P>& BasicBMP<P>::operator=(BasicBMP&& other){
+        Base::operator=(std::move(other));
         return *this;
     }
 
-    bool BMP::setImage(const domain::graphics2d::PixelBuffer& pixelBuffer, size_t width, size_t height){
+    template<class P>
+    bool BasicBMP<P>::setImage(const BufferType& pixelBuffer, size_t width, size_t height){
         std::optional<size_t> size = domain::graphics2d::mul_size(width, height);
         if(!size.has_value()) return false;
         if(!pixelBuffer.isValid()) return false;
         if(pixelBuffer.size_ != size.value()) return false;
-        std::unique_ptr<domain::graphics2d::PixelBuffer> tmpBuffer = std::make_unique<domain::graphics2d::PixelBuffer>(size.value());
+        std::unique_ptr<BufferType> tmpBuffer = std::make_unique<BufferType>(size.value(), domain::graphics2d::UNINITIALIZED);
         if(tmpBuffer == nullptr) return false;
         bool result = domain::graphics2d::setPixels(*tmpBuffer, pixelBuffer.pixels_, size.value(), 0);
         if(!result){
@@ -101,232 +115,374 @@ namespace kaf::infra::codecs{
         return true;
     }
 
-    bool BMP::loadImage(const std::string& inputFilePath){
-        if(getPixelBuffer() != nullptr){
-            setPixelBuffer(nullptr);
+    template<class P>
+    bool BasicBMP<P>::loadImage(const std::string& inputFilePath){
+        return loadImage(inputFilePath, CodecOptions{});
+    }
+
+    template<class P>
+    bool BasicBMP<P>::loadImage(const std::string& inputFilePath, const CodecOptions& options){
+        const size_t threadCount = resolveThreadCount(options.threadCount_);
+        if(threadCount > 1){
+            return loadMappedImage(inputFilePath, threadCount, options);
         }
+        setPixelBuffer(nullptr);
         std::filesystem::path filePath(inputFilePath);
         if(!std::filesystem::exists(filePath)) {return false;}
         std::ifstream inputFile(filePath.c_str(), std::ios::binary);
         if(!inputFile.is_open()){
-            fprintf(stderr, "Failed to open input file: %s\n", inputFilePath.c_str());
+            KAF_LOG_ERROR("Failed to open input file: %s", inputFilePath.c_str());
+            inputFile.close();
+            return false;
+        }
+        BitmapInfo info;
+        if(!readBitmapFileHeader(inputFile, info)){
+            KAF_LOG_ERROR("Failed to read BMP file header");
             inputFile.close();
             return false;
         }
-        if(!readBitmapFileHeader(inputFile)){
-            fprintf(stderr, "Failed to read BMP file header\n");
+        if(!readBitmapInfoHeader(inputFile, info)){
+            KAF_LOG_ERROR("Failed to read BMP info header");
             inputFile.close();
             return false;
         }
-        std::uint16_t bitsPerPixel = 0;
-        if(!readBitmapInfoHeader(inputFile, bitsPerPixel)){
-            fprintf(stderr, "Failed to read BMP info header\n");
+        if(!inputFile.seekg(info.pixelOffset_)){
+            KAF_LOG_ERROR("Failed to seek to pixel array");
             inputFile.close();
             return false;
         }
         auto size = domain::graphics2d::mul_size(getWidth(), getHeight());
         if(!size.has_value()){
-            fprintf(stderr, "Invalid image size\n");
+            KAF_LOG_ERROR("Invalid image size");
+            inputFile.close();
+            return false;
+        }
+        CodecMonitor monitor(options, CodecOperation::Load, getHeight(), info.lineStride() * getHeight());
+        if(!monitor.checkpoint()){
+            KAF_LOG_INFO("BMP load aborted before decoding: %s", inputFilePath.c_str());
             inputFile.close();
             return false;
         }
-        std::unique_ptr<domain::graphics2d::PixelBuffer> pixelBuffer = std::make_unique<domain::graphics2d::PixelBuffer>(size.value());
+        std::unique_ptr<BufferType> pixelBuffer = std::make_unique<BufferType>(size.value(), domain::graphics2d::UNINITIALIZED, options.bufferPool_);
         if(!pixelBuffer->isValid()){
-            fprintf(stderr, "Invalid pixel buffer\n");
+            KAF_LOG_ERROR("Invalid pixel buffer");
             inputFile.close();
             return false;
         }
         if(pixelBuffer->size_ != size.value()){
-            fprintf(stderr, "Pixel buffer size does not match expected size\n");
+            KAF_LOG_ERROR("Pixel buffer size does not match expected size");
             inputFile.close();
             return false;
         }
         setPixelBuffer(std::move(pixelBuffer));
-        const size_t byteParPixel = static_cast<size_t>(bitsPerPixel / 8);
-        for(size_t line = 0; line < getHeight(); ++line){
-            if(!readBitmapCollorBuffer(inputFile, byteParPixel, line)){
-                fprintf(stderr, "Failed to read color buffer at line %zu\n", line);
+        const size_t byteParPixel = info.bytePerPixel();
+        const size_t linesPerRead = std::max<size_t>(1, STAGING_BUFFER_SIZE / info.lineStride());
+        std::vector<unsigned char> staging;
+        for(size_t line = 0; line < getHeight(); line += linesPerRead){
+            const size_t lineCount = std::min(linesPerRead, getHeight() - line);
+            if(!readBitmapCollorBuffer(inputFile, byteParPixel, line, lineCount, staging)){
+                KAF_LOG_ERROR("Failed to read color buffer at line %zu", line);
                 setPixelBuffer(nullptr);
                 inputFile.close();
                 break;
             }
-            fprintf(stderr, "Successfully read line %zu\n", line);
+            KAF_LOG_TRACE("Successfully read lines %zu-%zu", line, line + lineCount - 1);
+            if(!monitor.advance(lineCount, lineCount * info.lineStride())){
+                KAF_LOG_INFO("BMP load aborted at line %zu: %s", line + lineCount, inputFilePath.c_str());
+                setPixelBuffer(nullptr);
+                inputFile.close();
+                return false;
+            }
         }
         if(!isValid()){
-            fprintf(stderr, "BMP image is not valid after loading\n");
+            KAF_LOG_ERROR("BMP image is not valid after loading");
             inputFile.close();
             return false;
         }
         inputFile.close();
-        fprintf(stderr, "Successfully loaded BMP file: %s\n", inputFilePath.c_str());
+        monitor.finish();
+        KAF_LOG_INFO("Successfully loaded BMP file: %s", inputFilePath.c_str());
         return true;
     }
     
-    bool BMP::saveImage(const std::string& outputFilePath, const size_t bitPerPixel)const {
-        if(getPixelBuffer() == nullptr || !getPixelBuffer()->isValid()){
-            fprintf(stderr, "Invalid pixel buffer\n");
+    template<class P>
+    bool BasicBMP<P>::loadMappedImage(const std::string& inputFilePath, const size_t threadCount, const CodecOptions& options){
+        setPixelBuffer(nullptr);
+        MappedBMP mapped;
+        if(!mapped.open(inputFilePath)){
+            return false;
+        }
+        auto size = domain::graphics2d::mul_size(mapped.getWidth(), mapped.getHeight());
+        if(!size.has_value()){
+            KAF_LOG_ERROR("Invalid image size");
+            return false;
+        }
+        const size_t stride = mapped.getLineStride();
+        CodecMonitor monitor(options, CodecOperation::Load, mapped.getHeight(), stride * mapped.getHeight());
+        if(!monitor.checkpoint()){
+            KAF_LOG_INFO("BMP load aborted before decoding: %s", inputFilePath.c_str());
+            return false;
+        }
+        std::unique_ptr<BufferType> pixelBuffer = std::make_unique<BufferType>(size.value(), domain::graphics2d::UNINITIALIZED, options.bufferPool_);
+        if(!pixelBuffer->isValid()){
+            KAF_LOG_ERROR("Invalid pixel buffer");
+            return false;
+        }
+        setPixelBuffer(std::move(pixelBuffer));
+        setWidth(mapped.getWidth());
+        setHeight(mapped.getHeight());
+        const unsigned char* pixelArray = mapped.getPixelArray();
+        const size_t bytePerPixel = mapped.getBytePerPixel();
+        const size_t linesPerCheckpoint = std::max<size_t>(1, CHECKPOINT_BAND_SIZE / stride);
+        const bool result = forEachLineBand(getHeight(), threadCount, [&](const size_t begin, const size_t end){
+            KAF_LOG_TRACE("Decoding lines %zu-%zu", begin, end - 1);
+            for(size_t line = begin; line < end; line += linesPerCheckpoint){
+                const size_t lineCount = std::min(linesPerCheckpoint, end - line);
+                if(!decodeBitmapCollorBuffer(pixelArray + line * stride, bytePerPixel, line, lineCount) ||
+                    !monitor.advance(lineCount, lineCount * stride)){
+                    return false;
+                }
+            }
+            return true;
+        });
+        if(monitor.isAborted()){
+            KAF_LOG_INFO("BMP load aborted: %s", inputFilePath.c_str());
+            setPixelBuffer(nullptr);
+            return false;
+        }
+        if(!result || !isValid()){
+            KAF_LOG_ERROR("BMP image is not valid after loading");
+            setPixelBuffer(nullptr);
+            return false;
+        }
+        monitor.finish();
+        KAF_LOG_INFO("Successfully loaded BMP file: %s (%zu threads)", inputFilePath.c_str(), std::min(threadCount, getHeight()));
+        return true;
+    }
+
+    template<class P>
+    bool BasicBMP<P>::saveImage(const std::string& outputFilePath, const size_t bitPerPixel)const {
+        return saveImage(outputFilePath, bitPerPixel, CodecOptions{});
+    }
+
+    template<class P>
+    bool BasicBMP<P>::saveImage(const std::string& outputFilePath, const size_t bitPerPixel, const CodecOptions& options)const {
+        if(getPixelBuffer() == nullptr || !isValid()){
+            KAF_LOG_ERROR("Invalid pixel buffer");
+            return false;
+        }
+        return saveView(outputFilePath, domain::graphics2d::makeView(*this), bitPerPixel, options);
+    }
+
+    template<class P>
+    bool BasicBMP<P>::saveView(const std::string& outputFilePath, const ConstViewType& view, const size_t bitPerPixel, const CodecOptions& options){
+        if(!view.isValid()){
+            KAF_LOG_ERROR("Invalid image view");
+            return false;
+        }
+        if(bitPerPixel != 24 && bitPerPixel != 32){
+            KAF_LOG_ERROR("Unsupported bits per pixel: %zu", bitPerPixel);
             return false;
         }
         const size_t bytePerPixel = bitPerPixel / 8;
         std::filesystem::path filePath(outputFilePath);
         if(std::filesystem::exists(filePath)) {return false;}
+        const size_t lineStride = bitmapLineStride(bytePerPixel, view.getWidth());
+        CodecMonitor monitor(options, CodecOperation::Save, view.getHeight(), lineStride * view.getHeight());
+        if(!monitor.checkpoint()){
+            KAF_LOG_INFO("BMP save aborted before encoding: %s", outputFilePath.c_str());
+            return false;
+        }
         std::ofstream outputFile(filePath.c_str(), std::ios::binary);
         if(!outputFile.is_open()){
-            fprintf(stderr, "Failed to open output file: %s\n", outputFilePath.c_str());
+            KAF_LOG_ERROR("Failed to open output file: %s", outputFilePath.c_str());
             outputFile.close();
             return false;
         }
 
-        if(!writeBitmapFileHeader(outputFile, bytePerPixel)) {
-            fprintf(stderr, "Failed to write BMP file header\n");
+        BitmapInfo info;
+        info.width_ = view.getWidth();
+        info.height_ = view.getHeight();
+        info.bitsPerPixel_ = static_cast<std::uint16_t>(bitPerPixel);
+        info.compression_ = BI_RGB;
+        info.pixelOffset_ = static_cast<std::uint32_t>(BITMAP_FILEHEADER_SIZE + BITMAP_INFOHEADER_SIZE);
+        if(!writeBitmapFileHeader(outputFile, info)) {
+            KAF_LOG_ERROR("Failed to write BMP file header");
             outputFile.close();
             return false;
         }
 
-        if(!writeBitmapInfoHeader(outputFile, bytePerPixel)) {
-            fprintf(stderr, "Failed to write BMP info header\n");
+        if(!writeBitmapInfoHeader(outputFile, info)) {
+            KAF_LOG_ERROR("Failed to write BMP info header");
             outputFile.close();
             return false;
         }
 
-        for(size_t line = 0; line < getHeight(); ++line) {
-            if(!writeBitmapCollorBuffer(outputFile, bytePerPixel, line)) {
-                fprintf(stderr, "Failed to write color buffer at line %zu\n", line);
+        const size_t threadCount = resolveThreadCount(options.threadCount_);
+        // 1 回の書き込み分を threadCount 個の行帯に分けてエンコードするので、スレッド数が多くてもバッファは上限までに抑えます
+        const size_t stagingSize = std::min(STAGING_BUFFER_SIZE * threadCount, MAX_SAVE_STAGING_SIZE);
+        const size_t linesPerWrite = std::max<size_t>(1, stagingSize / info.lineStride());
+        std::vector<unsigned char> staging;
+        for(size_t line = 0; line < view.getHeight(); line += linesPerWrite) {
+            const size_t lineCount = std::min(linesPerWrite, view.getHeight() - line);
+            if(!writeBitmapCollorBuffer(outputFile, view, bytePerPixel, line, lineCount, staging, threadCount)) {
+                KAF_LOG_ERROR("Failed to write color buffer at line %zu", line);
                 outputFile.close();
                 return false;
             }
+            if(!monitor.advance(lineCount, lineCount * info.lineStride())){
+                // 中断した場合は書きかけのファイルを残しません
+                KAF_LOG_INFO("BMP save aborted at line %zu: %s", line + lineCount, outputFilePath.c_str());
+                outputFile.close();
+                std::error_code error;
+                std::filesystem::remove(filePath, error);
+                return false;
+            }
         }
         outputFile.close();
-        fprintf(stderr, "Successfully saved BMP file: %s\n", outputFilePath.c_str());
+        if(outputFile.fail()){
+            KAF_LOG_ERROR("Failed to flush BMP file: %s", outputFilePath.c_str());
+            return false;
+        }
+        monitor.finish();
+        KAF_LOG_INFO("Successfully saved BMP file: %s", outputFilePath.c_str());
         return true;
     }
 
-    bool BMP::readBitmapFileHeader(std::ifstream& infStream)const{
-        char header[14];
-        infStream.read(header, FILEHEADER_SIZE);
-        fprintf(stderr, "BMP Header(%d & %d): %d | %d\n",'B', 'M', header[0], header[1]);
-        if(header[0] != 'B' || header[1] != 'M'){
-            // Not a valid BMP file
+    template<class P>
+    bool BasicBMP<P>::probe(const std::string& inputFilePath, BitmapInfo& info){
+        std::ifstream inputFile;
+        // 読み取りはヘッダの 1 回のみのため、ストリームのバッファ確保を省きます
+        inputFile.rdbuf()->pubsetbuf(nullptr, 0);
+        inputFile.open(std::filesystem::path(inputFilePath).c_str(), std::ios::binary);
+        if(!inputFile.is_open()){
+            return false;
+        }
+        unsigned char header[BITMAP_FILEHEADER_SIZE + BITMAP_INFOHEADER_SIZE];
+        if(!inputFile.read(reinterpret_cast<char*>(header), sizeof(header))){
             return false;
         }
+        BitmapInfo probed;
+        if(!parseBitmapFileHeader(header, probed) || !decodeBitmapInfoHeader(header + BITMAP_FILEHEADER_SIZE, probed)){
+            return false;
+        }
+        info = probed;
         return true;
     }
-    bool BMP::writeBitmapFileHeader(std::ofstream& outfStream, const size_t& bytePerPixel)const{
-        char header[14];
-        header[0] = 'B';
-        header[1] = 'M';
-        std::uint32_t* fileSize = reinterpret_cast<std::uint32_t*>(&header[2]);
-        *fileSize = FILEHEADER_SIZE + INFOHEADER_SIZE + getPixelBuffer()->size_ * bytePerPixel;
-        std::uint16_t* reserved = reinterpret_cast<std::uint16_t*>(&header[6]);
-        *reserved = 0;
-        std::uint16_t* reserved2 = reinterpret_cast<std::uint16_t*>(&header[8]);
-        *reserved2 = 0;
-        std::uint32_t* offset = reinterpret_cast<std::uint32_t*>(&header[10]);
-        *offset = FILEHEADER_SIZE + INFOHEADER_SIZE;
-        outfStream.write(header, FILEHEADER_SIZE);
-        return true;
+
+    template<class P>
+    bool BasicBMP<P>::readBitmapFileHeader(std::ifstream& infStream, BitmapInfo& info)const{
+        unsigned char header[BITMAP_FILEHEADER_SIZE];
+        if(!infStream.read(reinterpret_cast<char*>(header), BITMAP_FILEHEADER_SIZE)){
+            return false;
+        }
+        return parseBitmapFileHeader(header, info);
     }
-    bool BMP::writeBitmapInfoHeader(std::ofstream& outfStream, const size_t& bytePerPixel)const{
-        char header[40];
-        std::uint32_t* infoSize = reinterpret_cast<std::uint32_t*>(&header[0]);
-        *infoSize = static_cast<std::uint32_t>(INFOHEADER_SIZE);
-        std::uint32_t* width = reinterpret_cast<std::uint32_t*>(&header[4]);
-        *width = static_cast<std::uint32_t>(getWidth());
-        std::uint32_t* height = reinterpret_cast<std::uint32_t*>(&header[8]);
-        *height = static_cast<std::uint32_t>(getHeight());
-        std::uint16_t* planes = reinterpret_cast<std::uint16_t*>(&header[12]);
-        *planes = 1;
-        std::uint16_t* bitsPerPixel = reinterpret_cast<std::uint16_t*>(&header[14]);
-        *bitsPerPixel = static_cast<std::uint16_t>(bytePerPixel * 8);
-        std::uint32_t* compression = reinterpret_cast<std::uint32_t*>(&header[16]);
-        *compression = BI_RGB;
-        std::uint32_t* imageSize = reinterpret_cast<std::uint32_t*>(&header[20]);
-        *imageSize = getPixelBuffer()->size_ * bytePerPixel;
-        std::uint32_t* xPixelsPerMeter = reinterpret_cast<std::uint32_t*>(&header[24]);
-        *xPixelsPerMeter = 0;
-        std::uint32_t* yPixelsPerMeter = reinterpret_cast<std::uint32_t*>(&header[28]);
-        *yPixelsPerMeter = 0;
-        std::uint32_t* colorsUsed = reinterpret_cast<std::uint32_t*>(&header[32]);
-        *colorsUsed = 0;
-        std::uint32_t* colorsImportant = reinterpret_cast<std::uint32_t*>(&header[36]);
-        *colorsImportant = 0;
-        outfStream.write(header, INFOHEADER_SIZE);
-        return true;
+    template<class P>
+    bool BasicBMP<P>::writeBitmapFileHeader(std::ofstream& outfStream, const BitmapInfo& info){
+        unsigned char header[BITMAP_FILEHEADER_SIZE];
+        serializeBitmapFileHeader(info, header);
+        return static_cast<bool>(outfStream.write(reinterpret_cast<const char*>(header), BITMAP_FILEHEADER_SIZE));
+    }
+    template<class P>
+    bool BasicBMP<P>::writeBitmapInfoHeader(std::ofstream& outfStream, const BitmapInfo& info){
+        unsigned char infoHeader[BITMAP_INFOHEADER_SIZE];
+        serializeBitmapInfoHeader(info, infoHeader);
+        return static_cast<bool>(outfStream.write(reinterpret_cast<const char*>(infoHeader), BITMAP_INFOHEADER_SIZE));
     }
-    bool BMP::writeBitmapCollorBuffer(std::ofstream& outfStream, const size_t& bytePerPixel, size_t lineNumber)const{
-        size_t verticalPos = getHeight() - lineNumber - 1;
-        fprintf(stderr, "writing line %zu (vertical pos %zu)\n", lineNumber, verticalPos);
-        for(size_t col = 0; col < getWidth(); ++col){
-            const domain::graphics2d::Pixel* pixel = kaf::domain::graphics2d::Image::getPixel(col, verticalPos);
-            char bgr[4] = {0};
-            bgr[0] = static_cast<unsigned char>(pixel->b_ * 255.0f);
-            bgr[1] = static_cast<unsigned char>(pixel->g_ * 255.0f);
-            bgr[2] = static_cast<unsigned char>(pixel->r_ * 255.0f);
-            bgr[3] = static_cast<unsigned char>(pixel->a_ * 255.0f);
-            fprintf(stderr, "Pixel[%zu,%zu]: R=%x, G=%x, B=%x\n", col, verticalPos, static_cast<unsigned char>(bgr[2]), static_cast<unsigned char>(bgr[1]), static_cast<unsigned char>(bgr[0]));
-            outfStream.write(bgr, bytePerPixel);
-        }
-        // Skip padding bytes
-        size_t paddingSize =floor((bytePerPixel * getWidth() + 3)/4) * 4 - (bytePerPixel * getWidth());
-        if(paddingSize == 0) return true;
-        char* paddingData = new char[paddingSize];
-        fprintf(stderr, "Writing %zu padding bytes\n", paddingSize);
-        std::fill_n(paddingData, paddingSize, 0);
-        outfStream.write(paddingData, paddingSize);
-        delete[] paddingData;
+    template<class P>
+    bool BasicBMP<P>::writeBitmapCollorBuffer(std::ofstream& outfStream, const ConstViewType& view, const size_t& bytePerPixel, size_t lineNumber, size_t lineCount, std::vector<unsigned char>& staging, const size_t threadCount){
+        if(lineNumber >= view.getHeight() ||
+            lineCount == 0 || lineCount > view.getHeight() - lineNumber ||
+            bytePerPixel < 3 || bytePerPixel > 4){
+            return false;
+        }
+        const size_t stride = bitmapLineStride(bytePerPixel, view.getWidth());
+        const size_t writeSize = stride * lineCount;
+        if(staging.size() < writeSize){
+            // パディング部分は 0 のまま再利用されるため、拡張時のみ初期化されます
+            staging.resize(writeSize, 0);
+        }
+        const bool result = forEachLineBand(lineCount, threadCount, [&](const size_t begin, const size_t end){
+            return encodeBitmapCollorBuffer(view, staging.data() + begin * stride, bytePerPixel, lineNumber + begin, end - begin);
+        });
+        if(!result){
+            return false;
+        }
+        KAF_LOG_TRACE("Writing %zu lines from line %zu (%zu bytes)", lineCount, lineNumber, writeSize);
+        return static_cast<bool>(outfStream.write(reinterpret_cast<const char*>(staging.data()), static_cast<std::streamsize>(writeSize)));
+    }
+
+    template<class P>
+    bool BasicBMP<P>::encodeBitmapCollorBuffer(const ConstViewType& view, unsigned char* destination, const size_t& bytePerPixel, size_t lineNumber, size_t lineCount){
+        if(!view.isValid() ||
+            lineNumber >= view.getHeight() ||
+            lineCount == 0 || lineCount > view.getHeight() - lineNumber ||
+            bytePerPixel < 3 || bytePerPixel > 4){
+            return false;
+        }
+        const size_t stride = bitmapLineStride(bytePerPixel, view.getWidth());
+        for(size_t idx = 0; idx < lineCount; ++idx){
+            const size_t verticalPos = view.getHeight() - (lineNumber + idx) - 1;
+            encodeBitmapLine(view.rowData(verticalPos), bytePerPixel, destination + idx * stride, view.getWidth());
+        }
         return true;
     }
 
+    template<class P>
+    bool BasicBMP<P>::readBitmapInfoHeader(std::ifstream& infStream, BitmapInfo& info){
+        unsigned char infoHeader[BITMAP_INFOHEADER_SIZE];
+        if(!infStream.read(reinterpret_cast<char*>(infoHeader), BITMAP_INFOHEADER_SIZE)){
+            return false;
+        }
+        if(!parseBitmapInfoHeader(infoHeader, info)){
+            return false;
+        }
+        setWidth(info.width_);
+        setHeight(info.height_);
+        return true;
+    }
 
-    bool BMP::readBitmapInfoHeader(std::ifstream& infStream, std::uint16_t& bitsPerPixel){
-        char infoHeader[40];
-        infStream.read(infoHeader, INFOHEADER_SIZE);
-        std::uint32_t width = *reinterpret_cast<std::uint32_t*>(&infoHeader[4]);
-        std::uint32_t height = *reinterpret_cast<std::uint32_t*>(&infoHeader[8]);
-        fprintf(stderr, "BMP InfoHeader: width=%u, height=%u\n", width, height);
-        if(width == 0 || height == 0){
+    template<class P>
+    bool BasicBMP<P>::readBitmapCollorBuffer(std::ifstream& infStream, const size_t& bytePerPixel, size_t lineNumber, size_t lineCount, std::vector<unsigned char>& staging){
+        if(lineNumber >= getHeight() ||
+            lineCount == 0 || lineCount > getHeight() - lineNumber ||
+            bytePerPixel < 3 || bytePerPixel >4){
             return false;
         }
-        bitsPerPixel = *reinterpret_cast<std::uint16_t*>(&infoHeader[14]);
-        fprintf(stderr, "BMP BitsPerPixel: %u\n", bitsPerPixel);
-        if(bitsPerPixel != 24 && bitsPerPixel !=32){
+        const size_t stride = bitmapLineStride(bytePerPixel, getWidth());
+        const size_t readSize = stride * lineCount;
+        if(staging.size() < readSize){
+            staging.resize(readSize);
+        }
+        KAF_LOG_TRACE("Reading %zu lines from line %zu (%zu bytes)", lineCount, lineNumber, readSize);
+        infStream.read(reinterpret_cast<char*>(staging.data()), static_cast<std::streamsize>(readSize));
+        if(static_cast<size_t>(infStream.gcount()) != readSize){
             return false;
         }
-        std::uint32_t compression = *reinterpret_cast<std::uint32_t*>(&infoHeader[16]);
-        fprintf(stderr, "BMP Compression: %u\n", compression);
-        if(compression != 0){
+        return decodeBitmapCollorBuffer(staging.data(), bytePerPixel, lineNumber, lineCount);
+    }
+
+    template<class P>
+    bool BasicBMP<P>::decodeBitmapCollorBuffer(const unsigned char* source, const size_t& bytePerPixel, size_t lineNumber, size_t lineCount){
+        if(getPixelBuffer() == nullptr || !isValid() ||
+            lineNumber >= getHeight() ||
+            lineCount == 0 || lineCount > getHeight() - lineNumber ||
+            bytePerPixel < 3 || bytePerPixel >4){
             return false;
         }
-        setWidth(static_cast<size_t>(width));
-        setHeight(static_cast<size_t>(height));
+        const size_t stride = bitmapLineStride(bytePerPixel, getWidth());
+        P* pixels = getPixelBuffer()->pixels_.get();
+        for(size_t idx = 0; idx < lineCount; ++idx){
+            const size_t verticalPos = getHeight() - (lineNumber + idx) - 1;
+            decodeBitmapLine(source + idx * stride, bytePerPixel, pixels + verticalPos * getWidth(), getWidth());
+        }
         return true;
     }
 
-    bool BMP::readBitmapCollorBuffer(std::ifstream& infStream, const size_t& bytePerPixel, size_t lineNumber){
-        if(!getPixelBuffer()->isValid() || 
-            lineNumber >= getHeight() || 
-            bytePerPixel < 3 || bytePerPixel >4 || 
-            getWidth() * bytePerPixel+1 > getPixelBuffer()->size_){
-            return false;
-        }
-        size_t verticalPos = getHeight() - lineNumber - 1;
-        fprintf(stderr, "Reading line %zu (vertical pos %zu)\n", lineNumber, verticalPos);
-        for(size_t col = 0; col < getWidth(); ++col){
-            char bgr[4] = {0};
-            infStream.read(bgr, bytePerPixel);
-            domain::graphics2d::Pixel pixel;
-            pixel.b_ = static_cast<float>(static_cast<unsigned char>(bgr[0])) / 255.0f;
-            pixel.g_ = static_cast<float>(static_cast<unsigned char>(bgr[1])) / 255.0f;
-            pixel.r_ = static_cast<float>(static_cast<unsigned char>(bgr[2])) / 255.0f;
-            fprintf(stderr, "Pixel[%zu,%zu]: R=%f, G=%f, B=%f\n", col, verticalPos, pixel.r_, pixel.g_, pixel.b_);
-            size_t pos = verticalPos * getWidth() + col;
-            domain::graphics2d::setPixel(*getPixelBuffer(), pixel, pos);
-        }
-        // Skip padding bytes
-        size_t paddingSize =floor((bytePerPixel * getWidth() + 3)/4) * 4 - (bytePerPixel * getWidth());
-        if(paddingSize == 0) return true;
-        fprintf(stderr, "Skipping %zu padding bytes\n", paddingSize);
-        infStream.ignore(paddingSize);
-            return true;
-    }
+    template class BasicBMP<domain::graphics2d::Pixel>;
+    template class BasicBMP<domain::graphics2d::RGBA8>;
+    template class BasicBMP<domain::graphics2d::BGRA8>;
+    template class BasicBMP<domain::graphics2d::BGR8>;
+    template class BasicBMP<domain::graphics2d::Gray8>;
 }
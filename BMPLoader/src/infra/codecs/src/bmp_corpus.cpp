@@ -0,0 +1,177 @@
+/**
+ * @file bmp_corpus.cpp
+ * @brief 合成 BMP コーパス生成の実装。
+ */
+#include "../include/bmp_corpus.hpp"
+#include "../include/bmp.hpp"
+#include "../include/bmp_header.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+
+#include "../../../domain/common/include/log.hpp"
+#include "../../../domain/common/include/thread_pool.hpp"
+#include "../../../domain/graphics2d/include/parallel.hpp"
+#include "../../../domain/graphics2d/include/pixel_format.hpp"
+
+namespace kaf::infra::codecs{
+    namespace {
+        std::uint64_t splitMix64(std::uint64_t value){
+            value += 0x9E3779B97F4A7C15ull;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+
+        std::uint64_t specSeed(const size_t width, const size_t height, const std::uint16_t bitsPerPixel){
+            return splitMix64(splitMix64(static_cast<std::uint64_t>(width)) ^ (static_cast<std::uint64_t>(height) << 20) ^ bitsPerPixel);
+        }
+
+        /**
+         * @brief 1 行分のピクセル値の列（行ごとに独立した xorshift64*）。
+         * @details 行の種を seed と Y 座標から決めるため、行をどの順・どのスレッドで埋めても結果は同じです。
+         */
+        class RowNoise{
+        public:
+            RowNoise(const std::uint64_t seed, const size_t y): state_(splitMix64(seed ^ splitMix64(y)) | 1u){}
+
+            std::uint64_t next(){
+                state_ ^= state_ >> 12;
+                state_ ^= state_ << 25;
+                state_ ^= state_ >> 27;
+                return state_ * 0x2545F4914F6CDD1Dull;
+            }
+
+        private:
+            std::uint64_t state_;
+        };
+
+        /** @brief 横方向のグラデーションにノイズを重ねた値（実画像に近い、単調でない内容にする）。 */
+        std::uint8_t gradient(const size_t position, const size_t extent, const std::uint64_t noise){
+            const size_t base = extent > 1 ? position * 192 / (extent - 1) : 0;
+            return static_cast<std::uint8_t>(base + (noise & 0x3F));
+        }
+
+        void fillPixel(domain::graphics2d::BGR8& pixel, const size_t x, const size_t y, const size_t width, const size_t height, const std::uint64_t noise){
+            pixel.b_ = gradient(x, width, noise);
+            pixel.g_ = gradient(y, height, noise >> 8);
+            pixel.r_ = static_cast<std::uint8_t>(noise >> 16);
+        }
+
+        void fillPixel(domain::graphics2d::BGRA8& pixel, const size_t x, const size_t y, const size_t width, const size_t height, const std::uint64_t noise){
+            pixel.b_ = gradient(x, width, noise);
+            pixel.g_ = gradient(y, height, noise >> 8);
+            pixel.r_ = static_cast<std::uint8_t>(noise >> 16);
+            pixel.a_ = static_cast<std::uint8_t>(noise >> 24);
+        }
+
+        template<class P>
+        bool writeCorpusImage(const CorpusImageSpec& spec, const std::filesystem::path& path, const size_t threadCount){
+            const auto pixelCount = domain::graphics2d::mul_size(spec.width_, spec.height_);
+            if(!pixelCount || *pixelCount == 0){
+                return false;
+            }
+            BasicBMP<P> bmp;
+            bmp.setPixelBuffer(std::make_unique<domain::graphics2d::BasicPixelBuffer<P>>(*pixelCount, domain::graphics2d::UNINITIALIZED));
+            bmp.setWidth(spec.width_);
+            bmp.setHeight(spec.height_);
+            auto fillRow = [&spec](const auto row, const size_t y){
+                RowNoise noise(spec.seed_, y);
+                for(size_t x = 0; x < row.size(); ++x){
+                    fillPixel(row[x], x, y, spec.width_, spec.height_, noise.next());
+                }
+            };
+            const auto view = domain::graphics2d::makeView(static_cast<domain::graphics2d::BasicImage<P>&>(bmp));
+            if(threadCount == 1){
+                for(size_t y = 0; y < spec.height_; ++y){
+                    fillRow(view.row(y), y);
+                }
+            } else {
+                domain::graphics2d::parallelForRows(view, fillRow);
+            }
+            CodecOptions options;
+            options.threadCount_ = threadCount;
+            return bmp.saveImage(path.string(), spec.bitsPerPixel_, options);
+        }
+    }
+
+    std::uintmax_t corpusFileSize(const CorpusImageSpec& spec){
+        const std::uintmax_t stride = bitmapLineStride(spec.bitsPerPixel_ / 8u, spec.width_);
+        return BITMAP_FILEHEADER_SIZE + BITMAP_INFOHEADER_SIZE + stride * spec.height_;
+    }
+
+    std::string corpusFileName(const CorpusImageSpec& spec){
+        return spec.category_ + "_" + std::to_string(spec.width_) + "x" + std::to_string(spec.height_) + "_" +
+            std::to_string(spec.bitsPerPixel_) + "bpp.bmp";
+    }
+
+    std::vector<CorpusImageSpec> defaultCorpusSpecs(const std::uintmax_t maxFileBytes){
+        struct Size{
+            const char* category_;
+            size_t width_;
+            size_t height_;
+        };
+        static constexpr Size SIZES[] = {
+            // 24bpp の行パディング 0〜3 バイトをすべて含む（幅 mod 4 の 4 通り、小さい幅と大きい幅）
+            {"padding", 1, 33}, {"padding", 2, 33}, {"padding", 3, 33}, {"padding", 4, 33},
+            {"padding", 5, 33}, {"padding", 6, 33}, {"padding", 7, 33}, {"padding", 8, 33},
+            {"padding", 1021, 33}, {"padding", 1022, 33}, {"padding", 1023, 33}, {"padding", 1024, 33},
+            // 極端な縦横比（1 行だけ、1 列だけなど）
+            {"aspect", 16384, 1}, {"aspect", 1, 16384}, {"aspect", 65535, 3}, {"aspect", 3, 65535}, {"aspect", 8191, 2},
+            // サムネイルから数 GB まで（32767 x 32767 は 32bpp で約 4 GiB）
+            {"size", 64, 64}, {"size", 160, 120}, {"size", 640, 480}, {"size", 1920, 1080}, {"size", 3840, 2160},
+            {"size", 7680, 4320}, {"size", 16384, 16384}, {"size", 23170, 23170}, {"size", 32767, 32767},
+        };
+        std::vector<CorpusImageSpec> specs;
+        for(const Size& size : SIZES){
+            for(const std::uint16_t bitsPerPixel : {std::uint16_t{24}, std::uint16_t{32}}){
+                CorpusImageSpec spec{size.category_, size.width_, size.height_, bitsPerPixel, specSeed(size.width_, size.height_, bitsPerPixel)};
+                if(corpusFileSize(spec) <= maxFileBytes){
+                    specs.push_back(std::move(spec));
+                }
+            }
+        }
+        std::stable_sort(specs.begin(), specs.end(), [](const CorpusImageSpec& lhs, const CorpusImageSpec& rhs){
+            return corpusFileSize(lhs) < corpusFileSize(rhs);
+        });
+        return specs;
+    }
+
+    bool generateCorpus(const std::string& directoryPath, const std::vector<CorpusImageSpec>& specs,
+        std::vector<CorpusEntry>& entries, const size_t threadCount){
+        entries.clear();
+        std::error_code error;
+        const std::filesystem::path directory(directoryPath);
+        std::filesystem::create_directories(directory, error);
+        if(error){
+            KAF_LOG_ERROR("Failed to create corpus directory: %s", directoryPath.c_str());
+            return false;
+        }
+        for(const CorpusImageSpec& spec : specs){
+            CorpusEntry entry{spec, (directory / corpusFileName(spec)).generic_string(), corpusFileSize(spec), false};
+            const std::filesystem::path path(entry.path_);
+            // 内容は仕様から一意に決まるので、サイズが一致する既存ファイルはそのまま使う
+            if(std::filesystem::file_size(path, error) == entry.fileSize_ && !error){
+                entries.push_back(std::move(entry));
+                continue;
+            }
+            std::filesystem::remove(path, error);
+            bool result = false;
+            if(spec.bitsPerPixel_ == 24){
+                result = writeCorpusImage<domain::graphics2d::BGR8>(spec, path, threadCount);
+            } else if(spec.bitsPerPixel_ == 32){
+                result = writeCorpusImage<domain::graphics2d::BGRA8>(spec, path, threadCount);
+            }
+            if(!result){
+                KAF_LOG_ERROR("Failed to generate corpus image: %s", entry.path_.c_str());
+                return false;
+            }
+            entry.generated_ = true;
+            entries.push_back(std::move(entry));
+        }
+        KAF_LOG_INFO("Corpus ready: %zu images in %s", entries.size(), directoryPath.c_str());
+        return true;
+    }
+}
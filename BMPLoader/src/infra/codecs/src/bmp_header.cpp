@@ -0,0 +1,113 @@
+/**
+ * @file bmp_header.cpp
+ * @brief BMP ヘッダ解析の実装。
+ */
+#include "../include/bmp_header.hpp"
+#include "../../../domain/common/include/log.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace kaf::infra::codecs{
+    namespace {
+        std::uint16_t readUint16(const unsigned char* data){
+            return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+        }
+        std::uint32_t readUint32(const unsigned char* data){
+            return static_cast<std::uint32_t>(data[0]) |
+                (static_cast<std::uint32_t>(data[1]) << 8) |
+                (static_cast<std::uint32_t>(data[2]) << 16) |
+                (static_cast<std::uint32_t>(data[3]) << 24);
+        }
+        void writeUint16(unsigned char* data, const std::uint16_t value){
+            data[0] = static_cast<unsigned char>(value & 0xFF);
+            data[1] = static_cast<unsigned char>(value >> 8);
+        }
+        void writeUint32(unsigned char* data, const std::uint32_t value){
+            writeUint16(data, static_cast<std::uint16_t>(value & 0xFFFF));
+            writeUint16(data + 2, static_cast<std::uint16_t>(value >> 16));
+        }
+        /** @brief ピクセル配列のバイト数（32bit に収まらなければ 0）。 */
+        std::uint32_t pixelArraySize(const BitmapInfo& info){
+            const size_t stride = info.lineStride();
+            if(info.height_ != 0 && stride > std::numeric_limits<std::uint32_t>::max() / info.height_){
+                return 0;
+            }
+            return static_cast<std::uint32_t>(stride * info.height_);
+        }
+    }
+
+    bool parseBitmapFileHeader(const unsigned char* header, BitmapInfo& info){
+        KAF_LOG_DEBUG("BMP Header(%d & %d): %d | %d",'B', 'M', header[0], header[1]);
+        if(header[0] != 'B' || header[1] != 'M'){
+            // Not a valid BMP file
+            return false;
+        }
+        info.pixelOffset_ = readUint32(&header[10]);
+        if(info.pixelOffset_ < BITMAP_FILEHEADER_SIZE + BITMAP_INFOHEADER_SIZE){
+            return false;
+        }
+        return true;
+    }
+
+    bool decodeBitmapInfoHeader(const unsigned char* infoHeader, BitmapInfo& info){
+        const std::int32_t width = static_cast<std::int32_t>(readUint32(&infoHeader[4]));
+        const std::int32_t height = static_cast<std::int32_t>(readUint32(&infoHeader[8]));
+        KAF_LOG_DEBUG("BMP InfoHeader: width=%d, height=%d", width, height);
+        if(width <= 0 || height == 0 || height == std::numeric_limits<std::int32_t>::min()){
+            return false;
+        }
+        info.width_ = static_cast<size_t>(width);
+        info.height_ = static_cast<size_t>(height < 0 ? -height : height);
+        info.topDown_ = height < 0;
+        info.bitsPerPixel_ = readUint16(&infoHeader[14]);
+        info.compression_ = readUint32(&infoHeader[16]);
+        KAF_LOG_DEBUG("BMP BitsPerPixel: %u", static_cast<unsigned int>(info.bitsPerPixel_));
+        KAF_LOG_DEBUG("BMP Compression: %u", info.compression_);
+        return true;
+    }
+
+    bool isSupportedBitmap(const BitmapInfo& info){
+        if(info.width_ == 0 || info.height_ == 0){
+            return false;
+        }
+        if(info.bitsPerPixel_ != 24 && info.bitsPerPixel_ != 32){
+            return false;
+        }
+        if(info.compression_ != 0){
+            return false;
+        }
+        // トップダウン BMP の読み込みは未対応
+        return !info.topDown_;
+    }
+
+    bool parseBitmapInfoHeader(const unsigned char* infoHeader, BitmapInfo& info){
+        BitmapInfo decoded = info;
+        if(!decodeBitmapInfoHeader(infoHeader, decoded) || !isSupportedBitmap(decoded)){
+            return false;
+        }
+        info = decoded;
+        return true;
+    }
+
+    void serializeBitmapFileHeader(const BitmapInfo& info, unsigned char* header){
+        std::memset(header, 0, BITMAP_FILEHEADER_SIZE);
+        header[0] = 'B';
+        header[1] = 'M';
+        const std::uint32_t imageSize = pixelArraySize(info);
+        const std::uint64_t fileSize = static_cast<std::uint64_t>(info.pixelOffset_) + imageSize;
+        writeUint32(&header[2], (imageSize == 0 || fileSize > std::numeric_limits<std::uint32_t>::max()) ? 0 : static_cast<std::uint32_t>(fileSize));
+        writeUint32(&header[10], info.pixelOffset_);
+    }
+
+    void serializeBitmapInfoHeader(const BitmapInfo& info, unsigned char* infoHeader){
+        std::memset(infoHeader, 0, BITMAP_INFOHEADER_SIZE);
+        writeUint32(&infoHeader[0], static_cast<std::uint32_t>(BITMAP_INFOHEADER_SIZE));
+        writeUint32(&infoHeader[4], static_cast<std::uint32_t>(info.width_));
+        writeUint32(&infoHeader[8], static_cast<std::uint32_t>(info.height_));
+        writeUint16(&infoHeader[12], 1);
+        writeUint16(&infoHeader[14], info.bitsPerPixel_);
+        writeUint32(&infoHeader[16], info.compression_);
+        writeUint32(&infoHeader[20], pixelArraySize(info));
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ * @file bmp_index.cpp
+ * @brief BMP 索引作成の実装。
+ */
+#include "../include/bmp_index.hpp"
+#include "../include/bmp.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <system_error>
+
+#include "../../../domain/common/include/log.hpp"
+#include "../../../domain/common/include/thread_pool.hpp"
+
+namespace kaf::infra::codecs{
+    namespace {
+        /** @brief 1 スレッドが一度に取得するファイル数。 */
+        constexpr size_t SCAN_CHUNK_SIZE = 32;
+
+        bool hasBitmapExtension(const std::filesystem::path& path){
+            std::string extension = path.extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+            return extension == ".bmp" || extension == ".dib";
+        }
+
+        template<class Iterator>
+        void collectBitmapFiles(Iterator iterator, std::vector<BitmapIndexEntry>& entries){
+            std::error_code error;
+            for(const Iterator end{}; iterator != end; iterator.increment(error)){
+                if(error){
+                    KAF_LOG_WARNING("Failed to iterate directory: %s", error.message().c_str());
+                    break;
+                }
+                const auto& entry = *iterator;
+                if(!entry.is_regular_file(error) || !hasBitmapExtension(entry.path())){
+                    continue;
+                }
+                BitmapIndexEntry indexEntry;
+                indexEntry.path_ = entry.path().generic_string();
+                entries.push_back(std::move(indexEntry));
+            }
+        }
+
+        void probeEntry(BitmapIndexEntry& entry){
+            std::error_code error;
+            entry.fileSize_ = std::filesystem::file_size(std::filesystem::path(entry.path_), error);
+            if(error){
+                entry.fileSize_ = 0;
+            }
+            entry.valid_ = BMP::probe(entry.path_, entry.info_);
+        }
+
+        void writeBytes(std::ostream& output, std::uint64_t value, const size_t byteCount){
+            char bytes[8];
+            for(size_t idx = 0; idx < byteCount; ++idx){
+                bytes[idx] = static_cast<char>((value >> (idx * 8)) & 0xFF);
+            }
+            output.write(bytes, static_cast<std::streamsize>(byteCount));
+        }
+
+        void writeCsvField(std::ostream& output, const std::string& field){
+            if(field.find_first_of(",\"\r\n") == std::string::npos){
+                output << field;
+                return;
+            }
+            output << '"';
+            for(const char c : field){
+                if(c == '"'){
+                    output << '"';
+                }
+                output << c;
+            }
+            output << '"';
+        }
+    }
+
+    std::vector<BitmapIndexEntry> scanBitmapDirectory(const std::string& directoryPath, const size_t threadCount, const bool recursive){
+        std::vector<BitmapIndexEntry> entries;
+        std::error_code error;
+        const auto options = std::filesystem::directory_options::skip_permission_denied;
+        if(recursive){
+            collectBitmapFiles(std::filesystem::recursive_directory_iterator(directoryPath, options, error), entries);
+        } else {
+            collectBitmapFiles(std::filesystem::directory_iterator(directoryPath, options, error), entries);
+        }
+        if(error){
+            KAF_LOG_ERROR("Failed to open directory: %s", directoryPath.c_str());
+            return {};
+        }
+        std::sort(entries.begin(), entries.end(), [](const BitmapIndexEntry& lhs, const BitmapIndexEntry& rhs){ return lhs.path_ < rhs.path_; });
+
+        const size_t chunkCount = (entries.size() + SCAN_CHUNK_SIZE - 1) / SCAN_CHUNK_SIZE;
+        auto probeChunks = [&entries](const size_t begin, const size_t end){
+            for(size_t idx = begin * SCAN_CHUNK_SIZE; idx < std::min(end * SCAN_CHUNK_SIZE, entries.size()); ++idx){
+                probeEntry(entries[idx]);
+            }
+        };
+        if(threadCount == 1){
+            probeChunks(0, chunkCount);
+        } else {
+            // チャンクは空いているスレッドが順に取得する
+            domain::common::ThreadPool::shared().parallelFor(0, chunkCount, 1, probeChunks);
+        }
+        KAF_LOG_INFO("Scanned %zu BMP files in %s", entries.size(), directoryPath.c_str());
+        return entries;
+    }
+
+    bool writeBitmapIndexCsv(const std::vector<BitmapIndexEntry>& entries, std::ostream& output){
+        output << "path,file_size,valid,supported,width,height,bits_per_pixel,compression,orientation\n";
+        for(const auto& entry : entries){
+            writeCsvField(output, entry.path_);
+            output << ',' << entry.fileSize_ << ',' << (entry.valid_ ? 1 : 0);
+            if(entry.valid_){
+                output << ',' << (isSupportedBitmap(entry.info_) ? 1 : 0)
+                    << ',' << entry.info_.width_
+                    << ',' << entry.info_.height_
+                    << ',' << entry.info_.bitsPerPixel_
+                    << ',' << entry.info_.compression_
+                    << ',' << (entry.info_.topDown_ ? "top-down" : "bottom-up");
+            } else {
+                output << ",0,,,,,";
+            }
+            output << '\n';
+        }
+        return static_cast<bool>(output);
+    }
+
+    bool writeBitmapIndexBinary(const std::vector<BitmapIndexEntry>& entries, std::ostream& output){
+        output.write("KBIX", 4);
+        writeBytes(output, 1, 4);
+        writeBytes(output, entries.size(), 8);
+        for(const auto& entry : entries){
+            writeBytes(output, entry.path_.size(), 4);
+            output.write(entry.path_.data(), static_cast<std::streamsize>(entry.path_.size()));
+            writeBytes(output, entry.fileSize_, 8);
+            writeBytes(output, entry.info_.width_, 4);
+            writeBytes(output, entry.info_.height_, 4);
+            writeBytes(output, entry.info_.bitsPerPixel_, 2);
+            writeBytes(output, entry.info_.compression_, 4);
+            std::uint8_t flags = 0;
+            if(entry.valid_){
+                flags |= 0x01;
+                if(isSupportedBitmap(entry.info_)){
+                    flags |= 0x02;
+                }
+                if(entry.info_.topDown_){
+                    flags |= 0x04;
+                }
+            }
+            writeBytes(output, flags, 1);
+        }
+        return static_cast<bool>(output);
+    }
+}
@@ -0,0 +1,128 @@
+/**
+ * @file bmp_line_codec.cpp
+ * @brief BMP 行変換の実装。
+ */
+#include "../include/bmp_line_codec.hpp"
+#include "../../../domain/graphics2d/include/pixel_convert.hpp"
+
+#include <cstring>
+
+namespace kaf::infra::codecs{
+    namespace {
+        using domain::graphics2d::Pixel;
+        using domain::graphics2d::RGBA8;
+        using domain::graphics2d::BGRA8;
+        using domain::graphics2d::BGR8;
+        using domain::graphics2d::Gray8;
+
+        void decodeLine(const unsigned char* source, const size_t bytePerPixel, Pixel* destination, const size_t width){
+            if(bytePerPixel == 4){
+                domain::graphics2d::convertBgrx8ToPixel(source, destination, width);
+            }
+            else{
+                domain::graphics2d::convertBgr8ToPixel(source, destination, width);
+            }
+        }
+        void decodeLine(const unsigned char* source, const size_t bytePerPixel, RGBA8* destination, const size_t width){
+            for(size_t col = 0; col < width; ++col, source += bytePerPixel){
+                destination[col] = RGBA8{source[2], source[1], source[0], bytePerPixel == 4 ? source[3] : std::uint8_t{255}};
+            }
+        }
+        void decodeLine(const unsigned char* source, const size_t bytePerPixel, BGRA8* destination, const size_t width){
+            if(bytePerPixel == 4){
+                std::memcpy(destination, source, width * sizeof(BGRA8));
+                return;
+            }
+            for(size_t col = 0; col < width; ++col, source += bytePerPixel){
+                destination[col] = BGRA8{source[0], source[1], source[2], 255};
+            }
+        }
+        void decodeLine(const unsigned char* source, const size_t bytePerPixel, BGR8* destination, const size_t width){
+            if(bytePerPixel == 3){
+                std::memcpy(destination, source, width * sizeof(BGR8));
+                return;
+            }
+            for(size_t col = 0; col < width; ++col, source += bytePerPixel){
+                destination[col] = BGR8{source[0], source[1], source[2]};
+            }
+        }
+        void decodeLine(const unsigned char* source, const size_t bytePerPixel, Gray8* destination, const size_t width){
+            for(size_t col = 0; col < width; ++col, source += bytePerPixel){
+                destination[col] = Gray8{domain::graphics2d::lumaOf(source[2], source[1], source[0])};
+            }
+        }
+
+        void encodeLine(const Pixel* source, const size_t bytePerPixel, unsigned char* destination, const size_t width){
+            if(bytePerPixel == 4){
+                domain::graphics2d::convertPixelToBgra8(source, destination, width);
+            }
+            else{
+                domain::graphics2d::convertPixelToBgr8(source, destination, width);
+            }
+        }
+        void encodeLine(const RGBA8* source, const size_t bytePerPixel, unsigned char* destination, const size_t width){
+            for(size_t col = 0; col < width; ++col, destination += bytePerPixel){
+                destination[0] = source[col].b_;
+                destination[1] = source[col].g_;
+                destination[2] = source[col].r_;
+                if(bytePerPixel == 4){
+                    destination[3] = source[col].a_;
+                }
+            }
+        }
+        void encodeLine(const BGRA8* source, const size_t bytePerPixel, unsigned char* destination, const size_t width){
+            if(bytePerPixel == 4){
+                std::memcpy(destination, source, width * sizeof(BGRA8));
+                return;
+            }
+            for(size_t col = 0; col < width; ++col, destination += bytePerPixel){
+                destination[0] = source[col].b_;
+                destination[1] = source[col].g_;
+                destination[2] = source[col].r_;
+            }
+        }
+        void encodeLine(const BGR8* source, const size_t bytePerPixel, unsigned char* destination, const size_t width){
+            if(bytePerPixel == 3){
+                std::memcpy(destination, source, width * sizeof(BGR8));
+                return;
+            }
+            for(size_t col = 0; col < width; ++col, destination += bytePerPixel){
+                destination[0] = source[col].b_;
+                destination[1] = source[col].g_;
+                destination[2] = source[col].r_;
+                destination[3] = 255;
+            }
+        }
+        void encodeLine(const Gray8* source, const size_t bytePerPixel, unsigned char* destination, const size_t width){
+            for(size_t col = 0; col < width; ++col, destination += bytePerPixel){
+                destination[0] = source[col].v_;
+                destination[1] = source[col].v_;
+                destination[2] = source[col].v_;
+                if(bytePerPixel == 4){
+                    destination[3] = 255;
+                }
+            }
+        }
+    }
+
+    template<class P>
+    void decodeBitmapLine(const unsigned char* source, const size_t bytePerPixel, P* destination, const size_t width){
+        decodeLine(source, bytePerPixel, destination, width);
+    }
+
+    template<class P>
+    void encodeBitmapLine(const P* source, const size_t bytePerPixel, unsigned char* destination, const size_t width){
+        encodeLine(source, bytePerPixel, destination, width);
+    }
+
+#define KAF_INSTANTIATE_BITMAP_LINE_CODEC(P) \
+    template void decodeBitmapLine<P>(const unsigned char*, const size_t, P*, const size_t); \
+    template void encodeBitmapLine<P>(const P*, const size_t, unsigned char*, const size_t);
+
+    KAF_INSTANTIATE_BITMAP_LINE_CODEC(Pixel)
+    KAF_INSTANTIATE_BITMAP_LINE_CODEC(RGBA8)
+    KAF_INSTANTIATE_BITMAP_LINE_CODEC(BGRA8)
+    KAF_INSTANTIATE_BITMAP_LINE_CODEC(BGR8)
+    KAF_INSTANTIATE_BITMAP_LINE_CODEC(Gray8)
+#undef KAF_INSTANTIATE_BITMAP_LINE_CODEC
+}
@@ -0,0 +1,213 @@
+/**
+ * @file bmp_roundtrip.cpp
+ * @brief 往復計測と基準値比較の実装。
+ */
+#include "../include/bmp_roundtrip.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "../../../domain/common/include/log.hpp"
+
+namespace kaf::infra::codecs{
+    namespace {
+        /**
+         * @struct Metric
+         * @brief CSV と比較で扱う指標。
+         */
+        struct Metric{
+            const char* name_;
+            double (*get_)(const RoundTripReport& report);
+            void (*set_)(RoundTripReport& report, const double value);
+            /** 比較対象か、比較する場合に値が大きいほど良いか */
+            bool compared_;
+            bool higherIsBetter_;
+        };
+
+        const Metric METRICS[] = {
+            {"images", [](const RoundTripReport& r){ return static_cast<double>(r.imageCount_); },
+                [](RoundTripReport& r, const double v){ r.imageCount_ = static_cast<size_t>(v); }, false, false},
+            {"failures", [](const RoundTripReport& r){ return static_cast<double>(r.failureCount_); },
+                [](RoundTripReport& r, const double v){ r.failureCount_ = static_cast<size_t>(v); }, false, false},
+            {"bytes", [](const RoundTripReport& r){ return static_cast<double>(r.bytes_); },
+                [](RoundTripReport& r, const double v){ r.bytes_ = static_cast<std::uintmax_t>(v); }, false, false},
+            {"seconds", [](const RoundTripReport& r){ return r.seconds_; },
+                [](RoundTripReport& r, const double v){ r.seconds_ = v; }, false, false},
+            {"mb_per_second", [](const RoundTripReport& r){ return r.megabytesPerSecond_; },
+                [](RoundTripReport& r, const double v){ r.megabytesPerSecond_ = v; }, true, true},
+            {"images_per_second", [](const RoundTripReport& r){ return r.imagesPerSecond_; },
+                [](RoundTripReport& r, const double v){ r.imagesPerSecond_ = v; }, true, true},
+            {"p50_ms", [](const RoundTripReport& r){ return r.p50Milliseconds_; },
+                [](RoundTripReport& r, const double v){ r.p50Milliseconds_ = v; }, true, false},
+            {"p99_ms", [](const RoundTripReport& r){ return r.p99Milliseconds_; },
+                [](RoundTripReport& r, const double v){ r.p99Milliseconds_ = v; }, true, false},
+            {"peak_rss_bytes", [](const RoundTripReport& r){ return static_cast<double>(r.peakResidentBytes_); },
+                [](RoundTripReport& r, const double v){ r.peakResidentBytes_ = static_cast<std::uintmax_t>(v); }, true, false},
+        };
+
+        std::uintmax_t peakResidentBytes(){
+#ifdef _WIN32
+            PROCESS_MEMORY_COUNTERS counters{};
+            if(K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))){
+                return static_cast<std::uintmax_t>(counters.PeakWorkingSetSize);
+            }
+            return 0;
+#else
+            rusage usage{};
+            if(getrusage(RUSAGE_SELF, &usage) != 0){
+                return 0;
+            }
+#ifdef __APPLE__
+            return static_cast<std::uintmax_t>(usage.ru_maxrss);
+#else
+            // Linux では KiB 単位
+            return static_cast<std::uintmax_t>(usage.ru_maxrss) * 1024u;
+#endif
+#endif
+        }
+
+        /** @brief 昇順に並んだ値の percentile（0〜1）を最近傍順位法で返します。 */
+        double percentile(const std::vector<double>& sorted, const double fraction){
+            if(sorted.empty()){
+                return 0.0;
+            }
+            const size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+            return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+        }
+    }
+
+    template<class P>
+    bool runRoundTrip(const std::vector<BitmapIndexEntry>& entries, const RoundTripOptions& options, RoundTripReport& report){
+        using Clock = std::chrono::steady_clock;
+        report = RoundTripReport{};
+        std::error_code error;
+        const std::filesystem::path directory = options.outputDirectory_.empty()
+            ? std::filesystem::temp_directory_path(error) / "kaf_roundtrip"
+            : std::filesystem::path(options.outputDirectory_);
+        std::filesystem::create_directories(directory, error);
+        if(error){
+            KAF_LOG_ERROR("Failed to create round-trip directory: %s", directory.string().c_str());
+            return false;
+        }
+        const std::filesystem::path outputPath = directory / "roundtrip.bmp";
+        std::vector<double> latencies;
+        for(size_t pass = 0; pass < options.repeat_; ++pass){
+            for(const BitmapIndexEntry& entry : entries){
+                if(!entry.valid_ || !isSupportedBitmap(entry.info_)){
+                    continue;
+                }
+                std::filesystem::remove(outputPath, error);
+                const auto start = Clock::now();
+                bool result = false;
+                {
+                    BasicBMP<P> bmp;
+                    result = bmp.loadImage(entry.path_, options.codec_) &&
+                        bmp.saveImage(outputPath.string(), entry.info_.bitsPerPixel_, options.codec_);
+                }
+                const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                if(!result){
+                    KAF_LOG_WARNING("Round trip failed: %s", entry.path_.c_str());
+                    ++report.failureCount_;
+                    continue;
+                }
+                ++report.imageCount_;
+                report.bytes_ += entry.fileSize_;
+                report.seconds_ += seconds;
+                latencies.push_back(seconds * 1000.0);
+            }
+        }
+        std::filesystem::remove(outputPath, error);
+
+        std::sort(latencies.begin(), latencies.end());
+        if(report.seconds_ > 0.0){
+            report.megabytesPerSecond_ = static_cast<double>(report.bytes_) / 1e6 / report.seconds_;
+            report.imagesPerSecond_ = static_cast<double>(report.imageCount_) / report.seconds_;
+        }
+        report.p50Milliseconds_ = percentile(latencies, 0.50);
+        report.p99Milliseconds_ = percentile(latencies, 0.99);
+        report.peakResidentBytes_ = peakResidentBytes();
+        return report.imageCount_ > 0 && report.failureCount_ == 0;
+    }
+
+    std::vector<RoundTripComparison> compareRoundTrip(const RoundTripReport& baseline, const RoundTripReport& current, const double threshold){
+        std::vector<RoundTripComparison> comparisons;
+        for(const Metric& metric : METRICS){
+            if(!metric.compared_){
+                continue;
+            }
+            RoundTripComparison comparison{metric.name_, metric.get_(baseline), metric.get_(current), 0.0, false};
+            if(comparison.baseline_ > 0.0){
+                const double ratio = (comparison.current_ - comparison.baseline_) / comparison.baseline_;
+                comparison.change_ = metric.higherIsBetter_ ? -ratio : ratio;
+                comparison.regressed_ = comparison.change_ > threshold;
+            }
+            comparisons.push_back(std::move(comparison));
+        }
+        return comparisons;
+    }
+
+    bool writeRoundTripReportCsv(const RoundTripReport& report, std::ostream& output){
+        output << "metric,value\n";
+        const auto precision = output.precision(17);
+        for(const Metric& metric : METRICS){
+            output << metric.name_ << ',' << metric.get_(report) << '\n';
+        }
+        output.precision(precision);
+        return static_cast<bool>(output);
+    }
+
+    bool readRoundTripReportCsv(std::istream& input, RoundTripReport& report){
+        std::string line;
+        if(!std::getline(input, line) || line.rfind("metric,value", 0) != 0){
+            return false;
+        }
+        RoundTripReport parsed;
+        while(std::getline(input, line)){
+            if(!line.empty() && line.back() == '\r'){
+                line.pop_back();
+            }
+            if(line.empty()){
+                continue;
+            }
+            const size_t comma = line.find(',');
+            if(comma == std::string::npos){
+                return false;
+            }
+            const std::string name = line.substr(0, comma);
+            const auto metric = std::find_if(std::begin(METRICS), std::end(METRICS), [&name](const Metric& m){ return name == m.name_; });
+            if(metric == std::end(METRICS)){
+                continue;
+            }
+            try{
+                metric->set_(parsed, std::stod(line.substr(comma + 1)));
+            } catch(const std::exception&){
+                return false;
+            }
+        }
+        report = parsed;
+        return true;
+    }
+
+    template bool runRoundTrip<domain::graphics2d::Pixel>(const std::vector<BitmapIndexEntry>&, const RoundTripOptions&, RoundTripReport&);
+    template bool runRoundTrip<domain::graphics2d::RGBA8>(const std::vector<BitmapIndexEntry>&, const RoundTripOptions&, RoundTripReport&);
+    template bool runRoundTrip<domain::graphics2d::BGRA8>(const std::vector<BitmapIndexEntry>&, const RoundTripOptions&, RoundTripReport&);
+    template bool runRoundTrip<domain::graphics2d::BGR8>(const std::vector<BitmapIndexEntry>&, const RoundTripOptions&, RoundTripReport&);
+    template bool runRoundTrip<domain::graphics2d::Gray8>(const std::vector<BitmapIndexEntry>&, const RoundTripOptions&, RoundTripReport&);
+}
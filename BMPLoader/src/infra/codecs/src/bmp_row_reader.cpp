@@ -0,0 +1,77 @@
+/**
+ * @file bmp_row_reader.cpp
+ * @brief BmpRowReader の実装。
+ */
+#include "../include/bmp_row_reader.hpp"
+#include "../include/bmp_line_codec.hpp"
+
+#include <filesystem>
+#include <system_error>
+
+#include "../../../domain/graphics2d/include/image.hpp"
+#include "../../../domain/common/include/log.hpp"
+
+namespace kaf::infra::codecs{
+    BmpRowReader::BmpRowReader() = default;
+
+    BmpRowReader::~BmpRowReader(){
+        close();
+    }
+
+    bool BmpRowReader::open(const std::string& inputFilePath){
+        close();
+        std::filesystem::path filePath(inputFilePath);
+        std::error_code error;
+        const auto fileSize = std::filesystem::file_size(filePath, error);
+        if(error) {return false;}
+        inputFile_.open(filePath.c_str(), std::ios::binary);
+        if(!inputFile_.is_open()){
+            KAF_LOG_ERROR("Failed to open input file: %s", inputFilePath.c_str());
+            return false;
+        }
+        unsigned char header[BITMAP_FILEHEADER_SIZE + BITMAP_INFOHEADER_SIZE];
+        BitmapInfo info;
+        if(!inputFile_.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+            !parseBitmapFileHeader(header, info) ||
+            !parseBitmapInfoHeader(header + BITMAP_FILEHEADER_SIZE, info)){
+            KAF_LOG_ERROR("Failed to read BMP header");
+            close();
+            return false;
+        }
+        auto pixelArraySize = domain::graphics2d::mul_size(info.lineStride(), info.height_);
+        if(!pixelArraySize.has_value() || info.pixelOffset_ > fileSize || fileSize - info.pixelOffset_ < pixelArraySize.value()){
+            KAF_LOG_ERROR("BMP pixel array is truncated");
+            close();
+            return false;
+        }
+        info_ = info;
+        staging_.resize(info_.bytePerPixel() * info_.width_);
+        return true;
+    }
+
+    void BmpRowReader::close(){
+        if(inputFile_.is_open()){
+            inputFile_.close();
+        }
+        info_ = BitmapInfo{};
+        nextLine_ = 0;
+        staging_.clear();
+    }
+
+    bool BmpRowReader::readLine(std::vector<domain::graphics2d::Pixel>& line){
+        if(!isOpen() || nextLine_ >= getHeight()){
+            return false;
+        }
+        const size_t lineNumber = getHeight() - nextLine_ - 1;
+        const std::streamoff position = static_cast<std::streamoff>(info_.pixelOffset_ + lineNumber * info_.lineStride());
+        if(!inputFile_.seekg(position) ||
+            !inputFile_.read(reinterpret_cast<char*>(staging_.data()), static_cast<std::streamsize>(staging_.size()))){
+            KAF_LOG_ERROR("Failed to read line %zu", nextLine_);
+            return false;
+        }
+        line.resize(getWidth());
+        decodeBitmapLine(staging_.data(), info_.bytePerPixel(), line.data(), getWidth());
+        ++nextLine_;
+        return true;
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * @file bmp_row_writer.cpp
+ * @brief BmpRowWriter の実装。
+ */
+#include "../include/bmp_row_writer.hpp"
+#include "../include/bmp_line_codec.hpp"
+#include "../../../domain/common/include/log.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+
+namespace kaf::infra::codecs{
+    BmpRowWriter::BmpRowWriter() = default;
+
+    BmpRowWriter::~BmpRowWriter(){
+        close();
+    }
+
+    bool BmpRowWriter::open(const std::string& outputFilePath, const size_t width, const size_t height, const size_t bitPerPixel){
+        close();
+        constexpr size_t maxExtent = static_cast<size_t>(std::numeric_limits<std::int32_t>::max());
+        if(width == 0 || height == 0 || width > maxExtent || height > maxExtent){
+            return false;
+        }
+        if(bitPerPixel != 24 && bitPerPixel != 32){
+            return false;
+        }
+        std::filesystem::path filePath(outputFilePath);
+        if(std::filesystem::exists(filePath)) {return false;}
+        outputFile_.open(filePath.c_str(), std::ios::binary);
+        if(!outputFile_.is_open()){
+            KAF_LOG_ERROR("Failed to open output file: %s", outputFilePath.c_str());
+            return false;
+        }
+        BitmapInfo info;
+        info.width_ = width;
+        info.height_ = height;
+        info.bitsPerPixel_ = static_cast<std::uint16_t>(bitPerPixel);
+        info.pixelOffset_ = static_cast<std::uint32_t>(BITMAP_FILEHEADER_SIZE + BITMAP_INFOHEADER_SIZE);
+        unsigned char header[BITMAP_FILEHEADER_SIZE + BITMAP_INFOHEADER_SIZE];
+        serializeBitmapFileHeader(info, header);
+        serializeBitmapInfoHeader(info, header + BITMAP_FILEHEADER_SIZE);
+        if(!outputFile_.write(reinterpret_cast<const char*>(header), sizeof(header))){
+            KAF_LOG_ERROR("Failed to write BMP header");
+            outputFile_.close();
+            return false;
+        }
+        info_ = info;
+        staging_.assign(info_.lineStride(), 0);
+        return true;
+    }
+
+    bool BmpRowWriter::writeLine(const std::vector<domain::graphics2d::Pixel>& line){
+        if(!isOpen() || nextLine_ >= info_.height_ || line.size() != info_.width_){
+            return false;
+        }
+        encodeBitmapLine(line.data(), info_.bytePerPixel(), staging_.data(), info_.width_);
+        const size_t lineNumber = info_.height_ - nextLine_ - 1;
+        const std::streamoff position = static_cast<std::streamoff>(info_.pixelOffset_ + lineNumber * info_.lineStride());
+        if(!outputFile_.seekp(position) ||
+            !outputFile_.write(reinterpret_cast<const char*>(staging_.data()), static_cast<std::streamsize>(staging_.size()))){
+            KAF_LOG_ERROR("Failed to write line %zu", nextLine_);
+            return false;
+        }
+        ++nextLine_;
+        return true;
+    }
+
+    bool BmpRowWriter::close(){
+        if(!outputFile_.is_open()){
+            return false;
+        }
+        const bool completed = nextLine_ == info_.height_;
+        outputFile_.close();
+        const bool result = completed && !outputFile_.fail();
+        info_ = BitmapInfo{};
+        nextLine_ = 0;
+        staging_.clear();
+        return result;
+    }
+}
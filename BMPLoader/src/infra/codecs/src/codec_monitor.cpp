@@ -0,0 +1,98 @@
+/**
+ * @file codec_monitor.cpp
+ * @brief CodecMonitor とイベントの文字列表現の実装。
+ */
+#include "../include/codec_monitor.hpp"
+
+namespace kaf::infra::codecs{
+    const char* toString(const CodecOperation operation){
+        switch(operation){
+            case CodecOperation::Load: return "load";
+            case CodecOperation::Save: return "save";
+        }
+        return "unknown";
+    }
+
+    const char* toString(const CodecAbortReason reason){
+        switch(reason){
+            case CodecAbortReason::Cancelled: return "cancelled";
+            case CodecAbortReason::DeadlineExceeded: return "deadline exceeded";
+        }
+        return "unknown";
+    }
+
+    CodecMonitor::CodecMonitor(const CodecOptions& options, const CodecOperation operation, const size_t rowCount, const size_t byteCount)
+        : sink_(options.eventSink_), cancellation_(options.cancellation_), deadline_(options.deadline_),
+          interval_(std::chrono::duration_cast<std::chrono::nanoseconds>(options.progressInterval_).count()),
+          operation_(operation), rowCount_(rowCount), byteCount_(byteCount),
+          active_(sink_ != nullptr || cancellation_ != nullptr || deadline_ != Clock::time_point::max()){
+        if(sink_ != nullptr){
+            nextReport_.store(ticks(Clock::now()) + interval_, std::memory_order_relaxed);
+        }
+    }
+
+    std::int64_t CodecMonitor::ticks(const Clock::time_point time){
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+    bool CodecMonitor::checkpoint(){
+        if(!active_){
+            return true;
+        }
+        if(isAborted()){
+            return false;
+        }
+        if(cancellation_ != nullptr && cancellation_->isCancelled()){
+            abort(CodecAbortReason::Cancelled);
+            return false;
+        }
+        if(deadline_ != Clock::time_point::max() && Clock::now() >= deadline_){
+            abort(CodecAbortReason::DeadlineExceeded);
+            return false;
+        }
+        return true;
+    }
+
+    bool CodecMonitor::advance(const size_t rows, const size_t bytes){
+        if(!active_){
+            return true;
+        }
+        rowsDone_.fetch_add(rows, std::memory_order_relaxed);
+        bytesDone_.fetch_add(bytes, std::memory_order_relaxed);
+        if(!checkpoint()){
+            return false;
+        }
+        if(sink_ != nullptr){
+            const std::int64_t now = ticks(Clock::now());
+            std::int64_t next = nextReport_.load(std::memory_order_relaxed);
+            // 間隔を過ぎていても、送るのは予約に成功した 1 スレッドだけ
+            if(now >= next && nextReport_.compare_exchange_strong(next, now + interval_, std::memory_order_relaxed)){
+                publishProgress();
+            }
+        }
+        return true;
+    }
+
+    void CodecMonitor::finish(){
+        if(sink_ != nullptr && !isAborted()){
+            publishProgress();
+        }
+    }
+
+    void CodecMonitor::abort(const CodecAbortReason reason){
+        if(aborted_.exchange(true, std::memory_order_relaxed) || sink_ == nullptr){
+            return;
+        }
+        sink_->publish(CodecAborted{operation_, reason, rowsDone_.load(std::memory_order_relaxed), rowCount_});
+    }
+
+    void CodecMonitor::publishProgress(){
+        sink_->publish(CodecProgress{
+            operation_,
+            rowsDone_.load(std::memory_order_relaxed),
+            rowCount_,
+            bytesDone_.load(std::memory_order_relaxed),
+            byteCount_,
+        });
+    }
+}
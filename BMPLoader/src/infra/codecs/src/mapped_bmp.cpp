@@ -0,0 +1,103 @@
+/**
+ * @file mapped_bmp.cpp
+ * @brief MappedBMP の実装。
+ */
+#include "../include/mapped_bmp.hpp"
+
+#include <utility>
+
+#include "../../../domain/graphics2d/include/image.hpp"
+#include "../../../domain/common/include/log.hpp"
+
+namespace kaf::infra::codecs{
+    MappedBMP::MappedBMP() = default;
+
+    MappedBMP::~MappedBMP(){
+        close();
+    }
+
+    MappedBMP::MappedBMP(MappedBMP&& other) noexcept
+        : file_(std::move(other.file_)), info_(std::exchange(other.info_, BitmapInfo{})){}
+
+    MappedBMP& MappedBMP::operator=(MappedBMP&& other) noexcept{
+        if(this == &other){
+            return *this;
+        }
+        file_ = std::move(other.file_);
+        info_ = std::exchange(other.info_, BitmapInfo{});
+        return *this;
+    }
+
+    bool MappedBMP::open(const std::string& inputFilePath){
+        close();
+        MappedFile file;
+        if(!file.open(inputFilePath)){
+            KAF_LOG_ERROR("Failed to map input file: %s", inputFilePath.c_str());
+            return false;
+        }
+        if(file.size() < BITMAP_FILEHEADER_SIZE + BITMAP_INFOHEADER_SIZE){
+            KAF_LOG_ERROR("BMP file is too small");
+            return false;
+        }
+        BitmapInfo info;
+        if(!parseBitmapFileHeader(file.data(), info)){
+            KAF_LOG_ERROR("Failed to read BMP file header");
+            return false;
+        }
+        if(!parseBitmapInfoHeader(file.data() + BITMAP_FILEHEADER_SIZE, info)){
+            KAF_LOG_ERROR("Failed to read BMP info header");
+            return false;
+        }
+        auto pixelArraySize = domain::graphics2d::mul_size(info.lineStride(), info.height_);
+        if(!pixelArraySize.has_value() || info.pixelOffset_ > file.size() || file.size() - info.pixelOffset_ < pixelArraySize.value()){
+            KAF_LOG_ERROR("BMP pixel array is truncated");
+            return false;
+        }
+        file_ = std::move(file);
+        info_ = info;
+        return true;
+    }
+
+    void MappedBMP::close(){
+        file_.close();
+        info_ = BitmapInfo{};
+    }
+
+    const std::uint8_t* MappedBMP::getLine(const size_t height) const{
+        if(!isValid() || height >= getHeight()){
+            return nullptr;
+        }
+        const size_t lineNumber = getHeight() - height - 1;
+        return file_.data() + info_.pixelOffset_ + lineNumber * getLineStride();
+    }
+
+    const std::uint8_t* MappedBMP::getPixel(const size_t width, const size_t height) const{
+        if(width >= getWidth()){
+            return nullptr;
+        }
+        const std::uint8_t* line = getLine(height);
+        if(line == nullptr){
+            return nullptr;
+        }
+        return line + width * getBytePerPixel();
+    }
+
+    namespace {
+        template<class P>
+        domain::graphics2d::BasicImageView<const P> makeTopDownView(const MappedBMP& mapped){
+            if(!mapped.isValid() || mapped.getBytePerPixel() != sizeof(P)){
+                return domain::graphics2d::BasicImageView<const P>();
+            }
+            return domain::graphics2d::BasicImageView<const P>(reinterpret_cast<const P*>(mapped.getLine(0)),
+                mapped.getWidth(), mapped.getHeight(), -static_cast<std::ptrdiff_t>(mapped.getLineStride()));
+        }
+    }
+
+    domain::graphics2d::BasicImageView<const domain::graphics2d::BGR8> MappedBMP::getBgrView() const{
+        return makeTopDownView<domain::graphics2d::BGR8>(*this);
+    }
+
+    domain::graphics2d::BasicImageView<const domain::graphics2d::BGRA8> MappedBMP::getBgraView() const{
+        return makeTopDownView<domain::graphics2d::BGRA8>(*this);
+    }
+}
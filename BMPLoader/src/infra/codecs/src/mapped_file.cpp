@@ -0,0 +1,111 @@
+/**
+ * @file mapped_file.cpp
+ * @brief MappedFile の実装（Win32 / POSIX）。
+ */
+#include "../include/mapped_file.hpp"
+
+#include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kaf::infra::codecs{
+    MappedFile::MappedFile() = default;
+
+    MappedFile::~MappedFile(){
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept{
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept{
+        if(this == &other){
+            return *this;
+        }
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string& inputFilePath){
+        close();
+        std::filesystem::path filePath(inputFilePath);
+        if(!std::filesystem::exists(filePath)) {return false;}
+#ifdef _WIN32
+        HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE){
+            return false;
+        }
+        LARGE_INTEGER fileSize{};
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0){
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if(mapping == nullptr){
+            return false;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(view == nullptr){
+            CloseHandle(mapping);
+            return false;
+        }
+        mapping_ = mapping;
+        data_ = static_cast<const unsigned char*>(view);
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int file = ::open(filePath.c_str(), O_RDONLY);
+        if(file < 0){
+            return false;
+        }
+        struct stat status{};
+        if(fstat(file, &status) != 0 || status.st_size <= 0){
+            ::close(file);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+        ::close(file);
+        if(view == MAP_FAILED){
+            return false;
+        }
+        data_ = static_cast<const unsigned char*>(view);
+        size_ = static_cast<size_t>(status.st_size);
+#endif
+        return true;
+    }
+
+    void MappedFile::close(){
+        if(data_ == nullptr){
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
@@ -2,9 +2,103 @@
  * @file main.cpp
  * @brief エントリポイント。引数の表示と受け取りを行います。
  */
+#include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include "../include/arguments.hpp"
 #include "../../../infra/codecs/include/bmp.hpp"
+#include "../../../infra/codecs/include/bmp_index.hpp"
+#include "../../../infra/codecs/include/bmp_corpus.hpp"
+#include "../../../infra/codecs/include/bmp_roundtrip.hpp"
+
+/**
+ * @brief --scan 指定時、ディレクトリ内の BMP ヘッダを走査して索引を出力します。
+ * @return 終了コード
+ */
+static int scanDirectory(const Arguments& args){
+    const auto start = std::chrono::steady_clock::now();
+    const auto entries = kaf::infra::codecs::scanBitmapDirectory(args.getScanDirectory(), args.getThreadCount());
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Scanned files: " << entries.size() << std::endl;
+    std::cout << "Scan time: " << seconds << " s (" << (seconds > 0.0 ? entries.size() / seconds : 0.0) << " files/s)" << std::endl;
+    if(args.getIndexPath().empty()){
+        return kaf::infra::codecs::writeBitmapIndexCsv(entries, std::cout) ? 0 : 1;
+    }
+    const bool csv = std::filesystem::path(args.getIndexPath()).extension() == ".csv";
+    std::ofstream output(args.getIndexPath(), csv ? std::ios::out : std::ios::binary);
+    const bool result = csv ? kaf::infra::codecs::writeBitmapIndexCsv(entries, output) : kaf::infra::codecs::writeBitmapIndexBinary(entries, output);
+    std::cout << (result ? "Index written: " : "Failed to write index: ") << args.getIndexPath() << std::endl;
+    return result ? 0 : 1;
+}
+
+/**
+ * @brief --corpus 指定時、ベンチマーク用の合成 BMP コーパスを生成します。
+ * @retval true 生成成功
+ * @retval false 生成失敗
+ */
+static bool generateCorpus(const Arguments& args){
+    const auto specs = kaf::infra::codecs::defaultCorpusSpecs(args.getCorpusMaxBytes());
+    std::vector<kaf::infra::codecs::CorpusEntry> entries;
+    const auto start = std::chrono::steady_clock::now();
+    const bool result = kaf::infra::codecs::generateCorpus(args.getCorpusDirectory(), specs, entries, args.getThreadCount());
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t generated = 0;
+    for(const auto& entry : entries){
+        generated += entry.generated_ ? 1 : 0;
+    }
+    std::cout << "Corpus images: " << entries.size() << " (" << generated << " generated, " << entries.size() - generated << " reused)" << std::endl;
+    std::cout << "Corpus time: " << seconds << " s" << std::endl;
+    if(!result){
+        std::cout << "Failed to generate corpus: " << args.getCorpusDirectory() << std::endl;
+    }
+    return result;
+}
+
+/**
+ * @brief --roundtrip 指定時、ディレクトリ内の BMP の読み込み→保存を計測し、基準値と比較します。
+ * @return 終了コード（失敗または劣化があれば 1）
+ */
+static int roundTrip(const Arguments& args){
+    const auto entries = kaf::infra::codecs::scanBitmapDirectory(args.getRoundTripDirectory(), args.getThreadCount());
+    kaf::infra::codecs::RoundTripOptions options;
+    options.codec_.threadCount_ = args.getThreadCount();
+    options.repeat_ = args.getRepeatCount();
+    kaf::infra::codecs::RoundTripReport report;
+    const bool result = kaf::infra::codecs::runRoundTrip<kaf::domain::graphics2d::Pixel>(entries, options, report);
+    std::cout << "Round trips: " << report.imageCount_ << " (" << report.failureCount_ << " failed)" << std::endl;
+    std::cout << "Throughput: " << report.megabytesPerSecond_ << " MB/s, " << report.imagesPerSecond_ << " images/s" << std::endl;
+    std::cout << "Latency: p50 " << report.p50Milliseconds_ << " ms, p99 " << report.p99Milliseconds_ << " ms" << std::endl;
+    std::cout << "Peak RSS: " << report.peakResidentBytes_ / (1024.0 * 1024.0) << " MiB" << std::endl;
+    if(!result){
+        std::cout << "Round trip failed." << std::endl;
+        return 1;
+    }
+    if(args.getBaselinePath().empty()){
+        return 0;
+    }
+    std::ifstream baselineFile(args.getBaselinePath());
+    kaf::infra::codecs::RoundTripReport baseline;
+    if(args.isUpdateBaseline() || !baselineFile.is_open()){
+        baselineFile.close();
+        std::ofstream output(args.getBaselinePath());
+        const bool written = kaf::infra::codecs::writeRoundTripReportCsv(report, output);
+        std::cout << (written ? "Baseline written: " : "Failed to write baseline: ") << args.getBaselinePath() << std::endl;
+        return written ? 0 : 1;
+    }
+    if(!kaf::infra::codecs::readRoundTripReportCsv(baselineFile, baseline)){
+        std::cout << "Invalid baseline: " << args.getBaselinePath() << std::endl;
+        return 1;
+    }
+    bool regressed = false;
+    for(const auto& comparison : kaf::infra::codecs::compareRoundTrip(baseline, report, args.getRegressionThreshold())){
+        std::cout << (comparison.regressed_ ? "REGRESSED " : "ok        ") << comparison.metric_ << ": "
+            << comparison.baseline_ << " -> " << comparison.current_ << " (" << std::abs(comparison.change_) * 100.0
+            << (comparison.change_ > 0.0 ? " % worse)" : " % better)") << std::endl;
+        regressed = regressed || comparison.regressed_;
+    }
+    return regressed ? 1 : 0;
+}
 
 /**
  * @brief アプリケーションのエントリポイント。
@@ -13,12 +107,31 @@ int main(int argc, char* argv[]){
     Arguments args;
     args.showArguments(argc, argv);
     args.recieveArgument(argc, argv);
+    if(!args.getScanDirectory().empty()){
+        return scanDirectory(args);
+    }
+    // 最大常駐メモリはプロセス開始からの値で、コーパス生成の分が基準値との比較に混ざるため同じプロセスでは計測しない
+    if(!args.getCorpusDirectory().empty() && !args.getRoundTripDirectory().empty() && !args.getBaselinePath().empty()){
+        std::cout << "--baseline cannot be combined with --corpus: generate the corpus in a separate run first." << std::endl;
+        return 1;
+    }
+    if(!args.getCorpusDirectory().empty() && !generateCorpus(args)){
+        return 1;
+    }
+    if(!args.getRoundTripDirectory().empty()){
+        return roundTrip(args);
+    }
+    if(!args.getCorpusDirectory().empty()){
+        return 0;
+    }
     kaf::infra::codecs::BMP bmpImage;
+    kaf::infra::codecs::CodecOptions options;
+    options.threadCount_ = args.getThreadCount();
     if(args.getLoadBmpPath().empty()){
         std::cout << "No BMP path specified." << std::endl;
     } else {
         std::cout << "BMP Path: " << args.getLoadBmpPath() << std::endl;
-        if(bmpImage.loadImage(args.getLoadBmpPath())){
+        if(bmpImage.loadImage(args.getLoadBmpPath(), options)){
             std::cout << "BMP image loaded successfully." << std::endl;
             std::cout << "Image Size: " << bmpImage.getWidth() << " x " << bmpImage.getHeight() << std::endl;
             std::cout << "Valid Image: " << (bmpImage.isValid() ? "Yes" : "No") << std::endl;
@@ -30,7 +143,7 @@ int main(int argc, char* argv[]){
         std::cout << "No BMP path specified." << std::endl;
     } else {
         std::cout << "BMP Path: " << args.getSaveBmpPath() << std::endl;
-        if(bmpImage.saveImage(args.getSaveBmpPath(), 24)){
+        if(bmpImage.saveImage(args.getSaveBmpPath(), 24, options)){
             std::cout << "BMP image saved successfully." << std::endl;
             std::cout << "Image Size: " << bmpImage.getWidth() << " x " << bmpImage.getHeight() << std::endl;
         } else {
@@ -5,6 +5,7 @@
 #ifndef __ARGUMENTS_H__
 #define __ARGUMENTS_H__
 
+#include <cstdint>
 #include <filesystem>
 
 /**
@@ -28,15 +29,72 @@ public:
      */
     const std::string getLoadBmpPath()const {return loadBmpPath_;};
     const std::string getSaveBmpPath()const {return saveBmpPath_;};
+    /**
+     * @brief --threads/--t で指定されたスレッド数を返します（未指定時 1、0 は自動）。
+     */
+    size_t getThreadCount()const {return threadCount_;};
+    /**
+     * @brief --scan で指定された走査ディレクトリを返します。
+     */
+    const std::string getScanDirectory()const {return scanDirectory_;};
+    /**
+     * @brief --index で指定された索引の出力パスを返します（拡張子 .csv なら CSV、それ以外はバイナリ）。
+     */
+    const std::string getIndexPath()const {return indexPath_;};
+    /**
+     * @brief --corpus で指定された合成コーパスの出力ディレクトリを返します。
+     */
+    const std::string getCorpusDirectory()const {return corpusDirectory_;};
+    /**
+     * @brief --corpus-max-mb で指定されたコーパスのファイルサイズ上限[バイト]を返します（未指定時 256 MiB）。
+     */
+    std::uintmax_t getCorpusMaxBytes()const {return corpusMaxBytes_;};
+    /**
+     * @brief --roundtrip で指定された往復計測の対象ディレクトリを返します。
+     */
+    const std::string getRoundTripDirectory()const {return roundTripDirectory_;};
+    /**
+     * @brief --repeat で指定された往復の繰り返し回数を返します（未指定時 1）。
+     */
+    size_t getRepeatCount()const {return repeatCount_;};
+    /**
+     * @brief --baseline で指定された基準値 CSV のパスを返します。
+     * @details 最大常駐メモリはプロセス全体の値のため、--corpus と同時には指定できません（別プロセスで生成してください）。
+     */
+    const std::string getBaselinePath()const {return baselinePath_;};
+    /**
+     * @brief --update-baseline が指定されたか（基準値と比べずに今回の結果で上書きします）。
+     */
+    bool isUpdateBaseline()const {return updateBaseline_;};
+    /**
+     * @brief --threshold で指定された劣化の閾値を割合で返します（引数は %、未指定時 10%）。
+     */
+    double getRegressionThreshold()const {return regressionThreshold_;};
 private:
     std::string loadBmpPath_;
     std::string saveBmpPath_;
+    size_t threadCount_ = 1;
+    std::string scanDirectory_;
+    std::string indexPath_;
+    std::string corpusDirectory_;
+    std::uintmax_t corpusMaxBytes_ = 256u * 1024u * 1024u;
+    std::string roundTripDirectory_;
+    size_t repeatCount_ = 1;
+    std::string baselinePath_;
+    bool updateBaseline_ = false;
+    double regressionThreshold_ = 0.10;
 
     /**
      * @brief BMP 読み込みパスの解析実装。
      */
     bool reciveLoadBmpPath(int argc, char* argv[]);
     bool reciveSaveBmpPath(int argc, char* argv[]);
+    bool reciveThreadCount(int argc, char* argv[]);
+    bool reciveScanDirectory(int argc, char* argv[]);
+    bool reciveIndexPath(int argc, char* argv[]);
+    bool reciveCorpusDirectory(int argc, char* argv[]);
+    bool reciveRoundTripDirectory(int argc, char* argv[]);
+    void reciveBenchmarkOptions(int argc, char* argv[]);
 };
 
 #endif
@@ -3,6 +3,7 @@
  * @brief Arguments の実装。
  */
 #include <iostream>
+#include <string>
 #include "arguments.hpp"
 
 void Arguments::showArguments(int argc, char* argv[]){
@@ -20,6 +21,17 @@ bool Arguments::recieveArgument(int argc, char* argv[]){
     if(!result){
         std::cout<<"No Save BMP Path Specified." << std::endl;
     }
+    reciveThreadCount(argc, argv);
+    if(reciveScanDirectory(argc, argv)){
+        reciveIndexPath(argc, argv);
+        result = true;
+    }
+    const bool corpus = reciveCorpusDirectory(argc, argv);
+    const bool roundTrip = reciveRoundTripDirectory(argc, argv);
+    if(corpus || roundTrip){
+        reciveBenchmarkOptions(argc, argv);
+        result = true;
+    }
     return result;
 }
 
@@ -53,3 +65,101 @@ bool Arguments::reciveSaveBmpPath(int argc, char* argv[]){
     }
     return false;
 }
+
+bool Arguments::reciveThreadCount(int argc, char* argv[]){
+    for(int idx =0; idx < argc; idx++){
+        std::string argString = argv[idx];
+        if((argString == "--threads" || argString == "--t") && (idx +1 < argc)){
+            try{
+                const unsigned long count = std::stoul(argv[idx+1]);
+                threadCount_ = static_cast<size_t>(count);
+                std::cout<<"Thread count: " << threadCount_ << std::endl;
+                return true;
+            } catch(const std::exception&){
+                std::cout<<"Invalid thread count: " << argv[idx+1] << std::endl;
+                return false;
+            }
+        }
+    }
+    return false;
+}
+bool Arguments::reciveScanDirectory(int argc, char* argv[]){
+    for(int idx =0; idx < argc; idx++){
+        std::string argString = argv[idx];
+        if(argString == "--scan" && (idx +1 < argc)){
+            std::filesystem::path directoryPath(argv[idx+1]);
+            if(std::filesystem::is_directory(directoryPath)){
+                scanDirectory_ = directoryPath.generic_string();
+                std::cout<<"Scan directory: " << scanDirectory_ << std::endl;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+bool Arguments::reciveIndexPath(int argc, char* argv[]){
+    for(int idx =0; idx < argc; idx++){
+        std::string argString = argv[idx];
+        if(argString == "--index" && (idx +1 < argc)){
+            std::filesystem::path filePath(argv[idx+1]);
+            if(!std::filesystem::exists(filePath)){
+                indexPath_ = filePath.generic_string();
+                std::cout<<"Index file: " << indexPath_ << std::endl;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+bool Arguments::reciveCorpusDirectory(int argc, char* argv[]){
+    for(int idx =0; idx < argc; idx++){
+        std::string argString = argv[idx];
+        if(argString == "--corpus" && (idx +1 < argc)){
+            corpusDirectory_ = std::filesystem::path(argv[idx+1]).generic_string();
+            std::cout<<"Corpus directory: " << corpusDirectory_ << std::endl;
+            return true;
+        }
+    }
+    return false;
+}
+bool Arguments::reciveRoundTripDirectory(int argc, char* argv[]){
+    for(int idx =0; idx < argc; idx++){
+        std::string argString = argv[idx];
+        if(argString == "--roundtrip" && (idx +1 < argc)){
+            // --corpus と同じディレクトリを指定できるよう、ここでは存在を確認しない
+            roundTripDirectory_ = std::filesystem::path(argv[idx+1]).generic_string();
+            std::cout<<"Round-trip directory: " << roundTripDirectory_ << std::endl;
+            return true;
+        }
+    }
+    return false;
+}
+void Arguments::reciveBenchmarkOptions(int argc, char* argv[]){
+    for(int idx =0; idx < argc; idx++){
+        std::string argString = argv[idx];
+        if(argString == "--update-baseline"){
+            updateBaseline_ = true;
+            continue;
+        }
+        if(idx +1 >= argc){
+            continue;
+        }
+        try{
+            if(argString == "--corpus-max-mb"){
+                corpusMaxBytes_ = static_cast<std::uintmax_t>(std::stoull(argv[idx+1])) * 1024u * 1024u;
+                std::cout<<"Corpus max file size: " << corpusMaxBytes_ << " bytes" << std::endl;
+            } else if(argString == "--repeat"){
+                repeatCount_ = static_cast<size_t>(std::stoul(argv[idx+1]));
+                std::cout<<"Repeat count: " << repeatCount_ << std::endl;
+            } else if(argString == "--baseline"){
+                baselinePath_ = std::filesystem::path(argv[idx+1]).generic_string();
+                std::cout<<"Baseline file: " << baselinePath_ << std::endl;
+            } else if(argString == "--threshold"){
+                regressionThreshold_ = std::stod(argv[idx+1]) / 100.0;
+                std::cout<<"Regression threshold: " << regressionThreshold_ * 100.0 << " %" << std::endl;
+            }
+        } catch(const std::exception&){
+            std::cout<<"Invalid value for " << argString << ": " << argv[idx+1] << std::endl;
+        }
+    }
+}
\ No newline at end of file
@@ -1,8 +1,28 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <vector>
+#include <string>
+#include <tuple>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <algorithm>
+#include <utility>
+#include <mutex>
+#include <chrono>
+#include <set>
 
 #include "../src/infra/codecs/include/bmp.hpp"
+#include "../src/infra/codecs/include/mapped_bmp.hpp"
+#include "../src/infra/codecs/include/bmp_row_reader.hpp"
+#include "../src/infra/codecs/include/bmp_row_writer.hpp"
+#include "../src/infra/codecs/include/bmp_index.hpp"
+#include "../src/infra/codecs/include/bmp_corpus.hpp"
+#include "../src/infra/codecs/include/bmp_roundtrip.hpp"
+#include "../src/infra/application/include/event_bus.hpp"
 #include "../src/domain/graphics2d/include/pixel.hpp"
 
 using namespace kaf;
@@ -16,3 +36,620 @@ TEST(BMP, CreateNewImageFillsBackground) {
   // 例: const Image& image() const; を用意して at(x,y) で確認
   // EXPECT_FLOAT_EQ(bmp.image().at(1,1).r, 1.f);
 }
+
+namespace {
+  // 24/32bpp BI_RGB のボトムアップ BMP をバイト列から直接書き出す（ピクセル値は座標から決定）
+  unsigned char patternByte(size_t x, size_t y, size_t channel) {
+    return static_cast<unsigned char>((x * 7 + y * 13 + channel * 61) & 0xFF);
+  }
+
+  std::filesystem::path writePatternBmp(const std::string& name, uint32_t w, uint32_t h, uint16_t bpp) {
+    const size_t bytePerPixel = bpp / 8;
+    const size_t stride = (w * bytePerPixel + 3) / 4 * 4;
+    std::vector<unsigned char> data(54 + stride * h, 0);
+    auto put16 = [&](size_t pos, uint16_t v) { data[pos] = v & 0xFF; data[pos + 1] = v >> 8; };
+    auto put32 = [&](size_t pos, uint32_t v) { put16(pos, v & 0xFFFF); put16(pos + 2, v >> 16); };
+    data[0] = 'B'; data[1] = 'M';
+    put32(2, static_cast<uint32_t>(data.size()));
+    put32(10, 54);
+    put32(14, 40);
+    put32(18, w);
+    put32(22, h);
+    put16(26, 1);
+    put16(28, bpp);
+    for (size_t line = 0; line < h; ++line) {
+      const size_t y = h - line - 1;
+      for (size_t x = 0; x < w; ++x) {
+        for (size_t c = 0; c < bytePerPixel; ++c) {
+          data[54 + line * stride + x * bytePerPixel + c] = patternByte(x, y, c);
+        }
+      }
+    }
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return path;
+  }
+}
+
+class BMPLoad : public ::testing::TestWithParam<std::tuple<uint32_t, uint32_t, uint16_t>> {};
+
+TEST_P(BMPLoad, DecodesEveryPixelAndPadding) {
+  const auto [w, h, bpp] = GetParam();
+  auto path = writePatternBmp("kaf_bmp_load_" + std::to_string(w) + "x" + std::to_string(h) + "_" + std::to_string(bpp) + ".bmp", w, h, bpp);
+  infra::codecs::BMP bmp;
+  ASSERT_TRUE(bmp.loadImage(path.string()));
+  ASSERT_EQ(bmp.getWidth(), w);
+  ASSERT_EQ(bmp.getHeight(), h);
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) {
+      const auto* px = bmp.getPixel(x, y);
+      ASSERT_NE(px, nullptr);
+      EXPECT_EQ(px->b_, static_cast<float>(patternByte(x, y, 0)) / 255.0f);
+      EXPECT_EQ(px->g_, static_cast<float>(patternByte(x, y, 1)) / 255.0f);
+      EXPECT_EQ(px->r_, static_cast<float>(patternByte(x, y, 2)) / 255.0f);
+      EXPECT_EQ(px->a_, 1.0f);
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+INSTANTIATE_TEST_SUITE_P(PaddingCases, BMPLoad,
+  ::testing::Values(
+    std::make_tuple(1u, 1u, uint16_t{24}), std::make_tuple(2u, 3u, uint16_t{24}),
+    std::make_tuple(3u, 5u, uint16_t{24}), std::make_tuple(4u, 2u, uint16_t{24}),
+    std::make_tuple(5u, 4u, uint16_t{32}), std::make_tuple(7u, 1u, uint16_t{32})));
+
+TEST(BMP, LoadRejectsTruncatedPixelArray) {
+  auto path = writePatternBmp("kaf_bmp_truncated.bmp", 8, 8, 24);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+  infra::codecs::BMP bmp;
+  EXPECT_FALSE(bmp.loadImage(path.string()));
+  std::filesystem::remove(path);
+}
+
+TEST(MappedBMP, ExposesPixelArrayInPlace) {
+  const uint32_t w = 5, h = 3;
+  auto path = writePatternBmp("kaf_bmp_mapped.bmp", w, h, 24);
+  {
+    infra::codecs::MappedBMP mapped;
+    ASSERT_TRUE(mapped.open(path.string()));
+    EXPECT_EQ(mapped.getWidth(), w);
+    EXPECT_EQ(mapped.getHeight(), h);
+    EXPECT_EQ(mapped.getBytePerPixel(), 3u);
+    EXPECT_EQ(mapped.getLineStride(), 16u);
+    for (size_t y = 0; y < h; ++y) {
+      for (size_t x = 0; x < w; ++x) {
+        const auto* bgr = mapped.getPixel(x, y);
+        ASSERT_NE(bgr, nullptr);
+        EXPECT_EQ(bgr[0], patternByte(x, y, 0));
+        EXPECT_EQ(bgr[1], patternByte(x, y, 1));
+        EXPECT_EQ(bgr[2], patternByte(x, y, 2));
+      }
+    }
+    EXPECT_EQ(mapped.getPixel(w, 0), nullptr);
+    EXPECT_EQ(mapped.getLine(h), nullptr);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(MappedBMP, RejectsTruncatedPixelArray) {
+  auto path = writePatternBmp("kaf_bmp_mapped_truncated.bmp", 8, 8, 32);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  {
+    infra::codecs::MappedBMP mapped;
+    EXPECT_FALSE(mapped.open(path.string()));
+    EXPECT_FALSE(mapped.isValid());
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(BmpRowReader, YieldsLinesTopDownMatchingLoadImage) {
+  const uint32_t w = 7, h = 5;
+  auto path = writePatternBmp("kaf_bmp_row_reader.bmp", w, h, 24);
+  infra::codecs::BMP bmp;
+  ASSERT_TRUE(bmp.loadImage(path.string()));
+  {
+    infra::codecs::BmpRowReader reader;
+    ASSERT_TRUE(reader.open(path.string()));
+    std::vector<domain::graphics2d::Pixel> line;
+    for (size_t y = 0; y < h; ++y) {
+      EXPECT_EQ(reader.getNextLine(), y);
+      ASSERT_TRUE(reader.readLine(line));
+      ASSERT_EQ(line.size(), w);
+      for (size_t x = 0; x < w; ++x) {
+        EXPECT_EQ(line[x].r_, bmp.getPixel(x, y)->r_);
+        EXPECT_EQ(line[x].g_, bmp.getPixel(x, y)->g_);
+        EXPECT_EQ(line[x].b_, bmp.getPixel(x, y)->b_);
+      }
+    }
+    EXPECT_FALSE(reader.readLine(line));
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(BmpRowWriter, WritesBottomUpWithPaddingAndRoundTrips) {
+  const size_t w = 3, h = 4;
+  auto path = std::filesystem::temp_directory_path() / "kaf_bmp_row_writer.bmp";
+  std::filesystem::remove(path);
+  {
+    infra::codecs::BmpRowWriter writer;
+    ASSERT_TRUE(writer.open(path.string(), w, h, 24));
+    std::vector<domain::graphics2d::Pixel> line(w);
+    for (size_t y = 0; y < h; ++y) {
+      for (size_t x = 0; x < w; ++x) {
+        line[x] = domain::graphics2d::Pixel(x / 2.0f, y / 3.0f, 1.0f);
+      }
+      ASSERT_TRUE(writer.writeLine(line));
+    }
+    EXPECT_FALSE(writer.writeLine(line));
+    EXPECT_TRUE(writer.close());
+  }
+  EXPECT_EQ(std::filesystem::file_size(path), 54u + 12u * h);
+  infra::codecs::BmpRowReader reader;
+  ASSERT_TRUE(reader.open(path.string()));
+  std::vector<domain::graphics2d::Pixel> line;
+  for (size_t y = 0; y < h; ++y) {
+    ASSERT_TRUE(reader.readLine(line));
+    for (size_t x = 0; x < w; ++x) {
+      EXPECT_EQ(line[x].r_, static_cast<float>(static_cast<unsigned char>(x / 2.0f * 255.0f + 0.5f)) / 255.0f);
+      EXPECT_EQ(line[x].g_, static_cast<float>(static_cast<unsigned char>(y / 3.0f * 255.0f)) / 255.0f);
+      EXPECT_EQ(line[x].b_, 1.0f);
+    }
+  }
+  reader.close();
+  std::filesystem::remove(path);
+}
+
+TEST(BmpRowWriter, CloseReportsMissingLines) {
+  auto path = std::filesystem::temp_directory_path() / "kaf_bmp_row_writer_short.bmp";
+  std::filesystem::remove(path);
+  infra::codecs::BmpRowWriter writer;
+  ASSERT_TRUE(writer.open(path.string(), 2, 2));
+  ASSERT_TRUE(writer.writeLine(std::vector<domain::graphics2d::Pixel>(2, domain::graphics2d::Pixel(0.f, 0.f, 0.f))));
+  EXPECT_FALSE(writer.close());
+  std::filesystem::remove(path);
+}
+
+class BMPSave : public ::testing::TestWithParam<std::tuple<size_t, size_t, size_t>> {};
+
+TEST_P(BMPSave, RoundTripsThroughLoadImage) {
+  const auto [w, h, bpp] = GetParam();
+  infra::codecs::BMP source(w, h);
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) {
+      source.setPixel(x, y, domain::graphics2d::Pixel(x / static_cast<float>(w), y / static_cast<float>(h), 0.5f, 0.25f));
+    }
+  }
+  auto path = std::filesystem::temp_directory_path() / ("kaf_bmp_save_" + std::to_string(w) + "x" + std::to_string(h) + "_" + std::to_string(bpp) + ".bmp");
+  std::filesystem::remove(path);
+  ASSERT_TRUE(source.saveImage(path.string(), bpp));
+  const size_t stride = (w * (bpp / 8) + 3) / 4 * 4;
+  EXPECT_EQ(std::filesystem::file_size(path), 54u + stride * h);
+
+  infra::codecs::BMP loaded;
+  ASSERT_TRUE(loaded.loadImage(path.string()));
+  ASSERT_EQ(loaded.getWidth(), w);
+  ASSERT_EQ(loaded.getHeight(), h);
+  auto quantize = [](float v) { return static_cast<float>(static_cast<unsigned char>(v * 255.0f + 0.5f)) / 255.0f; };
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) {
+      const auto* expected = source.getPixel(x, y);
+      const auto* actual = loaded.getPixel(x, y);
+      EXPECT_EQ(actual->r_, quantize(expected->r_));
+      EXPECT_EQ(actual->g_, quantize(expected->g_));
+      EXPECT_EQ(actual->b_, quantize(expected->b_));
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+INSTANTIATE_TEST_SUITE_P(PaddingCases, BMPSave,
+  ::testing::Values(
+    std::make_tuple(size_t{1}, size_t{1}, size_t{24}), std::make_tuple(size_t{3}, size_t{4}, size_t{24}),
+    std::make_tuple(size_t{6}, size_t{2}, size_t{24}), std::make_tuple(size_t{5}, size_t{3}, size_t{32})));
+
+TEST(BMP, SaveRejectsUnsupportedBitDepth) {
+  infra::codecs::BMP bmp(2, 2);
+  auto path = std::filesystem::temp_directory_path() / "kaf_bmp_save_16bpp.bmp";
+  std::filesystem::remove(path);
+  EXPECT_FALSE(bmp.saveImage(path.string(), 16));
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(BMP, ParallelLoadMatchesSequential) {
+  const uint32_t w = 9, h = 37;
+  auto path = writePatternBmp("kaf_bmp_parallel_load.bmp", w, h, 24);
+  infra::codecs::BMP sequential;
+  ASSERT_TRUE(sequential.loadImage(path.string()));
+  for (size_t threads : {size_t{2}, size_t{3}, size_t{64}}) {
+    infra::codecs::CodecOptions options;
+    options.threadCount_ = threads;
+    infra::codecs::BMP parallel;
+    ASSERT_TRUE(parallel.loadImage(path.string(), options));
+    ASSERT_EQ(parallel.getWidth(), w);
+    ASSERT_EQ(parallel.getHeight(), h);
+    EXPECT_EQ(std::memcmp(parallel.getPixelBuffer()->pixels_.get(), sequential.getPixelBuffer()->pixels_.get(),
+                          sizeof(domain::graphics2d::Pixel) * w * h), 0);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(BMP, ParallelSaveMatchesSequential) {
+  const size_t w = 11, h = 29;
+  infra::codecs::BMP source(w, h);
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) {
+      source.setPixel(x, y, domain::graphics2d::Pixel(x / 11.0f, y / 29.0f, 0.5f, 0.75f));
+    }
+  }
+  auto readAll = [](const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  };
+  auto sequentialPath = std::filesystem::temp_directory_path() / "kaf_bmp_parallel_save_seq.bmp";
+  auto parallelPath = std::filesystem::temp_directory_path() / "kaf_bmp_parallel_save_par.bmp";
+  std::filesystem::remove(sequentialPath);
+  std::filesystem::remove(parallelPath);
+  infra::codecs::CodecOptions options;
+  options.threadCount_ = 4;
+  ASSERT_TRUE(source.saveImage(sequentialPath.string(), 32));
+  ASSERT_TRUE(source.saveImage(parallelPath.string(), 32, options));
+  EXPECT_EQ(readAll(sequentialPath), readAll(parallelPath));
+  std::filesystem::remove(sequentialPath);
+  std::filesystem::remove(parallelPath);
+}
+
+TEST(BMP, CompactFormatsLoadFileBytesAndSaveIdentically) {
+  const uint32_t w = 5, h = 3;
+  auto readAll = [](const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  };
+  for (uint16_t bpp : {uint16_t{24}, uint16_t{32}}) {
+    auto path = writePatternBmp("kaf_bmp_compact_" + std::to_string(bpp) + ".bmp", w, h, bpp);
+    auto copyPath = std::filesystem::temp_directory_path() / ("kaf_bmp_compact_copy_" + std::to_string(bpp) + ".bmp");
+    std::filesystem::remove(copyPath);
+
+    infra::codecs::BasicBMP<domain::graphics2d::BGRA8> bgra;
+    ASSERT_TRUE(bgra.loadImage(path.string()));
+    infra::codecs::BasicBMP<domain::graphics2d::BGR8> bgr;
+    ASSERT_TRUE(bgr.loadImage(path.string()));
+    infra::codecs::BasicBMP<domain::graphics2d::Gray8> gray;
+    ASSERT_TRUE(gray.loadImage(path.string()));
+    for (size_t y = 0; y < h; ++y) {
+      for (size_t x = 0; x < w; ++x) {
+        EXPECT_EQ(bgr.getPixel(x, y)->b_, patternByte(x, y, 0));
+        EXPECT_EQ(bgr.getPixel(x, y)->g_, patternByte(x, y, 1));
+        EXPECT_EQ(bgr.getPixel(x, y)->r_, patternByte(x, y, 2));
+        EXPECT_EQ(bgra.getPixel(x, y)->a_, bpp == 32 ? patternByte(x, y, 3) : 255);
+        EXPECT_EQ(gray.getPixel(x, y)->v_, domain::graphics2d::lumaOf(patternByte(x, y, 2), patternByte(x, y, 1), patternByte(x, y, 0)));
+      }
+    }
+    ASSERT_TRUE(bgra.saveImage(copyPath.string(), bpp));
+    const auto original = readAll(path);
+    const auto copied = readAll(copyPath);
+    ASSERT_EQ(original.size(), copied.size());
+    EXPECT_TRUE(std::equal(original.begin() + 54, original.end(), copied.begin() + 54));
+    std::filesystem::remove(path);
+    std::filesystem::remove(copyPath);
+  }
+}
+
+TEST(BMP, BatchLoadReusesPooledPixelBuffer) {
+  auto path = writePatternBmp("kaf_bmp_pooled.bmp", 6, 4, 24);
+  domain::graphics2d::PixelBufferPool pool;
+  infra::codecs::CodecOptions options;
+  options.bufferPool_ = &pool;
+  infra::codecs::BMP bmp;
+  for (size_t threads : {size_t{1}, size_t{1}, size_t{2}}) {
+    options.threadCount_ = threads;
+    ASSERT_TRUE(bmp.loadImage(path.string(), options));
+    EXPECT_EQ(bmp.getPixel(5, 3)->b_, patternByte(5, 3, 0) / 255.0f);
+  }
+  EXPECT_EQ(pool.getReuseCount(), 2u);
+  std::filesystem::remove(path);
+}
+
+TEST(BMP, CopiesShareLoadedPixelsAndSaveIdentically) {
+  auto path = writePatternBmp("kaf_bmp_cow.bmp", 7, 5, 24);
+  infra::codecs::BMP loaded;
+  ASSERT_TRUE(loaded.loadImage(path.string()));
+  infra::codecs::BMP copy(loaded);
+  EXPECT_TRUE(loaded.isShared());
+  ASSERT_TRUE(copy.setPixel(0, 0, domain::graphics2d::Pixel(0.f, 0.f, 0.f)));
+  EXPECT_FALSE(loaded.isShared());
+  EXPECT_EQ(std::as_const(loaded).getPixel(0, 0)->b_, patternByte(0, 0, 0) / 255.0f);
+
+  auto savedPath = std::filesystem::temp_directory_path() / "kaf_bmp_cow_saved.bmp";
+  std::filesystem::remove(savedPath);
+  infra::codecs::BMP snapshot;
+  snapshot = loaded;
+  ASSERT_TRUE(snapshot.saveImage(savedPath.string(), 24));
+  EXPECT_TRUE(snapshot.isShared());
+  infra::codecs::BMP reloaded;
+  ASSERT_TRUE(reloaded.loadImage(savedPath.string()));
+  EXPECT_EQ(std::memcmp(std::as_const(reloaded).getPixelBuffer()->pixels_.get(), std::as_const(loaded).getPixelBuffer()->pixels_.get(),
+                        sizeof(domain::graphics2d::Pixel) * 7 * 5), 0);
+  std::filesystem::remove(path);
+  std::filesystem::remove(savedPath);
+}
+
+TEST(BMP, SavesCropFromMappedViewWithoutCopying) {
+  const uint32_t w = 9, h = 6;
+  auto path = writePatternBmp("kaf_bmp_view_src.bmp", w, h, 24);
+  infra::codecs::MappedBMP mapped;
+  ASSERT_TRUE(mapped.open(path.string()));
+  EXPECT_FALSE(mapped.getBgraView().isValid());
+  auto view = mapped.getBgrView();
+  ASSERT_TRUE(view.isValid());
+  EXPECT_LT(view.getRowStride(), 0);
+  EXPECT_EQ(view.at(4, 1).g_, patternByte(4, 1, 1));
+
+  auto crop = view.subView(2, 1, 5, 3);
+  auto cropPath = std::filesystem::temp_directory_path() / "kaf_bmp_view_crop.bmp";
+  std::filesystem::remove(cropPath);
+  ASSERT_TRUE(infra::codecs::BasicBMP<domain::graphics2d::BGR8>::saveView(cropPath.string(), crop, 24));
+  infra::codecs::BasicBMP<domain::graphics2d::BGR8> loaded;
+  ASSERT_TRUE(loaded.loadImage(cropPath.string()));
+  ASSERT_EQ(loaded.getWidth(), 5u);
+  ASSERT_EQ(loaded.getHeight(), 3u);
+  for (size_t y = 0; y < 3; ++y) {
+    for (size_t x = 0; x < 5; ++x) {
+      EXPECT_EQ(std::as_const(loaded).getPixel(x, y)->r_, patternByte(x + 2, y + 1, 2));
+    }
+  }
+  mapped.close();
+  std::filesystem::remove(path);
+  std::filesystem::remove(cropPath);
+}
+
+TEST(BMP, ProbeReadsHeaderOnly) {
+  auto path = writePatternBmp("kaf_bmp_probe.bmp", 6, 4, 32);
+  infra::codecs::BitmapInfo info;
+  ASSERT_TRUE(infra::codecs::BMP::probe(path.string(), info));
+  EXPECT_EQ(info.width_, 6u);
+  EXPECT_EQ(info.height_, 4u);
+  EXPECT_EQ(info.bitsPerPixel_, 32u);
+  EXPECT_EQ(info.compression_, 0u);
+  EXPECT_FALSE(info.topDown_);
+  EXPECT_TRUE(infra::codecs::isSupportedBitmap(info));
+  std::filesystem::remove(path);
+}
+
+TEST(BMP, ProbeReportsTopDownWhichLoadRejects) {
+  auto path = writePatternBmp("kaf_bmp_probe_topdown.bmp", 3, 2, 24);
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(22);
+    const unsigned char negativeTwo[4] = {0xFE, 0xFF, 0xFF, 0xFF};
+    file.write(reinterpret_cast<const char*>(negativeTwo), 4);
+  }
+  infra::codecs::BitmapInfo info;
+  ASSERT_TRUE(infra::codecs::BMP::probe(path.string(), info));
+  EXPECT_EQ(info.height_, 2u);
+  EXPECT_TRUE(info.topDown_);
+  EXPECT_FALSE(infra::codecs::isSupportedBitmap(info));
+  infra::codecs::BMP bmp;
+  EXPECT_FALSE(bmp.loadImage(path.string()));
+  std::filesystem::remove(path);
+}
+
+TEST(BmpIndex, ScansDirectoryAndWritesCsv) {
+  auto directory = std::filesystem::temp_directory_path() / "kaf_bmp_index";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory / "nested");
+  std::filesystem::rename(writePatternBmp("kaf_bmp_index_a.bmp", 2, 3, 24), directory / "a.bmp");
+  std::filesystem::rename(writePatternBmp("kaf_bmp_index_b.bmp", 5, 1, 32), directory / "nested" / "b.BMP");
+  std::ofstream(directory / "broken.bmp") << "not a bitmap";
+  std::ofstream(directory / "notes.txt") << "ignored";
+
+  auto entries = infra::codecs::scanBitmapDirectory(directory.string(), 2);
+  ASSERT_EQ(entries.size(), 3u);
+  EXPECT_TRUE(entries[0].valid_);
+  EXPECT_EQ(entries[0].info_.width_, 2u);
+  EXPECT_FALSE(entries[1].valid_);
+  EXPECT_TRUE(entries[2].valid_);
+  EXPECT_EQ(entries[2].info_.bitsPerPixel_, 32u);
+
+  std::ostringstream csv;
+  ASSERT_TRUE(infra::codecs::writeBitmapIndexCsv(entries, csv));
+  std::istringstream lines(csv.str());
+  std::string header, first;
+  std::getline(lines, header);
+  std::getline(lines, first);
+  EXPECT_EQ(header, "path,file_size,valid,supported,width,height,bits_per_pixel,compression,orientation");
+  EXPECT_EQ(first, entries[0].path_ + ",78,1,1,2,3,24,0,bottom-up");
+  std::filesystem::remove_all(directory);
+}
+
+TEST(BmpEvents, ReportsProgressUntilLastRow) {
+  auto path = writePatternBmp("kaf_bmp_events_progress.bmp", 64, 48, 24);
+  infra::application::EventBus bus;
+  std::mutex mutex;
+  std::vector<infra::codecs::CodecProgress> progress;
+  bus.subscribe<infra::codecs::CodecProgress>([&](const infra::codecs::CodecProgress& event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    progress.push_back(event);
+  });
+
+  for (size_t threads : {1u, 2u}) {
+    progress.clear();
+    infra::codecs::CodecOptions options;
+    options.threadCount_ = threads;
+    options.eventSink_ = &bus;
+    options.progressInterval_ = std::chrono::milliseconds(0);
+    infra::codecs::BMP bmp;
+    ASSERT_TRUE(bmp.loadImage(path.string(), options));
+    ASSERT_FALSE(progress.empty());
+    EXPECT_EQ(progress.back().operation_, infra::codecs::CodecOperation::Load);
+    EXPECT_EQ(progress.back().rowsDone_, 48u);
+    EXPECT_EQ(progress.back().rowCount_, 48u);
+    EXPECT_EQ(progress.back().bytesDone_, progress.back().byteCount_);
+    EXPECT_EQ(progress.back().byteCount_, 192u * 48u);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(BmpEvents, CancellationAbortsLoad) {
+  // 1 MB ごとの区切りが 1 スレッドあたり複数回になる大きさ
+  auto path = writePatternBmp("kaf_bmp_events_cancel.bmp", 512, 2048, 24);
+  infra::application::EventBus bus;
+  domain::common::CancellationToken token;
+  std::vector<infra::codecs::CodecAborted> aborted;
+  bus.subscribe<infra::codecs::CodecAborted>([&](const infra::codecs::CodecAborted& event) { aborted.push_back(event); });
+
+  infra::codecs::CodecOptions options;
+  options.eventSink_ = &bus;
+  options.cancellation_ = &token;
+  token.cancel();
+  infra::codecs::BMP before;
+  EXPECT_FALSE(before.loadImage(path.string(), options));
+  EXPECT_FALSE(before.isValid());
+  ASSERT_EQ(aborted.size(), 1u);
+  EXPECT_EQ(aborted[0].reason_, infra::codecs::CodecAbortReason::Cancelled);
+  EXPECT_EQ(aborted[0].rowsDone_, 0u);
+
+  // 最初の進捗で中断を要求し、途中の区切りで打ち切られることを確認する
+  token.reset();
+  aborted.clear();
+  options.threadCount_ = 2;
+  options.progressInterval_ = std::chrono::milliseconds(0);
+  bus.subscribe<infra::codecs::CodecProgress>([&](const infra::codecs::CodecProgress&) { token.cancel(); });
+  infra::codecs::BMP during;
+  EXPECT_FALSE(during.loadImage(path.string(), options));
+  EXPECT_FALSE(during.isValid());
+  ASSERT_EQ(aborted.size(), 1u);
+  EXPECT_EQ(aborted[0].operation_, infra::codecs::CodecOperation::Load);
+  EXPECT_LT(aborted[0].rowsDone_, 2048u);
+  std::filesystem::remove(path);
+}
+
+TEST(BmpEvents, ExpiredDeadlineAbortsSaveWithoutOutput) {
+  infra::codecs::BMP bmp(8, 8, domain::graphics2d::Pixel(1.f, 0.f, 0.f));
+  auto path = std::filesystem::temp_directory_path() / "kaf_bmp_events_deadline.bmp";
+  std::filesystem::remove(path);
+  infra::application::EventBus bus;
+  std::vector<infra::codecs::CodecAborted> aborted;
+  bus.subscribe<infra::codecs::CodecAborted>([&](const infra::codecs::CodecAborted& event) { aborted.push_back(event); });
+
+  infra::codecs::CodecOptions options;
+  options.eventSink_ = &bus;
+  options.deadline_ = std::chrono::steady_clock::now() - std::chrono::milliseconds(1);
+  EXPECT_FALSE(bmp.saveImage(path.string(), 24, options));
+  EXPECT_FALSE(std::filesystem::exists(path));
+  ASSERT_EQ(aborted.size(), 1u);
+  EXPECT_EQ(aborted[0].operation_, infra::codecs::CodecOperation::Save);
+  EXPECT_EQ(aborted[0].reason_, infra::codecs::CodecAbortReason::DeadlineExceeded);
+
+  options.deadline_ = std::chrono::steady_clock::now() + std::chrono::hours(1);
+  EXPECT_TRUE(bmp.saveImage(path.string(), 24, options));
+  EXPECT_TRUE(std::filesystem::exists(path));
+  std::filesystem::remove(path);
+}
+
+TEST(BmpCorpus, DefaultSpecsCoverPaddingAspectAndSizeLimit) {
+  const auto specs = infra::codecs::defaultCorpusSpecs(1024 * 1024);
+  ASSERT_FALSE(specs.empty());
+  std::set<size_t> paddings;
+  std::set<uint16_t> depths;
+  bool tall = false, wide = false;
+  for (size_t idx = 0; idx < specs.size(); ++idx) {
+    const auto& spec = specs[idx];
+    EXPECT_LE(infra::codecs::corpusFileSize(spec), 1024u * 1024u);
+    if (idx > 0) {
+      EXPECT_LE(infra::codecs::corpusFileSize(specs[idx - 1]), infra::codecs::corpusFileSize(spec));
+    }
+    if (spec.bitsPerPixel_ == 24) {
+      paddings.insert((4 - spec.width_ * 3 % 4) % 4);
+    }
+    depths.insert(spec.bitsPerPixel_);
+    tall = tall || spec.height_ >= spec.width_ * 1000;
+    wide = wide || spec.width_ >= spec.height_ * 1000;
+  }
+  EXPECT_EQ(paddings, (std::set<size_t>{0, 1, 2, 3}));
+  EXPECT_EQ(depths, (std::set<uint16_t>{24, 32}));
+  EXPECT_TRUE(tall);
+  EXPECT_TRUE(wide);
+
+  // 上限を外すと数 GB の画像まで含む
+  const auto all = infra::codecs::defaultCorpusSpecs(UINTMAX_MAX);
+  EXPECT_GT(infra::codecs::corpusFileSize(all.back()), 2ull * 1024 * 1024 * 1024);
+}
+
+TEST(BmpCorpus, GenerationIsDeterministicAndReusesFiles) {
+  const auto root = std::filesystem::temp_directory_path() / "kaf_bmp_corpus";
+  std::filesystem::remove_all(root);
+  std::vector<infra::codecs::CorpusImageSpec> specs = {
+    {"padding", 3, 33, 24, 7}, {"aspect", 1, 300, 32, 11}, {"size", 257, 129, 24, 13},
+  };
+  std::vector<infra::codecs::CorpusEntry> sequential, parallel;
+  ASSERT_TRUE(infra::codecs::generateCorpus((root / "a").string(), specs, sequential, 1));
+  ASSERT_TRUE(infra::codecs::generateCorpus((root / "b").string(), specs, parallel, 2));
+  ASSERT_EQ(sequential.size(), specs.size());
+  for (size_t idx = 0; idx < specs.size(); ++idx) {
+    EXPECT_TRUE(sequential[idx].generated_);
+    EXPECT_EQ(std::filesystem::file_size(sequential[idx].path_), infra::codecs::corpusFileSize(specs[idx]));
+    std::ifstream a(sequential[idx].path_, std::ios::binary), b(parallel[idx].path_, std::ios::binary);
+    const std::string bytesA((std::istreambuf_iterator<char>(a)), std::istreambuf_iterator<char>());
+    const std::string bytesB((std::istreambuf_iterator<char>(b)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(bytesA, bytesB) << sequential[idx].path_;
+
+    infra::codecs::BMP bmp;
+    ASSERT_TRUE(bmp.loadImage(sequential[idx].path_));
+    EXPECT_EQ(bmp.getWidth(), specs[idx].width_);
+    EXPECT_EQ(bmp.getHeight(), specs[idx].height_);
+  }
+
+  std::vector<infra::codecs::CorpusEntry> again;
+  ASSERT_TRUE(infra::codecs::generateCorpus((root / "a").string(), specs, again, 1));
+  for (const auto& entry : again) {
+    EXPECT_FALSE(entry.generated_);
+  }
+  std::filesystem::remove_all(root);
+}
+
+TEST(BmpRoundTrip, MeasuresCorpusAndComparesWithBaseline) {
+  const auto root = std::filesystem::temp_directory_path() / "kaf_bmp_roundtrip";
+  std::filesystem::remove_all(root);
+  std::vector<infra::codecs::CorpusEntry> corpus;
+  ASSERT_TRUE(infra::codecs::generateCorpus((root / "corpus").string(), infra::codecs::defaultCorpusSpecs(64 * 1024), corpus));
+  const auto entries = infra::codecs::scanBitmapDirectory((root / "corpus").string());
+  ASSERT_EQ(entries.size(), corpus.size());
+
+  infra::codecs::RoundTripOptions options;
+  options.repeat_ = 2;
+  options.outputDirectory_ = (root / "out").string();
+  infra::codecs::RoundTripReport report;
+  ASSERT_TRUE(infra::codecs::runRoundTrip<domain::graphics2d::BGRA8>(entries, options, report));
+  EXPECT_EQ(report.imageCount_, corpus.size() * 2);
+  EXPECT_EQ(report.failureCount_, 0u);
+  EXPECT_GT(report.megabytesPerSecond_, 0.0);
+  EXPECT_GT(report.imagesPerSecond_, 0.0);
+  EXPECT_LE(report.p50Milliseconds_, report.p99Milliseconds_);
+  EXPECT_TRUE(std::filesystem::is_empty(root / "out"));
+
+  std::stringstream csv;
+  ASSERT_TRUE(infra::codecs::writeRoundTripReportCsv(report, csv));
+  infra::codecs::RoundTripReport baseline;
+  ASSERT_TRUE(infra::codecs::readRoundTripReportCsv(csv, baseline));
+  EXPECT_EQ(baseline.imageCount_, report.imageCount_);
+  EXPECT_DOUBLE_EQ(baseline.p99Milliseconds_, report.p99Milliseconds_);
+  for (const auto& comparison : infra::codecs::compareRoundTrip(baseline, report)) {
+    EXPECT_FALSE(comparison.regressed_) << comparison.metric_;
+  }
+
+  // 基準値の半分のスループットは 10% の閾値で劣化、60% の閾値では許容
+  infra::codecs::RoundTripReport slower = report;
+  slower.megabytesPerSecond_ /= 2;
+  const auto comparisons = infra::codecs::compareRoundTrip(baseline, slower, 0.10);
+  const auto throughput = std::find_if(comparisons.begin(), comparisons.end(),
+    [](const infra::codecs::RoundTripComparison& c) { return c.metric_ == "mb_per_second"; });
+  ASSERT_NE(throughput, comparisons.end());
+  EXPECT_TRUE(throughput->regressed_);
+  EXPECT_DOUBLE_EQ(throughput->change_, 0.5);
+  for (const auto& comparison : infra::codecs::compareRoundTrip(baseline, slower, 0.60)) {
+    EXPECT_FALSE(comparison.regressed_) << comparison.metric_;
+  }
+  std::filesystem::remove_all(root);
+}
@@ -0,0 +1,106 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <gtest/gtest.h>
+
+#include "../src/domain/graphics2d/include/colorspace.hpp"
+#include "../src/domain/graphics2d/include/image.hpp"
+
+using namespace kaf::domain::graphics2d;
+
+namespace {
+  double referenceDecode(double x) { return x <= 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4); }
+  double referenceEncode(double x) { return x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055; }
+}
+
+TEST(ColorSpace, PolynomialSrgbCurvesMatchReference) {
+  Image image(1001, 1, Pixel(0.f, 0.f, 0.f));
+  for (size_t idx = 0; idx <= 1000; ++idx) {
+    const float x = static_cast<float>(idx) / 1000.f;
+    EXPECT_NEAR(srgbToLinear(x), referenceDecode(x), 2e-6) << x;
+    EXPECT_NEAR(linearToSrgb(x), referenceEncode(x), 2e-6) << x;
+    image.setPixel(idx, 0, Pixel(x, 1.f - x, x * x, 0.25f));
+  }
+  auto linear = toLinear(std::as_const(image));
+  ASSERT_NE(linear, nullptr);
+  for (size_t idx = 0; idx <= 1000; idx += 37) {
+    const Pixel* source = std::as_const(image).getPixel(idx, 0);
+    const Pixel* pixel = std::as_const(*linear).getPixel(idx, 0);
+    EXPECT_NEAR(pixel->r_, referenceDecode(source->r_), 2e-6);
+    EXPECT_NEAR(pixel->g_, referenceDecode(source->g_), 2e-6);
+    EXPECT_NEAR(pixel->b_, referenceDecode(source->b_), 2e-6);
+    EXPECT_EQ(pixel->a_, 0.25f);
+  }
+  auto back = toSrgb<Pixel>(*linear);
+  ASSERT_NE(back, nullptr);
+  EXPECT_NEAR(std::as_const(*back).getPixel(500, 0)->r_, 0.5f, 1e-5f);
+}
+
+TEST(ColorSpace, EightBitRoundTripsThroughLinearTable) {
+  BasicImage<BGRA8> image(256, 1, BGRA8{0, 0, 0, 0});
+  for (size_t idx = 0; idx < 256; ++idx) {
+    const auto value = static_cast<std::uint8_t>(idx);
+    image.setPixel(idx, 0, BGRA8{value, static_cast<std::uint8_t>(255 - value), value, value});
+    EXPECT_NEAR(srgbByteToLinear(value), referenceDecode(idx / 255.0), 1e-6);
+  }
+  auto linear = toLinear(std::as_const(image));
+  ASSERT_NE(linear, nullptr);
+  auto back = toSrgb<BGRA8>(*linear);
+  ASSERT_NE(back, nullptr);
+  for (size_t idx = 0; idx < 256; ++idx) {
+    const BGRA8* expected = std::as_const(image).getPixel(idx, 0);
+    const BGRA8* actual = std::as_const(*back).getPixel(idx, 0);
+    ASSERT_EQ(actual->b_, expected->b_) << idx;
+    ASSERT_EQ(actual->g_, expected->g_) << idx;
+    ASSERT_EQ(actual->a_, expected->a_) << idx;
+  }
+}
+
+TEST(ColorSpace, ConvertsToGrayscaleAndPlanarYCbCr) {
+  BasicImage<RGBA8> image(5, 3, RGBA8{0, 0, 0, 255});
+  for (size_t y = 0; y < 3; ++y) {
+    for (size_t x = 0; x < 5; ++x) {
+      image.setPixel(x, y, RGBA8{static_cast<std::uint8_t>(x * 60), static_cast<std::uint8_t>(y * 100), 77, 255});
+    }
+  }
+  const auto& input = std::as_const(image);
+
+  auto gray = toGrayscale(input);
+  ASSERT_NE(gray, nullptr);
+  EXPECT_EQ(std::as_const(*gray).getPixel(4, 2)->v_, lumaOf(240, 200, 77));
+
+  auto full = toYCbCr(input);
+  ASSERT_NE(full, nullptr);
+  ASSERT_TRUE(full->isValid());
+  EXPECT_EQ(full->cb_.size(), 15u);
+  auto restored = fromYCbCr<RGBA8>(*full);
+  ASSERT_NE(restored, nullptr);
+  for (size_t y = 0; y < 3; ++y) {
+    for (size_t x = 0; x < 5; ++x) {
+      const RGBA8* expected = input.getPixel(x, y);
+      const RGBA8* actual = std::as_const(*restored).getPixel(x, y);
+      EXPECT_LE(std::abs(actual->r_ - expected->r_), 2);
+      EXPECT_LE(std::abs(actual->g_ - expected->g_), 2);
+      EXPECT_LE(std::abs(actual->b_ - expected->b_), 2);
+    }
+  }
+
+  auto half = toYCbCr(input, ChromaSubsampling::YCbCr420);
+  ASSERT_NE(half, nullptr);
+  EXPECT_EQ(half->chromaWidth_, 3u);
+  EXPECT_EQ(half->chromaHeight_, 2u);
+  EXPECT_EQ(half->y_, full->y_);
+  // 2x2 ブロックの色差は 4:4:4 の平均に一致する（丸め誤差 1 以内）
+  const int average = (full->cb_[0] + full->cb_[1] + full->cb_[5] + full->cb_[6] + 2) / 4;
+  EXPECT_LE(std::abs(half->cb_[0] - average), 1);
+
+  BasicImage<BGR8> flat(7, 7, BGR8{30, 140, 220});
+  auto planes = toYCbCr(std::as_const(flat), ChromaSubsampling::YCbCr420);
+  auto decoded = fromYCbCr<BGR8>(*planes);
+  ASSERT_NE(decoded, nullptr);
+  const BGR8* pixel = std::as_const(*decoded).getPixel(6, 6);
+  EXPECT_LE(std::abs(pixel->b_ - 30), 1);
+  EXPECT_LE(std::abs(pixel->g_ - 140), 1);
+  EXPECT_LE(std::abs(pixel->r_ - 220), 1);
+}
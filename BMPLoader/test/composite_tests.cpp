@@ -0,0 +1,71 @@
+#include <utility>
+#include <gtest/gtest.h>
+
+#include "../src/domain/graphics2d/include/composite.hpp"
+#include "../src/domain/graphics2d/include/image.hpp"
+
+using namespace kaf::domain::graphics2d;
+
+TEST(Composite, BlendsWithEachModeInPremultipliedAlpha) {
+  const Image overlay(1, 1, Pixel(0.8f, 0.4f, 0.2f, 0.5f));
+  const Pixel base(0.2f, 0.6f, 1.0f, 1.0f);
+
+  Image over(1, 1, base);
+  ASSERT_TRUE(compositeImage(over, overlay));
+  const Pixel* pixel = std::as_const(over).getPixel(0, 0);
+  EXPECT_NEAR(pixel->r_, 0.5f, 1e-6f);
+  EXPECT_NEAR(pixel->g_, 0.5f, 1e-6f);
+  EXPECT_NEAR(pixel->a_, 1.0f, 1e-6f);
+
+  Image multiply(1, 1, base);
+  ASSERT_TRUE(compositeImage(multiply, overlay, 0, 0, BlendMode::Multiply));
+  EXPECT_NEAR(std::as_const(multiply).getPixel(0, 0)->r_, 0.4f * 0.2f + 0.2f * 0.5f, 1e-6f);
+
+  Image screen(1, 1, base);
+  ASSERT_TRUE(compositeImage(screen, overlay, 0, 0, BlendMode::Screen));
+  EXPECT_NEAR(std::as_const(screen).getPixel(0, 0)->r_, 0.4f + 0.2f - 0.4f * 0.2f, 1e-6f);
+
+  Image add(1, 1, base);
+  ASSERT_TRUE(compositeImage(add, overlay, 0, 0, BlendMode::Add, 0.5f));
+  EXPECT_NEAR(std::as_const(add).getPixel(0, 0)->r_, 0.4f, 1e-6f);
+  EXPECT_NEAR(std::as_const(add).getPixel(0, 0)->b_, 1.0f, 1e-6f);
+
+  // 透明な下地に重ねると、上の画像がそのまま残る
+  Image transparent(1, 1, Pixel(0.f, 0.f, 0.f, 0.f));
+  ASSERT_TRUE(compositeImage(transparent, overlay));
+  EXPECT_NEAR(std::as_const(transparent).getPixel(0, 0)->r_, 0.8f, 1e-6f);
+  EXPECT_NEAR(std::as_const(transparent).getPixel(0, 0)->a_, 0.5f, 1e-6f);
+}
+
+TEST(Composite, ClipsSpriteAtOffsetsOutsideCanvas) {
+  BasicImage<BGR8> canvas(8, 6, BGR8{0, 0, 0});
+  const BasicImage<BGR8> sprite(3, 3, BGR8{255, 255, 255});
+  ASSERT_TRUE(compositeImage(canvas, sprite, -1, 4));
+  ASSERT_TRUE(compositeImage(canvas, sprite, 100, 100));
+
+  size_t painted = 0;
+  for (size_t y = 0; y < 6; ++y) {
+    for (size_t x = 0; x < 8; ++x) {
+      painted += std::as_const(canvas).getPixel(x, y)->g_ == 255;
+    }
+  }
+  EXPECT_EQ(painted, 4u);
+  EXPECT_EQ(std::as_const(canvas).getPixel(1, 5)->r_, 255);
+  EXPECT_EQ(std::as_const(canvas).getPixel(2, 5)->r_, 0);
+}
+
+TEST(Composite, CompositesImageOntoItself) {
+  // 自身を右下へ 1 px ずらして加算する。入力は合成前の内容なので、書き換えた行が次の行へ波及しない
+  Image image(3, 3, Pixel(0.f, 0.f, 0.f));
+  for (size_t y = 0; y < 3; ++y) {
+    for (size_t x = 0; x < 3; ++x) {
+      image.setPixel(x, y, Pixel(0.1f * static_cast<float>(x + y + 1), 0.f, 0.f));
+    }
+  }
+  ASSERT_TRUE(compositeImage(image, image, 1, 1, BlendMode::Add));
+  EXPECT_NEAR(std::as_const(image).getPixel(0, 2)->r_, 0.3f, 1e-6f);
+  EXPECT_NEAR(std::as_const(image).getPixel(1, 1)->r_, 0.3f + 0.1f, 1e-6f);
+  // (1, 1) を書き換えた後の値 0.4 ではなく、合成前の 0.3 を重ねる
+  EXPECT_NEAR(std::as_const(image).getPixel(2, 2)->r_, 0.5f + 0.3f, 1e-6f);
+  EXPECT_FALSE(image.isShared());
+}
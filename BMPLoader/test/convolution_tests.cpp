@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../src/domain/graphics2d/include/convolution.hpp"
+#include "../src/domain/graphics2d/include/image.hpp"
+
+using namespace kaf::domain::graphics2d;
+
+namespace {
+  Image makeRow(const std::vector<float>& values) {
+    Image image(values.size(), 1, Pixel(0.f, 0.f, 0.f));
+    for (size_t x = 0; x < values.size(); ++x) {
+      image.setPixel(x, 0, Pixel(values[x], 0.f, 0.f));
+    }
+    return image;
+  }
+
+  float redAt(const Image& image, size_t x, size_t y) {
+    return image.getPixel(x, y)->r_;
+  }
+}
+
+TEST(Convolution, AppliesEdgeModesAtBorders) {
+  const Image image = makeRow({0.1f, 0.2f, 0.3f, 0.4f});
+  auto clamp = boxBlur(image, 2, EdgeMode::Clamp);
+  auto mirror = boxBlur(image, 2, EdgeMode::Mirror);
+  auto wrap = boxBlur(image, 2, EdgeMode::Wrap);
+  ASSERT_NE(clamp, nullptr);
+  ASSERT_NE(mirror, nullptr);
+  ASSERT_NE(wrap, nullptr);
+  EXPECT_NEAR(redAt(*clamp, 0, 0), (0.1f + 0.1f + 0.1f + 0.2f + 0.3f) / 5.f, 1e-6f);
+  EXPECT_NEAR(redAt(*mirror, 0, 0), (0.2f + 0.1f + 0.1f + 0.2f + 0.3f) / 5.f, 1e-6f);
+  EXPECT_NEAR(redAt(*wrap, 0, 0), (0.3f + 0.4f + 0.1f + 0.2f + 0.3f) / 5.f, 1e-6f);
+  EXPECT_NEAR(redAt(*wrap, 3, 0), (0.2f + 0.3f + 0.4f + 0.1f + 0.2f) / 5.f, 1e-6f);
+}
+
+TEST(Convolution, TiledPassesMatchDirectComputation) {
+  constexpr size_t width = 300;
+  constexpr size_t height = 37;
+  Image image(width, height, Pixel(0.f, 0.f, 0.f));
+  for (size_t y = 0; y < height; ++y) {
+    for (size_t x = 0; x < width; ++x) {
+      image.setPixel(x, y, Pixel(static_cast<float>((x * 7 + y * 13) % 32) / 31.f, static_cast<float>(y) / height, 0.5f));
+    }
+  }
+  const Image& input = image;
+
+  // 分離可能なガウスと、その外積の 2 次元カーネルは同じ結果になる
+  const std::vector<float> weights = gaussianKernel(1.5f);
+  ASSERT_EQ(weights.size(), 11u);
+  ConvolutionKernel kernel{weights.size(), weights.size(), {}};
+  for (float vertical : weights) {
+    for (float horizontal : weights) {
+      kernel.weights_.push_back(vertical * horizontal);
+    }
+  }
+  auto separable = gaussianBlur(input, 1.5f, EdgeMode::Mirror);
+  auto direct = convolveImage(input, kernel, EdgeMode::Mirror);
+  ASSERT_NE(separable, nullptr);
+  ASSERT_NE(direct, nullptr);
+
+  // 移動和のボックスぼかしは素朴な平均と一致する
+  constexpr int radius = 3;
+  auto box = boxBlur(input, radius, EdgeMode::Clamp);
+  ASSERT_NE(box, nullptr);
+  for (size_t y = 0; y < height; y += 6) {
+    for (size_t x = 0; x < width; x += 7) {
+      EXPECT_NEAR(redAt(*separable, x, y), redAt(*direct, x, y), 1e-5f);
+      float sum = 0.f;
+      for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+          const int sx = std::clamp(static_cast<int>(x) + dx, 0, static_cast<int>(width) - 1);
+          const int sy = std::clamp(static_cast<int>(y) + dy, 0, static_cast<int>(height) - 1);
+          sum += redAt(input, static_cast<size_t>(sx), static_cast<size_t>(sy));
+        }
+      }
+      EXPECT_NEAR(redAt(*box, x, y), sum / 49.f, 1e-5f) << x << "," << y;
+    }
+  }
+}
+
+TEST(Convolution, SharpeningKeepsFlatAreasAndBoostsEdges) {
+  BasicImage<BGR8> flat(40, 30, BGR8{40, 90, 200});
+  for (auto& result : {sharpen(flat, 1.f), unsharpMask(flat, 2.f, 1.5f)}) {
+    ASSERT_NE(result, nullptr);
+    const BGR8* pixel = std::as_const(*result).getPixel(20, 15);
+    EXPECT_EQ(pixel->b_, 40);
+    EXPECT_EQ(pixel->g_, 90);
+    EXPECT_EQ(pixel->r_, 200);
+  }
+
+  const Image step = makeRow({0.2f, 0.2f, 0.2f, 0.8f, 0.8f, 0.8f});
+  auto sharpened = unsharpMask(step, 1.f, 1.f);
+  ASSERT_NE(sharpened, nullptr);
+  EXPECT_LT(redAt(*sharpened, 2, 0), 0.2f);
+  EXPECT_GT(redAt(*sharpened, 3, 0), 0.8f);
+  auto thresholded = unsharpMask(step, 1.f, 1.f, 0.5f);
+  EXPECT_FLOAT_EQ(redAt(*thresholded, 2, 0), 0.2f);
+
+  EXPECT_EQ(convolveImage(step, ConvolutionKernel{2, 1, {0.5f, 0.5f}}), nullptr);
+}
+
+TEST(Convolution, BoxBlurBandsMatchDirectAverage) {
+  // 帯を複数に分けるプールで、帯の高さや画像を超える半径も素朴な平均と一致する
+  constexpr size_t width = 23;
+  constexpr size_t height = 41;
+  Image image(width, height, Pixel(0.f, 0.f, 0.f));
+  for (size_t y = 0; y < height; ++y) {
+    for (size_t x = 0; x < width; ++x) {
+      image.setPixel(x, y, Pixel(static_cast<float>((x * 5 + y * 11) % 17) / 16.f, 0.f, 0.f));
+    }
+  }
+  const Image& input = image;
+  kaf::domain::common::ThreadPool pool(3);
+  for (const size_t radius : {0u, 1u, 4u, 30u}) {
+    auto box = boxBlur(input, radius, EdgeMode::Wrap, pool);
+    ASSERT_NE(box, nullptr);
+    const int r = static_cast<int>(radius);
+    const float count = static_cast<float>((2 * r + 1) * (2 * r + 1));
+    for (size_t y = 0; y < height; ++y) {
+      for (size_t x = 0; x < width; x += 5) {
+        float sum = 0.f;
+        for (int dy = -r; dy <= r; ++dy) {
+          for (int dx = -r; dx <= r; ++dx) {
+            const size_t sx = static_cast<size_t>((static_cast<int>(x) + dx) % static_cast<int>(width) + static_cast<int>(width)) % width;
+            const size_t sy = static_cast<size_t>((static_cast<int>(y) + dy) % static_cast<int>(height) + static_cast<int>(height)) % height;
+            sum += redAt(input, sx, sy);
+          }
+        }
+        ASSERT_NEAR(redAt(*box, x, y), sum / count, 1e-5f) << "radius " << radius << " at " << x << "," << y;
+      }
+    }
+  }
+}
@@ -0,0 +1,200 @@
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../src/infra/application/include/event_bus.hpp"
+
+using namespace kaf::infra::application;
+using kaf::domain::common::IEventSink;
+
+namespace {
+  struct Progress {
+    int value_;
+  };
+  struct Finished {};
+}
+
+TEST(EventBus, DispatchesByEventType) {
+  EventBus bus;
+  int progress = 0;
+  int finished = 0;
+  bus.subscribe<Progress>([&](const Progress& event) { progress += event.value_; });
+  bus.subscribe<Progress>(std::function<void(const Progress&)>([&](const Progress& event) { progress += event.value_ * 10; }));
+  bus.subscribe<Finished>([&](const Finished&) { ++finished; });
+
+  IEventSink& sink = bus;
+  sink.publish(Progress{2});
+  sink.publish(Finished{});
+  sink.publish(3.0);  // 購読者のいない型は無視される
+  EXPECT_EQ(progress, 22);
+  EXPECT_EQ(finished, 1);
+}
+
+TEST(EventBus, KeepsLargeHandlersOnHeap) {
+  EventBus bus;
+  std::array<int, 32> weights{};
+  weights[5] = 7;
+  int total = 0;
+  int* target = &total;
+  bus.subscribe<Progress>([weights, target](const Progress& event) { *target += weights[event.value_]; });
+
+  // ハンドラを複製しても呼び出し先は同じ
+  EventHandler handler = EventHandler::create<Progress>([weights, target](const Progress& event) { *target += weights[event.value_]; });
+  EventHandler copy = handler;
+  const Progress event{5};
+  copy(&event);
+  bus.publish(event);
+  EXPECT_EQ(total, 14);
+}
+
+TEST(EventBus, PublishesConcurrentlyWhileSubscribing) {
+  EventBus bus;
+  std::atomic<int> received{0};
+  bus.subscribe<Progress>([&](const Progress&) { received.fetch_add(1, std::memory_order_relaxed); });
+
+  constexpr int THREADS = 4;
+  constexpr int PUBLISHES = 10000;
+  std::vector<std::thread> publishers;
+  for (int idx = 0; idx < THREADS; ++idx) {
+    publishers.emplace_back([&bus] {
+      for (int count = 0; count < PUBLISHES; ++count) {
+        bus.publish(Progress{count});
+      }
+    });
+  }
+  std::atomic<int> late{0};
+  for (int idx = 0; idx < 16; ++idx) {
+    bus.subscribe<Finished>([&](const Finished&) { late.fetch_add(1, std::memory_order_relaxed); });
+  }
+  for (auto& publisher : publishers) {
+    publisher.join();
+  }
+  EXPECT_EQ(received.load(), THREADS * PUBLISHES);
+  bus.publish(Finished{});
+  EXPECT_EQ(late.load(), 16);
+}
+
+namespace {
+  struct Large {
+    std::array<int, 64> values_;
+  };
+}
+
+TEST(EventBus, AsyncDeliversInOrderOnDispatcherThread) {
+  EventBus bus(AsyncDispatchOptions{8, 4, BackpressurePolicy::Block});
+  ASSERT_TRUE(bus.isAsync());
+  std::vector<int> received;
+  std::thread::id dispatcher;
+  int largeSum = 0;
+  bus.subscribe<Progress>([&](const Progress& event) {
+    received.push_back(event.value_);
+    dispatcher = std::this_thread::get_id();
+  });
+  bus.subscribe<Large>([&](const Large& event) { largeSum += event.values_[63]; });
+
+  for (int idx = 0; idx < 1000; ++idx) {
+    bus.publish(Progress{idx});
+  }
+  Large large{};
+  large.values_[63] = 5;
+  bus.publish(large);
+  bus.flush();
+
+  ASSERT_EQ(received.size(), 1000u);
+  for (int idx = 0; idx < 1000; ++idx) {
+    ASSERT_EQ(received[idx], idx);
+  }
+  EXPECT_NE(dispatcher, std::this_thread::get_id());
+  EXPECT_EQ(largeSum, 5);
+  EXPECT_EQ(bus.getDroppedCount(), 0u);
+
+  // drain 後は同期配信
+  bus.drain();
+  EXPECT_FALSE(bus.isAsync());
+  bus.publish(Progress{-1});
+  EXPECT_EQ(received.back(), -1);
+  EXPECT_EQ(dispatcher, std::this_thread::get_id());
+}
+
+TEST(EventBus, AppliesBackpressurePolicyWhenFull) {
+  for (const BackpressurePolicy policy : {BackpressurePolicy::DropNewest, BackpressurePolicy::DropOldest}) {
+    EventBus bus(AsyncDispatchOptions{4, 1, policy});
+    std::mutex gate;
+    std::unique_lock<std::mutex> hold(gate);
+    std::atomic<bool> started{false};
+    std::vector<int> received;
+    bus.subscribe<Progress>([&](const Progress& event) {
+      started = true;
+      std::lock_guard<std::mutex> wait(gate);
+      received.push_back(event.value_);
+    });
+
+    // 配信スレッドが最初のイベントで止まっている間にキュー（4 件）をあふれさせる
+    bus.publish(Progress{0});
+    while (!started) {
+      std::this_thread::yield();
+    }
+    for (int idx = 1; idx <= 10; ++idx) {
+      bus.publish(Progress{idx});
+    }
+    hold.unlock();
+    bus.flush();
+
+    SCOPED_TRACE(toString(policy));
+    EXPECT_EQ(bus.getDroppedCount(), 6u);
+    ASSERT_EQ(received.size(), 5u);
+    EXPECT_EQ(received.front(), 0);
+    EXPECT_EQ(received.back(), policy == BackpressurePolicy::DropNewest ? 4 : 10);
+  }
+}
+
+TEST(EventBus, DrainDeliversEventsPublishedConcurrently) {
+  // 小さいキューと Block で、drain の時点で満杯を待っている publish を作る
+  EventBus bus(AsyncDispatchOptions{4, 2, BackpressurePolicy::Block});
+  std::atomic<int> received{0};
+  bus.subscribe<Progress>([&](const Progress&) { received.fetch_add(1, std::memory_order_relaxed); });
+
+  constexpr int THREADS = 4, EVENTS = 20000;
+  std::atomic<int> ready{0};
+  std::vector<std::thread> publishers;
+  for (int thread = 0; thread < THREADS; ++thread) {
+    publishers.emplace_back([&] {
+      ready.fetch_add(1);
+      for (int idx = 0; idx < EVENTS; ++idx) {
+        bus.publish(Progress{idx});
+      }
+    });
+  }
+  while (ready.load() < THREADS) {
+    std::this_thread::yield();
+  }
+  bus.drain();
+  for (auto& publisher : publishers) {
+    publisher.join();
+  }
+
+  EXPECT_FALSE(bus.isAsync());
+  EXPECT_EQ(received.load(), THREADS * EVENTS);
+  EXPECT_EQ(bus.getDroppedCount(), 0u);
+}
+
+TEST(EventBus, ClampsHugeCapacity) {
+  // 上限を超える容量は MAX_ASYNC_CAPACITY に抑えられ、通常どおり動くバスになる
+  EventBus bus(AsyncDispatchOptions{std::numeric_limits<size_t>::max(), 64, BackpressurePolicy::Block});
+  ASSERT_TRUE(bus.isAsync());
+  std::atomic<int> received{0};
+  bus.subscribe<Progress>([&](const Progress&) { received.fetch_add(1, std::memory_order_relaxed); });
+
+  const int events = static_cast<int>(AsyncDispatchOptions{}.capacity_) * 4;
+  for (int idx = 0; idx < events; ++idx) {
+    bus.publish(Progress{idx});
+  }
+  bus.drain();
+  EXPECT_EQ(received.load(), events);
+  EXPECT_EQ(bus.getDroppedCount(), 0u);
+}
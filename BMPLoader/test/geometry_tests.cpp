@@ -0,0 +1,124 @@
+#include <utility>
+#include <gtest/gtest.h>
+
+#include "../src/domain/graphics2d/include/geometry.hpp"
+#include "../src/domain/graphics2d/include/image.hpp"
+
+using namespace kaf::domain::graphics2d;
+
+namespace {
+  // 転置のブロック（BGRA8 では 64px）をまたぐ、正方でないサイズ
+  constexpr size_t WIDTH = 131;
+  constexpr size_t HEIGHT = 70;
+
+  template <class P>
+  BasicImage<P> coordinateImage() {
+    BasicImage<P> image(WIDTH, HEIGHT);
+    for (size_t y = 0; y < HEIGHT; ++y) {
+      for (size_t x = 0; x < WIDTH; ++x) {
+        P* pixel = image.getPixel(x, y);
+        pixel->b_ = static_cast<std::uint8_t>(x);
+        pixel->g_ = static_cast<std::uint8_t>(y);
+      }
+    }
+    return image;
+  }
+
+  template <class P>
+  void expectSource(const BasicImage<P>& image, size_t x, size_t y, size_t sourceX, size_t sourceY) {
+    const P* pixel = image.getPixel(x, y);
+    ASSERT_EQ(pixel->b_, sourceX) << "at (" << x << ", " << y << ")";
+    ASSERT_EQ(pixel->g_, sourceY) << "at (" << x << ", " << y << ")";
+  }
+
+  template <class P>
+  void expectRotations() {
+    const BasicImage<P> source = coordinateImage<P>();
+
+    const auto transposed = transposeImage(source);
+    const auto rotated90 = rotateImage(source, Rotation::Rotate90);
+    const auto rotated180 = rotateImage(source, Rotation::Rotate180);
+    const auto rotated270 = rotateImage(source, Rotation::Rotate270);
+    ASSERT_TRUE(transposed && rotated90 && rotated180 && rotated270);
+    EXPECT_EQ(rotated90->getWidth(), HEIGHT);
+    EXPECT_EQ(rotated90->getHeight(), WIDTH);
+    EXPECT_EQ(rotated180->getWidth(), WIDTH);
+
+    const BasicImage<P>& t = *transposed;
+    const BasicImage<P>& r90 = *rotated90;
+    const BasicImage<P>& r180 = *rotated180;
+    const BasicImage<P>& r270 = *rotated270;
+    for (size_t y = 0; y < WIDTH; ++y) {
+      for (size_t x = 0; x < HEIGHT; ++x) {
+        expectSource(t, x, y, y, x);
+        expectSource(r90, x, y, y, HEIGHT - 1 - x);
+        expectSource(r270, x, y, WIDTH - 1 - y, x);
+      }
+    }
+    for (size_t y = 0; y < HEIGHT; ++y) {
+      for (size_t x = 0; x < WIDTH; ++x) {
+        expectSource(r180, x, y, WIDTH - 1 - x, HEIGHT - 1 - y);
+      }
+    }
+
+    // 90°と 270°は互いに打ち消す
+    const auto roundTrip = rotateImage(r90, Rotation::Rotate270);
+    ASSERT_TRUE(roundTrip);
+    for (size_t y = 0; y < HEIGHT; ++y) {
+      for (size_t x = 0; x < WIDTH; ++x) {
+        expectSource(std::as_const(*roundTrip), x, y, x, y);
+      }
+    }
+  }
+
+  template <class P>
+  void expectInPlaceMatches() {
+    for (const size_t height : {HEIGHT, HEIGHT + 1}) {
+      BasicImage<P> source(WIDTH, height);
+      for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < WIDTH; ++x) {
+          source.getPixel(x, y)->b_ = static_cast<std::uint8_t>(x + y * 7);
+        }
+      }
+      const auto rotated = rotateImage(std::as_const(source), Rotation::Rotate180);
+      const auto horizontal = flipImage(std::as_const(source), FlipAxis::Horizontal);
+      const auto vertical = flipImage(std::as_const(source), FlipAxis::Vertical);
+      ASSERT_TRUE(rotated && horizontal && vertical);
+
+      BasicImage<P> rotatedInPlace = source;
+      BasicImage<P> horizontalInPlace = source;
+      BasicImage<P> verticalInPlace = source;
+      ASSERT_TRUE(rotate180InPlace(rotatedInPlace));
+      ASSERT_TRUE(flipInPlace(horizontalInPlace, FlipAxis::Horizontal));
+      ASSERT_TRUE(flipInPlace(verticalInPlace, FlipAxis::Vertical));
+      for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < WIDTH; ++x) {
+          ASSERT_EQ(std::as_const(rotatedInPlace).getPixel(x, y)->b_, std::as_const(*rotated).getPixel(x, y)->b_);
+          ASSERT_EQ(std::as_const(horizontalInPlace).getPixel(x, y)->b_, std::as_const(source).getPixel(WIDTH - 1 - x, y)->b_);
+          ASSERT_EQ(std::as_const(*horizontal).getPixel(x, y)->b_, std::as_const(source).getPixel(WIDTH - 1 - x, y)->b_);
+          ASSERT_EQ(std::as_const(verticalInPlace).getPixel(x, y)->b_, std::as_const(*vertical).getPixel(x, y)->b_);
+          ASSERT_EQ(std::as_const(*vertical).getPixel(x, y)->b_, std::as_const(source).getPixel(x, height - 1 - y)->b_);
+        }
+      }
+    }
+  }
+}
+
+TEST(Geometry, RotatesAndTransposesAcrossBlocks) {
+  expectRotations<BGRA8>();
+  expectRotations<BGR8>();
+}
+
+TEST(Geometry, InPlaceRotateAndFlipMatchOutOfPlace) {
+  expectInPlaceMatches<BGRA8>();
+  expectInPlaceMatches<BGR8>();
+}
+
+TEST(Geometry, RejectsMismatchedViews) {
+  BasicImage<BGR8> source(4, 3);
+  BasicImage<BGR8> sameSize(4, 3);
+  EXPECT_FALSE(transposeView(makeView(std::as_const(source)), makeView(sameSize)));
+  EXPECT_FALSE(rotateView(makeView(std::as_const(source)), makeView(sameSize), Rotation::Rotate90));
+  EXPECT_TRUE(rotateView(makeView(std::as_const(source)), makeView(sameSize), Rotation::Rotate180));
+  EXPECT_FALSE(transposeImage(BasicImage<BGR8>()));
+}
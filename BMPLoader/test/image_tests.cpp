@@ -1,10 +1,14 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <utility>
 #include <gtest/gtest.h>
 
 #include "../src/domain/graphics2d/include/image.hpp"
+#include "../src/domain/graphics2d/include/image_view.hpp"
 #include "../src/domain/graphics2d/include/pixel_buffer.hpp"
+#include "../src/domain/graphics2d/include/pixel_buffer_pool.hpp"
 
 using namespace kaf::domain::graphics2d;
 
@@ -33,4 +37,166 @@ TEST(ImageCreate, RejectsOverflow) {
   std::vector<Pixel> dummy(1);
   auto img = createImage(dummy, big, big);
   EXPECT_EQ(img, nullptr);
-}
\ No newline at end of file
+}
+TEST(ImageConvert, RoundTripsBytesThroughFloat) {
+  const size_t w = 3, h = 2;
+  BasicImage<BGR8> src(w, h);
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) {
+      src.setPixel(x, y, BGR8{static_cast<std::uint8_t>(x * 40), static_cast<std::uint8_t>(y * 90), 255});
+    }
+  }
+  auto wide = convertImage<Pixel>(src);
+  ASSERT_NE(wide, nullptr);
+  auto back = convertImage<BGR8>(*wide);
+  ASSERT_NE(back, nullptr);
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) {
+      EXPECT_EQ(back->getPixel(x, y)->b_, src.getPixel(x, y)->b_);
+      EXPECT_EQ(back->getPixel(x, y)->g_, src.getPixel(x, y)->g_);
+      EXPECT_EQ(back->getPixel(x, y)->r_, src.getPixel(x, y)->r_);
+    }
+  }
+}
+
+TEST(PixelBuffer, AlignsStorageAndSkipsFillWhenRequested) {
+  PixelBuffer filled(7, Pixel(0.1f, 0.2f, 0.3f));
+  ASSERT_TRUE(filled.isValid());
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(filled.pixels_.get()) % PIXEL_BUFFER_ALIGNMENT, 0u);
+  EXPECT_FLOAT_EQ(filled.pixels_[6].b_, 0.3f);
+
+  BasicPixelBuffer<BGR8> raw(5, UNINITIALIZED);
+  ASSERT_TRUE(raw.isValid());
+  EXPECT_EQ(raw.size_, 5u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(raw.pixels_.get()) % PIXEL_BUFFER_ALIGNMENT, 0u);
+
+  EXPECT_FALSE(PixelBuffer(0, UNINITIALIZED).isValid());
+}
+
+TEST(PixelBufferPool, ReusesStorageOfTheSameSize) {
+  PixelBufferPool pool;
+  const Pixel* first = nullptr;
+  {
+    PixelBuffer buffer(64, UNINITIALIZED, &pool);
+    first = buffer.pixels_.get();
+  }
+  EXPECT_EQ(pool.getRetainedBytes(), 64 * sizeof(Pixel));
+  {
+    PixelBuffer other(32, UNINITIALIZED, &pool);
+    EXPECT_EQ(pool.getReuseCount(), 0u);
+  }
+  PixelBuffer again(64, UNINITIALIZED, &pool);
+  EXPECT_EQ(again.pixels_.get(), first);
+  EXPECT_EQ(pool.getReuseCount(), 1u);
+  EXPECT_EQ(pool.getRetainedBytes(), 32 * sizeof(Pixel));
+  pool.clear();
+  EXPECT_EQ(pool.getRetainedBytes(), 0u);
+}
+
+TEST(PixelBufferPool, DropsBuffersBeyondRetentionLimit) {
+  PixelBufferPool pool(100);
+  { BasicPixelBuffer<Gray8> small(80, UNINITIALIZED, &pool); }
+  { BasicPixelBuffer<Gray8> large(200, UNINITIALIZED, &pool); }
+  EXPECT_EQ(pool.getRetainedBytes(), 80u);
+}
+
+TEST(ImageCopy, SharesPixelsUntilFirstWrite) {
+  Image original(4, 3, Pixel(0.1f, 0.2f, 0.3f));
+  Image snapshot(original);
+  Image assigned;
+  assigned = original;
+  EXPECT_TRUE(original.isShared());
+  EXPECT_EQ(std::as_const(snapshot).getPixelBuffer(), std::as_const(original).getPixelBuffer());
+
+  ASSERT_TRUE(snapshot.setPixel(1, 2, Pixel(0.9f, 0.8f, 0.7f)));
+  EXPECT_NE(std::as_const(snapshot).getPixelBuffer(), std::as_const(original).getPixelBuffer());
+  EXPECT_FALSE(snapshot.isShared());
+  EXPECT_FLOAT_EQ(std::as_const(original).getPixel(1, 2)->r_, 0.1f);
+  EXPECT_FLOAT_EQ(std::as_const(assigned).getPixel(1, 2)->r_, 0.1f);
+  EXPECT_FLOAT_EQ(std::as_const(snapshot).getPixel(1, 2)->r_, 0.9f);
+  EXPECT_FLOAT_EQ(std::as_const(snapshot).getPixel(0, 0)->b_, 0.3f);
+
+  // 書き込み用の取得でも複製される
+  assigned.getPixel(0, 0)->g_ = 0.5f;
+  EXPECT_FLOAT_EQ(std::as_const(original).getPixel(0, 0)->g_, 0.2f);
+  EXPECT_FALSE(original.isShared());
+}
+
+TEST(ImageCopy, PassPixelBufferCopiesOnlyWhenShared) {
+  Image original(2, 2);
+  const auto* storage = std::as_const(original).getPixelBuffer()->pixels_.get();
+  Image moved(std::move(original));
+  EXPECT_EQ(std::as_const(moved).getPixelBuffer()->pixels_.get(), storage);
+
+  Image snapshot(moved);
+  auto passed = snapshot.passPixelBuffer();
+  ASSERT_NE(passed, nullptr);
+  EXPECT_NE(passed->pixels_.get(), storage);
+  EXPECT_EQ(snapshot.getPixelBuffer(), nullptr);
+  auto unique = moved.passPixelBuffer();
+  EXPECT_EQ(unique->pixels_.get(), storage);
+}
+
+TEST(ImageView, CropsAndTilesWithoutCopying) {
+  BasicImage<Gray8> image(5, 4);
+  for (size_t y = 0; y < 4; ++y) {
+    for (size_t x = 0; x < 5; ++x) {
+      image.setPixel(x, y, Gray8{static_cast<std::uint8_t>(y * 10 + x)});
+    }
+  }
+  auto view = makeView(image);
+  ASSERT_TRUE(view.isValid());
+  EXPECT_TRUE(view.isContiguous());
+  auto crop = view.subView(1, 2, 3, 2);
+  ASSERT_TRUE(crop.isValid());
+  EXPECT_FALSE(crop.isContiguous());
+  EXPECT_EQ(crop.at(0, 0).v_, 21);
+  EXPECT_EQ(crop.row(1)[2].v_, 33);
+  EXPECT_EQ(crop.getPixel(3, 0), nullptr);
+  EXPECT_FALSE(view.subView(4, 0, 2, 1).isValid());
+
+  crop.at(0, 0).v_ = 99;
+  EXPECT_EQ(std::as_const(image).getPixel(1, 2)->v_, 99);
+
+  auto tiles = splitTiles(view, 2, 3);
+  ASSERT_EQ(tiles.size(), 6u);
+  EXPECT_EQ(tiles[2].getWidth(), 1u);
+  EXPECT_EQ(tiles[3].getHeight(), 1u);
+  EXPECT_EQ(tiles[4].at(0, 0).v_, 32);
+
+  BasicImageView<const Gray8> readOnly = crop;
+  auto copied = createImage(readOnly);
+  ASSERT_NE(copied, nullptr);
+  EXPECT_EQ(copied->getWidth(), 3u);
+  EXPECT_EQ(std::as_const(*copied).getPixel(2, 1)->v_, 33);
+}
+
+TEST(ImageRows, IteratesRowsAndPixelsWithoutPerPixelChecks) {
+  Image image(3, 2, Pixel(0.f, 0.f, 0.f));
+  forEachPixel(image, [](Pixel& pixel, size_t x, size_t y) { pixel.r_ = static_cast<float>(y * 3 + x); });
+  float sum = 0.f;
+  for (auto line : rows(std::as_const(image))) {
+    ASSERT_EQ(line.size(), 3u);
+    for (const Pixel& pixel : line) {
+      sum += pixel.r_;
+    }
+  }
+  EXPECT_FLOAT_EQ(sum, 15.f);
+  EXPECT_FLOAT_EQ(std::as_const(image).row(1)[2].r_, 5.f);
+
+  Image snapshot(image);
+  for (Pixel& pixel : makeView(snapshot).row(0)) {
+    pixel.g_ = 1.f;
+  }
+  EXPECT_FLOAT_EQ(std::as_const(image).getPixel(0, 0)->g_, 0.f);
+  size_t visited = 0;
+  forEachPixel(std::as_const(snapshot), [&](const Pixel& pixel) { visited += pixel.g_ == 1.f; });
+  EXPECT_EQ(visited, 3u);
+
+  auto tile = makeView(image).subView(1, 0, 2, 2);
+  size_t count = 0;
+  for (auto line : tile.rows()) {
+    count += line.size();
+  }
+  EXPECT_EQ(count, 4u);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "../src/domain/common/include/log.hpp"
+
+using namespace kaf::domain::common;
+
+namespace {
+  // テスト後に既定のログレベルへ戻す
+  class ScopedLogLevel {
+  public:
+    explicit ScopedLogLevel(LogLevel level) : previous_(getLogLevel()) { setLogLevel(level); }
+    ~ScopedLogLevel() { setLogLevel(previous_); }
+
+  private:
+    LogLevel previous_;
+  };
+}
+
+TEST(Log, EnablesLevelsAtOrAboveThreshold) {
+  ScopedLogLevel scope(LogLevel::Info);
+  EXPECT_EQ(getLogLevel(), LogLevel::Info);
+  EXPECT_FALSE(isLogEnabled(LogLevel::Trace));
+  EXPECT_FALSE(isLogEnabled(LogLevel::Debug));
+  EXPECT_TRUE(isLogEnabled(LogLevel::Info));
+  EXPECT_TRUE(isLogEnabled(LogLevel::Warning));
+  EXPECT_TRUE(isLogEnabled(LogLevel::Error));
+
+  setLogLevel(LogLevel::Trace);
+  EXPECT_TRUE(isLogEnabled(LogLevel::Trace));
+  EXPECT_TRUE(isLogEnabled(LogLevel::Debug));
+
+  // Off はしきい値としてはすべてを無効にし、出力レベルとしては常に無効
+  setLogLevel(LogLevel::Off);
+  EXPECT_FALSE(isLogEnabled(LogLevel::Error));
+  EXPECT_FALSE(isLogEnabled(LogLevel::Off));
+}
+
+TEST(Log, SkipsArgumentsBelowThreshold) {
+  ScopedLogLevel scope(LogLevel::Warning);
+  int evaluated = 0;
+  KAF_LOG_DEBUG("%d", ++evaluated);
+  KAF_LOG_INFO("%d", ++evaluated);
+  // KAF_ENABLE_TRACE の有無によらず、無効なトレースの引数は評価されない
+  KAF_LOG_TRACE("%d", ++evaluated);
+  EXPECT_EQ(evaluated, 0);
+
+  setLogLevel(LogLevel::Off);
+  KAF_LOG_ERROR("%d", ++evaluated);
+  EXPECT_EQ(evaluated, 0);
+}
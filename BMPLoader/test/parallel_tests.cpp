@@ -0,0 +1,85 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../src/domain/common/include/thread_pool.hpp"
+#include "../src/domain/graphics2d/include/image.hpp"
+#include "../src/domain/graphics2d/include/parallel.hpp"
+
+using namespace kaf::domain::common;
+using namespace kaf::domain::graphics2d;
+
+TEST(ThreadPool, VisitsEveryIndexExactlyOnce) {
+  ThreadPool pool(3);
+  std::vector<std::atomic<int>> visits(10007);
+  pool.parallelFor(0, visits.size(), 97, [&](size_t begin, size_t end) {
+    for (size_t idx = begin; idx < end; ++idx) {
+      visits[idx].fetch_add(1);
+    }
+  });
+  for (const auto& count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ThreadPool, HandlesNestedAndConcurrentCallers) {
+  ThreadPool pool(2);
+  std::atomic<size_t> total{0};
+  std::vector<std::thread> callers;
+  for (int caller = 0; caller < 3; ++caller) {
+    callers.emplace_back([&] {
+      pool.parallelFor(0, 8, 1, [&](size_t, size_t) {
+        pool.parallelFor(0, 100, 10, [&](size_t begin, size_t end) { total.fetch_add(end - begin); });
+      });
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(total.load(), 3u * 8u * 100u);
+}
+
+TEST(ThreadPool, RethrowsFirstExceptionToCaller) {
+  ThreadPool pool(2);
+  EXPECT_THROW(pool.parallelFor(0, 64, 1, [](size_t begin, size_t) {
+    if (begin == 13) {
+      throw std::runtime_error("failed");
+    }
+  }), std::runtime_error);
+
+  // 例外の後もプールは使える
+  std::atomic<size_t> total{0};
+  pool.parallelFor(0, 64, 1, [&](size_t begin, size_t end) { total.fetch_add(end - begin); });
+  EXPECT_EQ(total.load(), 64u);
+}
+
+TEST(ParallelImage, ProcessesEveryRowAndTile) {
+  ThreadPool pool(3);
+  constexpr size_t width = 300;
+  constexpr size_t height = 200;
+  BasicImage<Gray8> image(width, height, Gray8{0});
+
+  parallelForRows(image, [](PixelSpan<Gray8> row, size_t y) {
+    for (auto& pixel : row) {
+      pixel.v_ = static_cast<std::uint8_t>(y);
+    }
+  }, pool);
+  for (size_t y = 0; y < height; ++y) {
+    EXPECT_EQ(std::as_const(image).getPixel(width - 1, y)->v_, static_cast<std::uint8_t>(y));
+  }
+
+  std::atomic<size_t> tiles{0};
+  std::atomic<size_t> pixels{0};
+  parallelForTiles(image, [&](const BasicImageView<Gray8>& tile) {
+    tiles.fetch_add(1);
+    forEachPixel(tile, [](Gray8& pixel) { pixel.v_ = static_cast<std::uint8_t>(pixel.v_ + 1); });
+    pixels.fetch_add(tile.getWidth() * tile.getHeight());
+  }, 64, pool);
+  EXPECT_EQ(tiles.load(), 5u * 4u);
+  EXPECT_EQ(pixels.load(), width * height);
+  EXPECT_EQ(std::as_const(image).getPixel(0, 10)->v_, 11);
+}
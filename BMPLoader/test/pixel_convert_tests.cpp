@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "../src/domain/graphics2d/include/pixel_convert.hpp"
+
+using namespace kaf::domain::graphics2d;
+
+namespace {
+  std::vector<SimdLevel> supportedLevels() {
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+      if (isSimdLevelSupported(level)) {
+        levels.push_back(level);
+      }
+    }
+    return levels;
+  }
+
+  std::vector<std::uint8_t> patternBytes(size_t count) {
+    std::vector<std::uint8_t> bytes(count);
+    for (size_t idx = 0; idx < count; ++idx) {
+      bytes[idx] = static_cast<std::uint8_t>(idx * 37 + 11);
+    }
+    return bytes;
+  }
+}
+
+TEST(PixelConvert, ScalarDecodesAndRoundsWithClamp) {
+  const auto& scalar = getPixelConvertKernels(SimdLevel::Scalar);
+  const std::uint8_t bgra[] = {0, 128, 255, 64};
+  Pixel pixel;
+  scalar.bgra8ToPixel_(bgra, &pixel, 1);
+  EXPECT_EQ(pixel.r_, 1.0f);
+  EXPECT_EQ(pixel.g_, 128 / 255.0f);
+  EXPECT_EQ(pixel.b_, 0.0f);
+  EXPECT_EQ(pixel.a_, 64 / 255.0f);
+  scalar.bgrx8ToPixel_(bgra, &pixel, 1);
+  EXPECT_EQ(pixel.a_, 1.0f);
+
+  const Pixel source(-0.5f, 0.5f, std::numeric_limits<float>::quiet_NaN(), 2.0f);
+  std::uint8_t encoded[4] = {};
+  scalar.pixelToBgra8_(&source, encoded, 1);
+  EXPECT_EQ(encoded[0], 0);   // NaN
+  EXPECT_EQ(encoded[1], 128); // 127.5 を四捨五入
+  EXPECT_EQ(encoded[2], 0);
+  EXPECT_EQ(encoded[3], 255);
+}
+
+TEST(PixelConvert, SimdKernelsMatchScalarForEveryLength) {
+  const auto& scalar = getPixelConvertKernels(SimdLevel::Scalar);
+  const auto bytes = patternBytes(4 * 40);
+  for (SimdLevel level : supportedLevels()) {
+    const auto& kernels = getPixelConvertKernels(level);
+    ASSERT_EQ(kernels.level_, level);
+    for (size_t count = 0; count <= 40; ++count) {
+      SCOPED_TRACE(std::string(toString(level)) + " count=" + std::to_string(count));
+      auto decode = [&](auto scalarFn, auto simdFn) {
+        std::vector<Pixel> expected(count + 1, Pixel(9.f, 9.f, 9.f, 9.f)), actual(expected);
+        scalarFn(bytes.data(), expected.data(), count);
+        simdFn(bytes.data(), actual.data(), count);
+        EXPECT_EQ(std::memcmp(expected.data(), actual.data(), sizeof(Pixel) * expected.size()), 0);
+      };
+      decode(scalar.bgr8ToPixel_, kernels.bgr8ToPixel_);
+      decode(scalar.bgrx8ToPixel_, kernels.bgrx8ToPixel_);
+      decode(scalar.bgra8ToPixel_, kernels.bgra8ToPixel_);
+
+      std::vector<Pixel> pixels(count);
+      for (size_t idx = 0; idx < count; ++idx) {
+        const float base = static_cast<float>(idx) / 31.0f - 0.2f;
+        pixels[idx] = Pixel(base, 1.2f - base, base * 0.5f, idx % 5 == 0 ? std::nanf("") : base);
+      }
+      auto encode = [&](auto scalarFn, auto simdFn, size_t stride) {
+        std::vector<std::uint8_t> expected(count * stride + 1, 0xAB), actual(expected);
+        scalarFn(pixels.data(), expected.data(), count);
+        simdFn(pixels.data(), actual.data(), count);
+        EXPECT_EQ(expected, actual);
+      };
+      encode(scalar.pixelToBgr8_, kernels.pixelToBgr8_, 3);
+      encode(scalar.pixelToBgra8_, kernels.pixelToBgra8_, 4);
+    }
+  }
+}
+
+TEST(PixelConvert, RoundTripsEveryByteValue) {
+  std::vector<std::uint8_t> bytes(256 * 4);
+  for (size_t idx = 0; idx < bytes.size(); ++idx) {
+    bytes[idx] = static_cast<std::uint8_t>(idx / 4);
+  }
+  std::vector<Pixel> pixels(256);
+  convertBgra8ToPixel(bytes.data(), pixels.data(), pixels.size());
+  std::vector<std::uint8_t> encoded(bytes.size());
+  convertPixelToBgra8(pixels.data(), encoded.data(), pixels.size());
+  EXPECT_EQ(bytes, encoded);
+}
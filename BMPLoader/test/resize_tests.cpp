@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../src/domain/graphics2d/include/image.hpp"
+#include "../src/domain/graphics2d/include/resize.hpp"
+
+using namespace kaf::domain::graphics2d;
+
+namespace {
+  constexpr ResizeFilter ALL_FILTERS[] = {
+    ResizeFilter::Nearest, ResizeFilter::Bilinear, ResizeFilter::Bicubic, ResizeFilter::Lanczos3};
+}
+
+TEST(Resize, KeepsPixelsWhenSizeIsUnchanged) {
+  BasicImage<RGBA8> image(37, 23, RGBA8{0, 0, 0, 255});
+  for (size_t y = 0; y < 23; ++y) {
+    for (size_t x = 0; x < 37; ++x) {
+      image.setPixel(x, y, RGBA8{static_cast<std::uint8_t>(x * 7), static_cast<std::uint8_t>(y * 11),
+                                 static_cast<std::uint8_t>((x * y) & 0xff), 255});
+    }
+  }
+  for (const ResizeFilter filter : ALL_FILTERS) {
+    auto resized = resizeImage(image, 37, 23, filter);
+    ASSERT_NE(resized, nullptr) << toString(filter);
+    for (size_t y = 0; y < 23; ++y) {
+      for (size_t x = 0; x < 37; ++x) {
+        const RGBA8* expected = std::as_const(image).getPixel(x, y);
+        const RGBA8* actual = std::as_const(*resized).getPixel(x, y);
+        ASSERT_EQ(actual->r_, expected->r_) << toString(filter) << " " << x << "," << y;
+        ASSERT_EQ(actual->g_, expected->g_);
+        ASSERT_EQ(actual->b_, expected->b_);
+      }
+    }
+  }
+}
+
+TEST(Resize, PreservesFlatColorWhenScaling) {
+  Image image(64, 48, Pixel(0.2f, 0.4f, 0.6f));
+  for (const ResizeFilter filter : ALL_FILTERS) {
+    for (const auto& size : {std::pair<size_t, size_t>{17, 9}, std::pair<size_t, size_t>{150, 101}}) {
+      auto resized = resizeImage(image, size.first, size.second, filter);
+      ASSERT_NE(resized, nullptr);
+      ASSERT_EQ(resized->getWidth(), size.first);
+      ASSERT_EQ(resized->getHeight(), size.second);
+      const Pixel* pixel = std::as_const(*resized).getPixel(size.first / 2, size.second - 1);
+      EXPECT_NEAR(pixel->r_, 0.2f, 1e-5f) << toString(filter);
+      EXPECT_NEAR(pixel->b_, 0.6f, 1e-5f) << toString(filter);
+    }
+  }
+}
+
+TEST(Resize, MatchesReferenceBilinearAndNearestSamples) {
+  Image image(2, 1, Pixel(0.f, 0.f, 0.f));
+  image.setPixel(1, 0, Pixel(1.f, 1.f, 1.f));
+
+  auto bilinear = resizeImage(std::as_const(image), 4, 1, ResizeFilter::Bilinear);
+  ASSERT_NE(bilinear, nullptr);
+  const float expected[] = {0.f, 0.25f, 0.75f, 1.f};
+  for (size_t x = 0; x < 4; ++x) {
+    EXPECT_NEAR(std::as_const(*bilinear).getPixel(x, 0)->r_, expected[x], 1e-6f);
+  }
+
+  auto nearest = resizeImage(std::as_const(image), 5, 2, ResizeFilter::Nearest);
+  ASSERT_NE(nearest, nullptr);
+  EXPECT_EQ(std::as_const(*nearest).getPixel(1, 1)->r_, 0.f);
+  EXPECT_EQ(std::as_const(*nearest).getPixel(3, 1)->r_, 1.f);
+
+  EXPECT_EQ(resizeImage(std::as_const(image), 0, 3), nullptr);
+}
+
+namespace {
+  // values を 1 行（horizontal）または 1 列に並べた画像
+  Image makeLine(const std::vector<float>& values, bool horizontal) {
+    Image image(horizontal ? values.size() : 1, horizontal ? 1 : values.size(), Pixel(0.f, 0.f, 0.f));
+    for (size_t idx = 0; idx < values.size(); ++idx) {
+      image.setPixel(horizontal ? idx : 0, horizontal ? 0 : idx, Pixel(values[idx], values[idx], values[idx]));
+    }
+    return image;
+  }
+
+  void expectLine(const std::vector<float>& source, ResizeFilter filter, const std::vector<float>& expected) {
+    for (const bool horizontal : {true, false}) {
+      const Image image = makeLine(source, horizontal);
+      auto resized = resizeImage(image, horizontal ? expected.size() : 1, horizontal ? 1 : expected.size(), filter);
+      ASSERT_NE(resized, nullptr);
+      for (size_t idx = 0; idx < expected.size(); ++idx) {
+        const Pixel* pixel = std::as_const(*resized).getPixel(horizontal ? idx : 0, horizontal ? 0 : idx);
+        EXPECT_NEAR(pixel->r_, expected[idx], 1e-5f)
+          << toString(filter) << (horizontal ? " horizontal " : " vertical ") << idx;
+      }
+    }
+  }
+}
+
+TEST(Resize, MatchesReferenceDownscaleSamples) {
+  // 4 -> 2: 縮小率 2 でフィルタを 2 倍に広げる。出力 0 の中心は入力座標 1.0（画素中心 0.5, 1.5, 2.5, 3.5）
+  const std::vector<float> ramp = {0.f, 0.2f, 0.6f, 1.f};
+  expectLine(ramp, ResizeFilter::Nearest, {0.2f, 1.f});
+  // 三角（半径 2）: 入力 0,1,2 の重み 0.75, 0.75, 0.25 を 1.75 で正規化 → (3 * 0 + 3 * 0.2 + 1 * 0.6) / 7、出力 1 は (1 * 0.2 + 3 * 0.6 + 3 * 1) / 7
+  expectLine(ramp, ResizeFilter::Bilinear, {1.2f / 7.f, 5.f / 7.f});
+  // キュービック（半径 4）: 距離 0.25, 0.25, 0.75, 1.25 の重み 0.8671875, 0.8671875, 0.2265625, -0.0703125 を 1.890625 で正規化
+  expectLine(ramp, ResizeFilter::Bicubic, {0.2390625f / 1.890625f, 1.4328125f / 1.890625f});
+  // Lanczos3（半径 6）: 入力 0〜3 の重み sinc(d)sinc(d/3), d = 0.25, 0.25, 0.75, 1.25 を正規化
+  expectLine(ramp, ResizeFilter::Lanczos3, {0.1080894f, 0.7708900f});
+}
+
+TEST(Resize, MatchesReferenceStepEdgeUpscale) {
+  // 2 -> 4: 出力 0 の中心は入力座標 0.25。端の外側のタップは捨てて残りで正規化する
+  const std::vector<float> step = {0.25f, 0.75f};
+  // キュービック: 出力 0 は距離 0.25, 1.25 の重み 0.8671875, -0.0703125（合計 0.796875）、
+  // 出力 1 は距離 0.25, 0.75 の重み 0.8671875, 0.2265625（合計 1.09375）。負のローブで段差の手前が下がる
+  expectLine(step, ResizeFilter::Bicubic, {
+    0.25f + 0.5f * (-0.0703125f / 0.796875f), 0.25f + 0.5f * (0.2265625f / 1.09375f),
+    0.75f - 0.5f * (0.2265625f / 1.09375f), 0.75f + 0.5f * (0.0703125f / 0.796875f)});
+  // Lanczos3: 出力 0 は重み sinc(0.25)sinc(1/12) = 0.8900670, sinc(1.25)sinc(5/12) = -0.1328731
+  expectLine(step, ResizeFilter::Lanczos3, {0.1622612f, 0.3664353f, 0.6335647f, 0.8377388f});
+}
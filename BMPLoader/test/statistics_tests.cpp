@@ -0,0 +1,82 @@
+#include <utility>
+#include <gtest/gtest.h>
+
+#include "../src/domain/graphics2d/include/image.hpp"
+#include "../src/domain/graphics2d/include/statistics.hpp"
+
+using namespace kaf::domain::graphics2d;
+
+TEST(Statistics, ComputesHistogramAndMoments) {
+  // 左半分が 0、右半分が 255 の赤チャンネル
+  BasicImage<BGRA8> image(300, 200, BGRA8{10, 20, 0, 255});
+  for (size_t y = 0; y < 200; ++y) {
+    for (size_t x = 150; x < 300; ++x) {
+      image.getPixel(x, y)->r_ = 255;
+    }
+  }
+  const auto statistics = computeStatistics(std::as_const(image));
+  ASSERT_TRUE(statistics);
+  EXPECT_EQ(statistics->sampleCount_, 300u * 200u);
+
+  const ChannelStatistics& red = statistics->channel(StatisticsChannel::Red);
+  EXPECT_EQ(red.histogram_[0], 30000u);
+  EXPECT_EQ(red.histogram_[255], 30000u);
+  EXPECT_FLOAT_EQ(red.min_, 0.0f);
+  EXPECT_FLOAT_EQ(red.max_, 1.0f);
+  EXPECT_NEAR(red.mean_, 0.5f, 1e-6f);
+  EXPECT_NEAR(red.stddev_, 0.5f, 1e-6f);
+  EXPECT_FLOAT_EQ(red.percentile(0.25), 0.0f);
+  EXPECT_FLOAT_EQ(red.percentile(0.75), 1.0f);
+
+  const ChannelStatistics& blue = statistics->channel(StatisticsChannel::Blue);
+  EXPECT_NEAR(blue.mean_, 10.0f / 255.0f, 1e-6f);
+  EXPECT_FLOAT_EQ(blue.stddev_, 0.0f);
+  EXPECT_FLOAT_EQ(statistics->channel(StatisticsChannel::Alpha).min_, 1.0f);
+
+  // 4px おきの標本では、75 列のうち 37 列が右半分
+  const auto sampled = computeStatistics(std::as_const(image), 4);
+  ASSERT_TRUE(sampled);
+  EXPECT_EQ(sampled->sampleCount_, 75u * 50u);
+  EXPECT_NEAR(sampled->channel(StatisticsChannel::Red).mean_, 37.0f / 75.0f, 1e-6f);
+
+  EXPECT_FALSE(computeStatistics(std::as_const(image), 0));
+}
+
+TEST(Statistics, FloatPixelsUseExactMoments) {
+  Image image(2, 1, Pixel(0.1f, 0.2f, 0.3f));
+  image.getPixel(1, 0)->r_ = 0.3f;
+  const auto statistics = computeStatistics(std::as_const(image));
+  ASSERT_TRUE(statistics);
+  const ChannelStatistics& red = statistics->channel(StatisticsChannel::Red);
+  EXPECT_NEAR(red.min_, 0.1f, 1e-6f);
+  EXPECT_NEAR(red.max_, 0.3f, 1e-6f);
+  EXPECT_NEAR(red.mean_, 0.2f, 1e-6f);
+  EXPECT_NEAR(red.stddev_, 0.1f, 1e-6f);
+}
+
+TEST(Statistics, AutoLevelsStretchesEachChannel) {
+  BasicImage<BGR8> image(64, 64);
+  for (size_t y = 0; y < 64; ++y) {
+    for (size_t x = 0; x < 64; ++x) {
+      // R は 50〜113、G は 100〜163、B は一定
+      *image.getPixel(x, y) = BGR8{static_cast<std::uint8_t>(80), static_cast<std::uint8_t>(100 + x), static_cast<std::uint8_t>(50 + x)};
+    }
+  }
+
+  BasicImage<BGR8> levels = image;
+  ASSERT_TRUE(autoLevels(levels, 0.0f));
+  EXPECT_EQ(std::as_const(levels).getPixel(0, 0)->r_, 0);
+  EXPECT_EQ(std::as_const(levels).getPixel(63, 0)->r_, 255);
+  EXPECT_EQ(std::as_const(levels).getPixel(0, 0)->g_, 0);
+  EXPECT_EQ(std::as_const(levels).getPixel(63, 0)->g_, 255);
+  EXPECT_EQ(std::as_const(levels).getPixel(10, 0)->b_, 80);
+
+  // 自動コントラストは R, G, B 共通の範囲（50〜163）で伸長する
+  BasicImage<BGR8> contrast = image;
+  ASSERT_TRUE(autoContrast(contrast, 0.0f));
+  EXPECT_EQ(std::as_const(contrast).getPixel(0, 0)->r_, 0);
+  EXPECT_EQ(std::as_const(contrast).getPixel(63, 0)->g_, 255);
+  EXPECT_EQ(std::as_const(contrast).getPixel(0, 0)->b_, unitToByte(30.0f / 113.0f));
+
+  EXPECT_FALSE(autoLevels(levels, 0.5f));
+}